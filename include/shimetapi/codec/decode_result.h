@@ -0,0 +1,20 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+#ifndef SHIMETA_CODEC_DECODE_RESULT_H
+#define SHIMETA_CODEC_DECODE_RESULT_H
+#include <cstddef>
+#include <shimetapi/core/status.h>
+namespace Shimeta::codec {
+
+/// 定长输出解码（Decode(buf, len, EventCD* out, size_t capacity)）的结果。
+/// status == Status::ErrBufferFull 表示 out 已写不下下一个产出事件的输入单元：
+/// 前 consumed 字节已解码、解码器状态已推进，换一块（或腾空后的）输出区以
+/// buf + consumed 续调即可，结果与一次性解码完全一致。
+struct DecodeResult {
+    Status status   = Status::Ok;
+    size_t events   = 0;   ///< 写入 out 的事件数
+    size_t consumed = 0;   ///< 已处理的输入字节数
+    bool needsMoreSpace() const { return status == Status::ErrBufferFull; }
+};
+
+} // namespace Shimeta::codec
+#endif // SHIMETA_CODEC_DECODE_RESULT_H
@@ -0,0 +1,99 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// codec 批量内核的输出端：内核只调用 sink.put(x, y, t, p)，由 sink 决定落地布局。
+#ifndef SHIMETA_CODEC_DETAIL_EVENT_SINK_H
+#define SHIMETA_CODEC_DETAIL_EVENT_SINK_H
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <shimetapi/core/event_batch.h>
+#include <shimetapi/core/event_cd.h>
+#include <shimetapi/codec/detail/simd.h>
+namespace Shimeta::codec::detail {
+
+static_assert(sizeof(EventCD) == 24 && offsetof(EventCD, t) == 8 && offsetof(EventCD, polarity) == 16,
+              "EventCD layout changed; update EventCDSink::put4");
+
+/// AoS 输出：顺序写入调用方预留好空间的 EventCD 数组。
+struct EventCDSink {
+    EventCD* cur;
+    void put(uint16_t x, uint16_t y, int64_t t, bool p) {
+        *cur++ = EventCD{x, y, t, p};
+    }
+#if defined(SHIMETA_SIMD_AVX2)
+    /// 4 个事件整块写出：xy/t/p 各为 4×64-bit 通道，转置成 3 个 256-bit 存储（EventCD 为 24 字节）。
+    SHIMETA_TARGET_AVX2 void put4(__m256i xy, __m256i t, __m256i p) {
+        const __m256i a = _mm256_blend_epi32(
+            _mm256_blend_epi32(_mm256_permute4x64_epi64(xy, _MM_SHUFFLE(1, 0, 0, 0)),
+                               _mm256_permute4x64_epi64(t, _MM_SHUFFLE(0, 0, 0, 0)), 0x0C),
+            _mm256_permute4x64_epi64(p, _MM_SHUFFLE(0, 0, 0, 0)), 0x30);
+        const __m256i b = _mm256_blend_epi32(
+            _mm256_blend_epi32(_mm256_permute4x64_epi64(t, _MM_SHUFFLE(2, 0, 0, 1)),
+                               _mm256_permute4x64_epi64(p, _MM_SHUFFLE(0, 0, 1, 0)), 0x0C),
+            _mm256_permute4x64_epi64(xy, _MM_SHUFFLE(0, 2, 0, 0)), 0x30);
+        const __m256i c = _mm256_blend_epi32(
+            _mm256_blend_epi32(_mm256_permute4x64_epi64(p, _MM_SHUFFLE(3, 0, 0, 2)),
+                               _mm256_permute4x64_epi64(xy, _MM_SHUFFLE(0, 0, 3, 0)), 0x0C),
+            _mm256_permute4x64_epi64(t, _MM_SHUFFLE(0, 3, 0, 0)), 0x30);
+        __m256i* d = reinterpret_cast<__m256i*>(cur);
+        _mm256_storeu_si256(d, a);
+        _mm256_storeu_si256(d + 1, b);
+        _mm256_storeu_si256(d + 2, c);
+        cur += 4;
+    }
+#endif
+};
+
+/// AoS 追加输出：push_back 进 vector（产出量无廉价上界、又需复用 out 容量时使用）。
+struct EventCDAppendSink {
+    std::vector<EventCD>* out;
+    void put(uint16_t x, uint16_t y, int64_t t, bool p) {
+        out->push_back(EventCD{x, y, t, p});
+    }
+};
+
+/// SoA 输出：写入 EventBatch 已预留的容量，结束后由调用方 commit 回 batch。
+struct EventBatchSink {
+    uint16_t* x;
+    uint16_t* y;
+    int64_t*  t;
+    uint8_t*  p;
+    size_t    n;   ///< 已写入总数（含 batch 原有事件）
+
+    /// 从 batch 当前末尾开始写；调用前 batch 须已 reserve 足够容量。
+    static EventBatchSink at(EventBatch& b) {
+        return EventBatchSink{b.x(), b.y(), b.t(), b.polarity(), b.size()};
+    }
+    void commit(EventBatch& b) const { b.set_size(n); }
+
+    void put(uint16_t ex, uint16_t ey, int64_t et, bool ep) {
+        x[n] = ex;
+        y[n] = ey;
+        t[n] = et;
+        p[n] = ep ? 1 : 0;
+        ++n;
+    }
+#if defined(SHIMETA_SIMD_AVX2)
+    /// 8 个事件整块写出：x / y / polarity 为 8×32-bit 通道（值域已在 16 / 1 bit 内），
+    /// t = base + tl（tl 为 8×32-bit）。
+    SHIMETA_TARGET_AVX2 void put8(__m256i vx, __m256i vy, __m256i tl, uint64_t base, __m256i vp) {
+        const __m256i xy = _mm256_permute4x64_epi64(_mm256_packus_epi32(vx, vy), _MM_SHUFFLE(3, 1, 2, 0));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(x + n), _mm256_castsi256_si128(xy));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(y + n), _mm256_extracti128_si256(xy, 1));
+        const __m256i b64 = _mm256_set1_epi64x(int64_t(base));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(t + n),
+                            _mm256_add_epi64(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(tl)), b64));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(t + n + 4),
+                            _mm256_add_epi64(_mm256_cvtepu32_epi64(_mm256_extracti128_si256(tl, 1)), b64));
+        const __m256i p8 = _mm256_packus_epi16(_mm256_packus_epi32(vp, vp), _mm256_packus_epi32(vp, vp));
+        const uint32_t lo = uint32_t(_mm256_extract_epi32(p8, 0));
+        const uint32_t hi = uint32_t(_mm256_extract_epi32(p8, 4));
+        std::memcpy(p + n, &lo, 4);
+        std::memcpy(p + n + 4, &hi, 4);
+        n += 8;
+    }
+#endif
+};
+
+} // namespace Shimeta::codec::detail
+#endif // SHIMETA_CODEC_DETAIL_EVENT_SINK_H
@@ -0,0 +1,185 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// EVT2 批量解码内核：8 字一块分类 CD_ON / CD_OFF / TIME_HIGH，整块为 CD 时一遍散写
+// x/y/t/p；块内含 TIME_HIGH 时整块按标量逐字处理（time-base 必须按字序推进）。
+// 语义与 Evt2Decoder::Decode / processEvent 逐字等价（含 2^34 回绕判定）。
+#ifndef SHIMETA_CODEC_DETAIL_EVT2_BATCH_H
+#define SHIMETA_CODEC_DETAIL_EVT2_BATCH_H
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <shimetapi/codec/detail/event_sink.h>
+#include <shimetapi/codec/detail/simd.h>
+namespace Shimeta::codec::detail {
+
+constexpr uint32_t kEvt2TypeCdOff    = 0x0;
+constexpr uint32_t kEvt2TypeCdOn     = 0x1;
+constexpr uint32_t kEvt2TypeTimeHigh = 0x8;
+constexpr uint64_t kEvt2LoopStep     = 1ull << 34;           ///< TIME_HIGH 28 bit + 6 bit 低位
+constexpr uint64_t kEvt2LoopSlack    = 0x3FFFFFD3Full;       ///< 回退超过此值判为翻转
+constexpr size_t   kEvt2Block        = 8;
+
+/// TIME_HIGH：更新 time-base，回退足够大时计一次 2^34 翻转。
+inline void evt2TimeHigh(uint32_t w, uint64_t& base, unsigned& loops) {
+    uint64_t th = (uint64_t(w & 0x0FFFFFFFu) << 6) + (uint64_t(loops) << 34);
+    if (th < base && base - th > kEvt2LoopSlack) {
+        ++loops;
+        th += kEvt2LoopStep;
+    }
+    base = th;
+}
+
+template <class Sink>
+inline void evt2Word(uint32_t w, uint64_t& base, unsigned& loops, Sink& sink) {
+    const uint32_t type = w >> 28;
+    if (type == kEvt2TypeCdOff || type == kEvt2TypeCdOn)
+        sink.put(uint16_t((w >> 11) & 0x7FF), uint16_t(w & 0x7FF),
+                 int64_t(base + ((w >> 22) & 0x3F)), type == kEvt2TypeCdOn);
+    else if (type == kEvt2TypeTimeHigh)
+        evt2TimeHigh(w, base, loops);
+}
+
+/// 首包前导：丢弃首个 TIME_HIGH 之前的字并以其建立 time-base。返回该字下标（未找到返回 n）。
+inline size_t evt2SeekTimeBase(const uint8_t* p, size_t n, uint64_t& base, bool& base_set) {
+    for (size_t i = 0; i < n; ++i) {
+        const uint32_t w = loadLe32(p + 4 * i);
+        if ((w >> 28) == kEvt2TypeTimeHigh) {
+            base = uint64_t(w & 0x0FFFFFFFu) << 6;
+            base_set = true;
+            return i;
+        }
+    }
+    return n;
+}
+
+/// 从 p 起连续不产出事件（非 CD）的字数；定长输出写满后仍可安全推进这些字。
+inline size_t evt2NonCdRun(const uint8_t* p, size_t n) {
+    size_t i = 0;
+    while (i < n && (loadLe32(p + 4 * i) >> 28) > kEvt2TypeCdOn) ++i;
+    return i;
+}
+
+/// 一块 8 字中 mask 所标记的 CD 字落地（xy = x | y<<16，tl = 低 6 bit 时间，ty = 类型）。
+template <class Sink>
+inline void evt2EmitBlock(const uint32_t* xy, const uint32_t* tl, const uint32_t* ty,
+                          uint32_t mask, uint64_t base, Sink& sink) {
+    if (mask == 0xFFu) {
+        for (size_t k = 0; k < kEvt2Block; ++k)
+            sink.put(uint16_t(xy[k]), uint16_t(xy[k] >> 16), int64_t(base + tl[k]), ty[k] != 0);
+        return;
+    }
+    while (mask) {
+        const int k = ctz32(mask);
+        mask &= mask - 1;
+        sink.put(uint16_t(xy[k]), uint16_t(xy[k] >> 16), int64_t(base + tl[k]), ty[k] != 0);
+    }
+}
+
+template <class Sink>
+inline void evt2Scalar(const uint8_t* p, size_t n, uint64_t& base, unsigned& loops, Sink& sink) {
+    for (size_t i = 0; i < n; ++i) evt2Word(loadLe32(p + 4 * i), base, loops, sink);
+}
+
+#if defined(SHIMETA_SIMD_AVX2)
+template <class Sink>
+SHIMETA_TARGET_AVX2 inline size_t evt2Avx2(const uint8_t* p, size_t n, uint64_t& base,
+                                           unsigned& loops, Sink& sink) {
+    const __m256i m11 = _mm256_set1_epi32(0x7FF);
+    const __m256i m6  = _mm256_set1_epi32(0x3F);
+    const __m256i two = _mm256_set1_epi32(2);
+    const __m256i th  = _mm256_set1_epi32(int(kEvt2TypeTimeHigh));
+    alignas(32) uint32_t xy[kEvt2Block], tl[kEvt2Block], ty[kEvt2Block];
+    size_t i = 0;
+    for (; i + kEvt2Block <= n; i += kEvt2Block) {
+        const uint8_t* blk = p + 4 * i;
+        const __m256i v    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blk));
+        const __m256i type = _mm256_srli_epi32(v, 28);
+        if (_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(type, th)))) {
+            evt2Scalar(blk, kEvt2Block, base, loops, sink);
+            continue;
+        }
+        const uint32_t cd = uint32_t(_mm256_movemask_ps(
+            _mm256_castsi256_ps(_mm256_cmpgt_epi32(two, type))));
+        if (!cd) continue;
+        const __m256i x  = _mm256_and_si256(_mm256_srli_epi32(v, 11), m11);
+        const __m256i y  = _mm256_and_si256(v, m11);
+        const __m256i xy8 = _mm256_or_si256(x, _mm256_slli_epi32(y, 16));
+        const __m256i tl8 = _mm256_and_si256(_mm256_srli_epi32(v, 22), m6);
+        if constexpr (std::is_same_v<Sink, EventBatchSink>) {
+            if (cd == 0xFFu) {
+                sink.put8(x, y, tl8, base, type);
+                continue;
+            }
+        }
+        if constexpr (std::is_same_v<Sink, EventCDSink>) {
+            if (cd == 0xFFu) {
+                const __m256i b64 = _mm256_set1_epi64x(int64_t(base));
+                for (int h = 0; h < 2; ++h) {
+                    const __m128i xh = h ? _mm256_extracti128_si256(xy8, 1) : _mm256_castsi256_si128(xy8);
+                    const __m128i lh = h ? _mm256_extracti128_si256(tl8, 1) : _mm256_castsi256_si128(tl8);
+                    const __m128i ph = h ? _mm256_extracti128_si256(type, 1) : _mm256_castsi256_si128(type);
+                    sink.put4(_mm256_cvtepu32_epi64(xh),
+                              _mm256_add_epi64(_mm256_cvtepu32_epi64(lh), b64),
+                              _mm256_cvtepu32_epi64(ph));
+                }
+                continue;
+            }
+        }
+        _mm256_store_si256(reinterpret_cast<__m256i*>(xy), xy8);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(tl), tl8);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(ty), type);
+        evt2EmitBlock(xy, tl, ty, cd, base, sink);
+    }
+    return i;
+}
+#endif
+
+#if defined(SHIMETA_SIMD_NEON)
+template <class Sink>
+inline size_t evt2Neon(const uint8_t* p, size_t n, uint64_t& base, unsigned& loops, Sink& sink) {
+    static const uint32_t kLaneBits[4] = {1u, 2u, 4u, 8u};
+    const uint32x4_t bits = vld1q_u32(kLaneBits);
+    const uint32x4_t m11  = vdupq_n_u32(0x7FF);
+    const uint32x4_t m6   = vdupq_n_u32(0x3F);
+    const uint32x4_t two  = vdupq_n_u32(2);
+    const uint32x4_t th   = vdupq_n_u32(kEvt2TypeTimeHigh);
+    alignas(16) uint32_t xy[kEvt2Block], tl[kEvt2Block], ty[kEvt2Block];
+    size_t i = 0;
+    for (; i + kEvt2Block <= n; i += kEvt2Block) {
+        const uint8_t* blk = p + 4 * i;
+        const uint32x4_t v0 = vreinterpretq_u32_u8(vld1q_u8(blk));
+        const uint32x4_t v1 = vreinterpretq_u32_u8(vld1q_u8(blk + 16));
+        const uint32x4_t t0 = vshrq_n_u32(v0, 28);
+        const uint32x4_t t1 = vshrq_n_u32(v1, 28);
+        if (vmaxvq_u32(vorrq_u32(vceqq_u32(t0, th), vceqq_u32(t1, th)))) {
+            evt2Scalar(blk, kEvt2Block, base, loops, sink);
+            continue;
+        }
+        const uint32_t cd = vaddvq_u32(vandq_u32(vcltq_u32(t0, two), bits)) |
+                            (vaddvq_u32(vandq_u32(vcltq_u32(t1, two), bits)) << 4);
+        if (!cd) continue;
+        vst1q_u32(xy,     vorrq_u32(vandq_u32(vshrq_n_u32(v0, 11), m11), vshlq_n_u32(vandq_u32(v0, m11), 16)));
+        vst1q_u32(xy + 4, vorrq_u32(vandq_u32(vshrq_n_u32(v1, 11), m11), vshlq_n_u32(vandq_u32(v1, m11), 16)));
+        vst1q_u32(tl,     vandq_u32(vshrq_n_u32(v0, 22), m6));
+        vst1q_u32(tl + 4, vandq_u32(vshrq_n_u32(v1, 22), m6));
+        vst1q_u32(ty,     t0);
+        vst1q_u32(ty + 4, t1);
+        evt2EmitBlock(xy, tl, ty, cd, base, sink);
+    }
+    return i;
+}
+#endif
+
+/// 解码 n 个 32-bit 字（time-base 须已建立）。按平台选 AVX2 / NEON / 标量。
+template <class Sink>
+inline void evt2Decode(const uint8_t* p, size_t n, uint64_t& base, unsigned& loops, Sink& sink) {
+    size_t done = 0;
+#if defined(SHIMETA_SIMD_AVX2)
+    if (hasAvx2()) done = evt2Avx2(p, n, base, loops, sink);
+#elif defined(SHIMETA_SIMD_NEON)
+    done = evt2Neon(p, n, base, loops, sink);
+#endif
+    evt2Scalar(p + 4 * done, n - done, base, loops, sink);
+}
+
+} // namespace Shimeta::codec::detail
+#endif // SHIMETA_CODEC_DETAIL_EVT2_BATCH_H
@@ -0,0 +1,186 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// EVT3 批量解码内核：状态字（AddrY / VectBaseX / TimeLow / TimeHigh / ExtTrigger）逐字标量处理，
+// Vect12 / Vect8 按固定 12 / 8 个事件整块展开（x = base_x + i，polarity = mask 第 i 位，
+// 与 Evt3Decoder::handleWord 一致：不跳过 0 位、不推进 base_x）。
+// 输出预留量由一次 SIMD 类型计数给出上界，避免逐事件 push_back。
+#ifndef SHIMETA_CODEC_DETAIL_EVT3_BATCH_H
+#define SHIMETA_CODEC_DETAIL_EVT3_BATCH_H
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <shimetapi/codec/detail/event_sink.h>
+#include <shimetapi/codec/detail/simd.h>
+namespace Shimeta::codec::detail {
+
+/// 与 Evt3Decoder 私有成员一一对应的解码状态（DecodeBatch 进出时拷贝）。
+struct Evt3State {
+    uint16_t cur_y = 0;
+    uint16_t base_x = 0;
+    bool     base_x_set = false;
+    bool     y_set = false;
+    uint32_t ts24 = 0;
+    uint16_t last_time_high = 0;
+    bool     time_high_set = false;
+    uint64_t overflow = 0;
+    int64_t fullTs() const { return int64_t((overflow << 24) | ts24); }
+};
+
+constexpr uint32_t kEvt3MaxTimeHighBack = 0x7FF;  ///< time-high 回退不超过此值视为流重启（Reset）
+
+/// n 个字最多产出的事件数：AddrX 计 1，Vect12 计 12，Vect8 计 8。
+inline size_t evt3BoundScalar(const uint8_t* p, size_t n) {
+    size_t bound = 0;
+    for (size_t i = 0; i < n; ++i) {
+        switch (p[2 * i + 1] >> 4) {
+            case 0x1: bound += 1; break;
+            case 0x3: bound += 12; break;
+            case 0x4: bound += 8; break;
+            default: break;
+        }
+    }
+    return bound;
+}
+
+#if defined(SHIMETA_SIMD_AVX2)
+SHIMETA_TARGET_AVX2 inline size_t evt3BoundAvx2(const uint8_t* p, size_t n) {
+    const __m256i c1 = _mm256_set1_epi16(0x1);
+    const __m256i c3 = _mm256_set1_epi16(0x3);
+    const __m256i c4 = _mm256_set1_epi16(0x4);
+    size_t bound = 0, i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m256i type = _mm256_srli_epi16(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 2 * i)), 12);
+        // movemask 每个 16-bit 命中贡献 2 个置位
+        const unsigned a = unsigned(_mm_popcnt_u32(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi16(type, c1)))));
+        const unsigned v12 = unsigned(_mm_popcnt_u32(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi16(type, c3)))));
+        const unsigned v8 = unsigned(_mm_popcnt_u32(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi16(type, c4)))));
+        bound += (a + 12 * v12 + 8 * v8) / 2;
+    }
+    return bound + evt3BoundScalar(p + 2 * i, n - i);
+}
+#endif
+
+inline size_t evt3Bound(const uint8_t* p, size_t n) {
+#if defined(SHIMETA_SIMD_AVX2)
+    if (hasAvx2()) return evt3BoundAvx2(p, n);
+#elif defined(SHIMETA_SIMD_NEON)
+    const uint16x8_t c1 = vdupq_n_u16(0x1), c3 = vdupq_n_u16(0x3), c4 = vdupq_n_u16(0x4);
+    const uint16x8_t one = vdupq_n_u16(1);
+    size_t bound = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const uint16x8_t type = vshrq_n_u16(vreinterpretq_u16_u8(vld1q_u8(p + 2 * i)), 12);
+        bound += vaddvq_u16(vandq_u16(vceqq_u16(type, c1), one)) +
+                 12u * vaddvq_u16(vandq_u16(vceqq_u16(type, c3), one)) +
+                 8u * vaddvq_u16(vandq_u16(vceqq_u16(type, c4), one));
+    }
+    return bound + evt3BoundScalar(p + 2 * i, n - i);
+#endif
+    return evt3BoundScalar(p, n);
+}
+
+#if defined(SHIMETA_SIMD_AVX2)
+/// Vect 整块写出：每 4 个事件一组，xy = (base_x + i) | y<<16，t 广播，p = (bits >> i) & 1。
+SHIMETA_TARGET_AVX2 inline void evt3VectAvx2(EventCDSink& sink, uint32_t bits, int groups,
+                                             uint16_t base_x, uint16_t y, int64_t t) {
+    const __m256i iota = _mm256_setr_epi64x(0, 1, 2, 3);
+    const __m256i one  = _mm256_set1_epi64x(1);
+    const __m256i tv   = _mm256_set1_epi64x(t);
+    __m256i xy = _mm256_add_epi64(_mm256_set1_epi64x(int64_t(base_x) | (int64_t(y) << 16)), iota);
+    for (int g = 0; g < groups; ++g) {
+        const __m256i p = _mm256_and_si256(
+            _mm256_srlv_epi64(_mm256_set1_epi64x(int64_t(bits >> (4 * g))), iota), one);
+        sink.put4(xy, tv, p);
+        xy = _mm256_add_epi64(xy, _mm256_set1_epi64x(4));
+    }
+}
+#endif
+
+/// Vect12 / Vect8 展开（count 为 12 或 8）。
+template <class Sink>
+inline void evt3Vect(Sink& sink, uint32_t bits, int count, uint16_t base_x, uint16_t y, int64_t t) {
+#if defined(SHIMETA_SIMD_AVX2)
+    if constexpr (std::is_same_v<Sink, EventCDSink>) {
+        if (hasAvx2()) {
+            evt3VectAvx2(sink, bits, count / 4, base_x, y, t);
+            return;
+        }
+    }
+#endif
+    for (int i = 0; i < count; ++i)
+        sink.put(uint16_t(base_x + i), y, t, ((bits >> i) & 1u) != 0);
+}
+
+/// 单字处理，语义同 Evt3Decoder::handleWord。
+template <class Sink>
+inline void evt3Word(uint16_t w, Evt3State& st, Sink& sink) {
+    switch (w >> 12) {
+        case 0x0:  // AddrY
+            st.cur_y = w & 0xFFF;
+            st.y_set = true;
+            break;
+        case 0x1:  // AddrX
+            if (st.y_set) sink.put(uint16_t(w & 0x7FF), st.cur_y, st.fullTs(), ((w >> 11) & 1u) != 0);
+            break;
+        case 0x2:  // VectBaseX
+            st.base_x = w & 0x7FF;
+            st.base_x_set = true;
+            break;
+        case 0x3:  // Vect12
+            if (st.base_x_set && st.y_set) evt3Vect(sink, w & 0xFFFu, 12, st.base_x, st.cur_y, st.fullTs());
+            break;
+        case 0x4:  // Vect8
+            if (st.base_x_set && st.y_set) evt3Vect(sink, w & 0xFFu, 8, st.base_x, st.cur_y, st.fullTs());
+            break;
+        case 0x6:  // TimeLow
+            st.ts24 = (st.ts24 & 0xFFF000u) | (w & 0xFFFu);
+            break;
+        case 0x7: {  // TimeHigh
+            const uint16_t th = w & 0xFFF;
+            if (st.time_high_set && st.last_time_high > th) {
+                if (uint32_t(st.last_time_high - th) <= kEvt3MaxTimeHighBack) {
+                    st = Evt3State{};
+                    return;
+                }
+                ++st.overflow;
+            }
+            st.ts24 = (st.ts24 & 0xFFFu) | (uint32_t(th) << 12);
+            st.last_time_high = th;
+            st.time_high_set = true;
+            break;
+        }
+        default:  // ExtTrigger 及保留类型
+            break;
+    }
+}
+
+/// 当前状态下该字实际产出的事件数。
+inline size_t evt3WordEvents(uint16_t w, const Evt3State& st) {
+    switch (w >> 12) {
+        case 0x1: return st.y_set ? 1 : 0;
+        case 0x3: return (st.base_x_set && st.y_set) ? 12 : 0;
+        case 0x4: return (st.base_x_set && st.y_set) ? 8 : 0;
+        default:  return 0;
+    }
+}
+
+/// 定长输出：逐字解码直到下一个字的产出放不进剩余 room。返回已处理字数。
+template <class Sink>
+inline size_t evt3DecodeBounded(const uint8_t* p, size_t n, Evt3State& st, Sink& sink, size_t room) {
+    for (size_t i = 0; i < n; ++i) {
+        const uint16_t w = loadLe16(p + 2 * i);
+        const size_t need = evt3WordEvents(w, st);
+        if (need > room) return i;
+        room -= need;
+        evt3Word(w, st, sink);
+    }
+    return n;
+}
+
+/// 解码 n 个 16-bit 字；sink 须能容纳 evt3Bound(p, n) 个事件。
+template <class Sink>
+inline void evt3Decode(const uint8_t* p, size_t n, Evt3State& st, Sink& sink) {
+    for (size_t i = 0; i < n; ++i) evt3Word(loadLe16(p + 2 * i), st, sink);
+}
+
+} // namespace Shimeta::codec::detail
+#endif // SHIMETA_CODEC_DETAIL_EVT3_BATCH_H
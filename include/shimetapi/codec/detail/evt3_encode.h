@@ -0,0 +1,263 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// EVT3 向量字编码内核：输入按相同时间戳切成段，段内（乱序时）按 (y, x, polarity) 排序后，
+// 同行连续 12 / 8 个像素合成 VectBaseX + Vect12 / Vect8（mask 第 i 位 = x_base + i 的极性，
+// 对应 Evt3Decoder 的整块展开语义），其余仍发 AddrX。时间字 / AddrY 的发出规则沿用
+// Evt3Encoder::Encode（差别见 evt3EmitTime），两种模式共享编码器状态。
+#ifndef SHIMETA_CODEC_DETAIL_EVT3_ENCODE_H
+#define SHIMETA_CODEC_DETAIL_EVT3_ENCODE_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <shimetapi/core/event_cd.h>
+#include <shimetapi/codec/detail/simd.h>
+namespace Shimeta::codec::detail {
+
+/// 与 Evt3Encoder 私有成员一一对应的编码状态。
+struct Evt3EncState {
+    uint16_t last_y;
+    uint32_t last_ts24;
+    uint64_t rollovers;
+};
+
+/// 段内排序键：y(12) | x(11) | polarity(1)；按键升序即 (y, x, polarity) 序，
+/// key >> 1 为行内线性位置，连续像素的 key >> 1 逐一递增。
+inline uint32_t evt3Key(const EventCD& e) {
+    return (uint32_t(e.y & 0xFFF) << 12) | (uint32_t(e.x & 0x7FF) << 1) | (e.polarity ? 1u : 0u);
+}
+
+/// 16-bit 字追加器：按段预留，写指针直写。
+struct Evt3WordWriter {
+    std::vector<uint8_t>& out;
+    size_t used;
+
+    explicit Evt3WordWriter(std::vector<uint8_t>& o) : out(o), used(o.size()) {}
+    void ensure(size_t words) {
+        const size_t need = used + 2 * words;
+        if (out.size() >= need) return;
+        if (out.capacity() < need) out.reserve(std::max(out.capacity() * 2, need));
+        out.resize(need);
+    }
+    void put(uint16_t w) {
+        out[used] = uint8_t(w);
+        out[used + 1] = uint8_t(w >> 8);
+        used += 2;
+    }
+    void finish() { out.resize(used); }
+};
+
+/// k[0..len) 的像素位置是否逐一递增（len 为 8 或 12）；是则 mask 第 i 位 = k[i] 的极性。
+inline bool evt3RunScalar(const uint32_t* k, int len, uint32_t& mask) {
+    const uint32_t base = k[0] >> 1;
+    uint32_t m = 0;
+    for (int i = 0; i < len; ++i) {
+        if ((k[i] >> 1) != base + uint32_t(i)) return false;
+        m |= (k[i] & 1u) << i;
+    }
+    mask = m;
+    return true;
+}
+
+#if defined(SHIMETA_SIMD_AVX2)
+/// 8 个键一次比较：位置与 base + iota 逐道相等，极性取最低位经 movemask 聚成 8-bit mask。
+SHIMETA_TARGET_AVX2 inline bool evt3Run8Avx2(const uint32_t* k, uint32_t base, uint32_t& mask) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(k));
+    const __m256i want = _mm256_add_epi32(_mm256_set1_epi32(int(base)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    const __m256i eq = _mm256_cmpeq_epi32(_mm256_srli_epi32(v, 1), want);
+    if (_mm256_movemask_ps(_mm256_castsi256_ps(eq)) != 0xFF) return false;
+    mask = uint32_t(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_slli_epi32(v, 31))));
+    return true;
+}
+
+/// 12 个键：[0, 8) 与 [4, 12) 两次 8 道比较，重叠道 mask 一致。
+SHIMETA_TARGET_AVX2 inline bool evt3RunAvx2(const uint32_t* k, int len, uint32_t& mask) {
+    const uint32_t base = k[0] >> 1;
+    uint32_t lo, hi;
+    if (!evt3Run8Avx2(k, base, lo)) return false;
+    if (len == 8) {
+        mask = lo;
+        return true;
+    }
+    if (!evt3Run8Avx2(k + 4, base + 4, hi)) return false;
+    mask = lo | (hi << 4);
+    return true;
+}
+#elif defined(SHIMETA_SIMD_NEON)
+inline bool evt3Run4Neon(const uint32_t* k, uint32_t base, uint32_t& mask) {
+    static const uint32_t kIota[4] = {0, 1, 2, 3};
+    const uint32x4_t iota = vld1q_u32(kIota);
+    const uint32x4_t v = vld1q_u32(k);
+    const uint32x4_t eq = vceqq_u32(vshrq_n_u32(v, 1), vaddq_u32(vdupq_n_u32(base), iota));
+    if (vminvq_u32(eq) != 0xFFFFFFFFu) return false;
+    mask = vaddvq_u32(vshlq_u32(vandq_u32(v, vdupq_n_u32(1)), vreinterpretq_s32_u32(iota)));
+    return true;
+}
+
+inline bool evt3RunNeon(const uint32_t* k, int len, uint32_t& mask) {
+    const uint32_t base = k[0] >> 1;
+    uint32_t m = 0;
+    for (int g = 0; g < len / 4; ++g) {
+        uint32_t part;
+        if (!evt3Run4Neon(k + 4 * g, base + 4 * uint32_t(g), part)) return false;
+        m |= part << (4 * g);
+    }
+    mask = m;
+    return true;
+}
+#endif
+
+inline bool evt3Run(const uint32_t* k, int len, uint32_t& mask) {
+#if defined(SHIMETA_SIMD_AVX2)
+    if (hasAvx2()) return evt3RunAvx2(k, len, mask);
+#elif defined(SHIMETA_SIMD_NEON)
+    return evt3RunNeon(k, len, mask);
+#endif
+    return evt3RunScalar(k, len, mask);
+}
+
+/// 24-bit 键排序：短段插入排序，长段 3 趟 8-bit LSD 基数排序（tmp 至少 n 个元素；
+/// 某字节全段相同则跳过该趟）。结果留在 k。
+inline void evt3SortKeys(uint32_t* k, uint32_t* tmp, size_t n) {
+    if (n <= 32) {
+        for (size_t i = 1; i < n; ++i) {
+            const uint32_t v = k[i];
+            size_t j = i;
+            for (; j > 0 && k[j - 1] > v; --j) k[j] = k[j - 1];
+            k[j] = v;
+        }
+        return;
+    }
+    uint32_t* src = k;
+    uint32_t* dst = tmp;
+    for (int shift = 0; shift < 24; shift += 8) {
+        size_t count[256] = {};
+        for (size_t i = 0; i < n; ++i) ++count[(src[i] >> shift) & 0xFF];
+        if (count[(src[0] >> shift) & 0xFF] == n) continue;
+        size_t sum = 0;
+        for (size_t& c : count) {
+            const size_t v = c;
+            c = sum;
+            sum += v;
+        }
+        for (size_t i = 0; i < n; ++i) dst[count[(src[i] >> shift) & 0xFF]++] = src[i];
+        std::swap(src, dst);
+    }
+    if (src != k) std::copy(src, src + n, k);
+}
+
+constexpr size_t kEvt3MergeStreams = 16;  ///< 不超过此路数的有序流交错时归并而非排序
+
+/// streams 路升序流（bounds[s] 为第 s 路起点，bounds[streams] == n）两两归并，结果留在 k。
+inline void evt3MergeStreams(uint32_t* k, uint32_t* tmp, size_t n, size_t* bounds, size_t streams) {
+    const auto byPos = [](uint32_t a, uint32_t b) { return (a >> 1) < (b >> 1); };
+    uint32_t* src = k;
+    uint32_t* dst = tmp;
+    while (streams > 1) {
+        size_t merged = 0;
+        for (size_t s = 0; s < streams; s += 2) {
+            const size_t b = bounds[s];
+            const size_t m = bounds[std::min(s + 1, streams)];
+            const size_t e = bounds[std::min(s + 2, streams)];
+            std::merge(src + b, src + m, src + m, src + e, dst + b, byPos);
+            bounds[merged++] = b;
+        }
+        bounds[merged] = n;
+        streams = merged;
+        std::swap(src, dst);
+    }
+    if (src != k) std::copy(src, src + n, k);
+}
+
+/// 时间字，规则同 Evt3Encoder::Encode：跨 2^24 时先发 0x7FFF/0x7000 驱动解码器翻转，
+/// time-high 变化才发 TimeHigh，时间戳变化发 TimeLow。唯一差别：last_ts24 为哨兵值
+/// （流首 / 翻转后）时总发 TimeHigh——Encode 拿哨兵的高位 0xFFF 参与比较，time-high 恰为
+/// 0xFFF 时会漏发。
+inline void evt3EmitTime(int64_t t, Evt3EncState& st, Evt3WordWriter& w) {
+    const uint32_t ts24 = uint32_t(t) & 0xFFFFFFu;
+    const uint64_t roll = uint64_t(t) >> 24;
+    if (roll > st.rollovers) {
+        do {
+            w.ensure(2);
+            w.put(0x7FFF);
+            w.put(0x7000);
+            st.last_ts24 = 0xFFFFFFFFu;
+            ++st.rollovers;
+        } while (st.rollovers < roll);
+    } else if (st.last_ts24 == ts24) {
+        return;
+    }
+    w.ensure(2);
+    if (st.last_ts24 > 0xFFFFFFu || ((st.last_ts24 ^ ts24) & 0xFFF000u))
+        w.put(uint16_t(0x7000 | ((ts24 >> 12) & 0xFFF)));
+    w.put(uint16_t(0x6000 | (ts24 & 0xFFF)));
+    st.last_ts24 = ts24;
+}
+
+/// 一段同时间戳、已排序的键 k[0..n) 编码为 AddrY / VectBaseX / Vect12 / Vect8 / AddrX。
+inline void evt3EmitSorted(const uint32_t* k, size_t n, Evt3EncState& st, Evt3WordWriter& w) {
+    w.ensure(2 * n);  // 最坏每事件 AddrY + AddrX；向量字每 8 / 12 个事件只占 2 个字
+    int base_x = -1;  // 本段内已发 VectBaseX（Vect 字不推进 base_x，需逐块重发）
+    for (size_t i = 0; i < n;) {
+        const uint16_t y = uint16_t(k[i] >> 12);
+        if (y != st.last_y) {
+            w.put(y);
+            st.last_y = y;
+        }
+        const uint32_t x = (k[i] >> 1) & 0x7FF;
+        const size_t left = n - i;
+        // 必要条件预筛：第 8 个键恰好在 x + 7（稀疏场景一次比较即回落到 AddrX）
+        if (left >= 8 && x + 7 <= 0x7FF && (k[i + 7] >> 1) == (k[i] >> 1) + 7) {
+            uint32_t mask;
+            const int len = (left >= 12 && x + 11 <= 0x7FF && evt3Run(k + i, 12, mask)) ? 12
+                          : evt3Run(k + i, 8, mask) ? 8 : 0;
+            if (len) {
+                if (base_x != int(x)) {
+                    w.put(uint16_t(0x2000 | x));
+                    base_x = int(x);
+                }
+                w.put(uint16_t((len == 12 ? 0x3000 : 0x4000) | mask));
+                i += size_t(len);
+                continue;
+            }
+        }
+        w.put(uint16_t(((k[i] & 1u) ? 0x1800 : 0x1000) | x));
+        ++i;
+    }
+}
+
+/// 编码 events[0..count)：按相邻同时间戳分段，段内基本有序则按原序取键，否则排序。
+/// 解码结果与 Encode 的输出为同一事件多重集；段内（同一时间戳）顺序可能改变。
+inline void evt3EncodeVector(const EventCD* events, size_t count, Evt3EncState& st,
+                             std::vector<uint32_t>& keys, std::vector<uint8_t>& out) {
+    Evt3WordWriter w(out);
+    for (size_t i = 0; i < count;) {
+        const int64_t t = events[i].t;
+        size_t j = i + 1;
+        while (j < count && events[j].t == t) ++j;
+        evt3EmitTime(t, st, w);
+        const size_t n = j - i;
+        if (keys.size() < 2 * n) keys.resize(2 * n);  // [0, n) 键，[n, 2n) 排序 / 归并暂存
+        // 升序流切分（按像素位置，同像素极性先后不计）：记下前 kEvt3MergeStreams 路的起点
+        size_t descents = 0;
+        size_t bounds[kEvt3MergeStreams + 1] = {0};
+        keys[0] = evt3Key(events[i]);
+        for (size_t m = 1; m < n; ++m) {
+            keys[m] = evt3Key(events[i + m]);
+            if ((keys[m - 1] >> 1) > (keys[m] >> 1) && ++descents < kEvt3MergeStreams) bounds[descents] = m;
+        }
+        // 少数几路有序流交错（如同一时间戳的 4 个空间子帧）归并；乱序（平均升序段不足一个
+        // Vect8）基数排序；大量按行成段的数据原序即可成块，不排序
+        if (descents != 0 && descents < kEvt3MergeStreams) {
+            bounds[descents + 1] = n;
+            evt3MergeStreams(keys.data(), keys.data() + n, n, bounds, descents + 1);
+        } else if (descents * 8 > n) {
+            evt3SortKeys(keys.data(), keys.data() + n, n);
+        }
+        evt3EmitSorted(keys.data(), n, st, w);
+        i = j;
+    }
+    w.finish();
+}
+
+} // namespace Shimeta::codec::detail
+#endif // SHIMETA_CODEC_DETAIL_EVT3_ENCODE_H
@@ -0,0 +1,86 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// 常驻线程的 fork-join 池：run(f) 在全部 size() 个 worker 上各调用一次 f(worker)，
+// 调用线程自身充当 worker 0，全部返回后 run 才返回。线程在构造时创建、析构时回收，
+// 每包解码无线程创建开销。run 不可重入，也不应被多个线程并发调用。
+#ifndef SHIMETA_CODEC_DETAIL_FORK_JOIN_H
+#define SHIMETA_CODEC_DETAIL_FORK_JOIN_H
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+namespace Shimeta::codec::detail {
+
+class ForkJoin {
+public:
+    /// workers <= 0 取 std::thread::hardware_concurrency()。
+    explicit ForkJoin(int workers) {
+        if (workers <= 0) workers = int(std::thread::hardware_concurrency());
+        if (workers <= 0) workers = 1;
+        size_ = workers;
+        threads_.reserve(size_t(workers - 1));
+        for (int w = 1; w < workers; ++w) threads_.emplace_back([this, w] { loop(w); });
+    }
+    ~ForkJoin() {
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            stop_ = true;
+        }
+        start_cv_.notify_all();
+        for (auto& t : threads_) t.join();
+    }
+    ForkJoin(const ForkJoin&) = delete;
+    ForkJoin& operator=(const ForkJoin&) = delete;
+
+    int size() const { return size_; }
+
+    void run(const std::function<void(int)>& f) {
+        if (size_ == 1) {
+            f(0);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            job_ = &f;
+            pending_ = size_ - 1;
+            ++gen_;
+        }
+        start_cv_.notify_all();
+        f(0);
+        std::unique_lock<std::mutex> lk(mu_);
+        done_cv_.wait(lk, [this] { return pending_ == 0; });
+        job_ = nullptr;
+    }
+
+private:
+    void loop(int w) {
+        uint64_t seen = 0;
+        for (;;) {
+            const std::function<void(int)>* job;
+            {
+                std::unique_lock<std::mutex> lk(mu_);
+                start_cv_.wait(lk, [&] { return stop_ || gen_ != seen; });
+                if (stop_) return;
+                seen = gen_;
+                job = job_;
+            }
+            (*job)(w);
+            std::lock_guard<std::mutex> lk(mu_);
+            if (--pending_ == 0) done_cv_.notify_one();
+        }
+    }
+
+    int size_ = 1;
+    std::vector<std::thread> threads_;
+    std::mutex mu_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    const std::function<void(int)>* job_ = nullptr;
+    uint64_t gen_ = 0;
+    int pending_ = 0;
+    bool stop_ = false;
+};
+
+} // namespace Shimeta::codec::detail
+#endif // SHIMETA_CODEC_DETAIL_FORK_JOIN_H
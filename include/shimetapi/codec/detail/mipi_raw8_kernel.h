@@ -0,0 +1,158 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// apx003 RAW8 单子帧解码内核（与 MipiRaw8Decoder::Decode 的逐子帧逻辑逐位一致）。
+// 典型场景子帧大部分为 0：先按行 / 256-bit 块做 SIMD 零检测跳过，非零字再用 ctz 取置位像素。
+// 子帧布局：16 字节头 + 304 行 × 12 个 64-bit 字（每字 32 像素 × 2 bit）。
+// 子帧 id（0..3）决定 2×2 交错中的 (x0, y0)：第 j 行第 i 像素落在 (x0 + 2i, y0 + 2j)。
+#ifndef SHIMETA_CODEC_DETAIL_MIPI_RAW8_KERNEL_H
+#define SHIMETA_CODEC_DETAIL_MIPI_RAW8_KERNEL_H
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <shimetapi/codec/detail/event_sink.h>
+#include <shimetapi/codec/detail/simd.h>
+namespace Shimeta::codec::detail {
+
+constexpr size_t kRaw8SubframeBytes = 32768;                 ///< 同 MipiRaw8Layout::kSubframeBytes
+constexpr size_t kRaw8HeaderBytes   = 16;
+constexpr int    kRaw8Rows          = 304;
+constexpr int    kRaw8WordsPerRow   = 12;                    ///< 384 像素 / 32
+constexpr size_t kRaw8MaxSubEvents  = size_t(kRaw8Rows) * kRaw8WordsPerRow * 32;
+
+/// 一包中待解子帧数：len 内完整子帧数，requested > 0 时取二者较小者（同 MipiRaw8Decoder::Decode）。
+inline size_t raw8Subframes(size_t len, int requested) {
+    size_t n = len / kRaw8SubframeBytes;
+    if (requested > 0 && size_t(requested) < n) n = size_t(requested);
+    return n;
+}
+
+inline uint64_t raw8Load64(const uint8_t* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/// 子帧头：有效时给出 2×2 交错偏移与时间戳（微秒），否则返回 false（整帧跳过）。
+struct Raw8SubHeader {
+    uint16_t x0;
+    uint16_t y0;
+    int64_t  t;
+};
+
+inline bool raw8ParseHeader(const uint8_t* p, Raw8SubHeader& h) {
+    const uint64_t head = raw8Load64(p);
+    if ((uint32_t(head) & 0x00FFFFFFu) != 0x0000FFFFu) return false;
+    const uint32_t id = uint32_t(raw8Load64(p + 8) >> 44) & 0xFu;
+    if (id > 3) return false;
+    h.x0 = uint16_t(id & 1u);
+    h.y0 = uint16_t(id >> 1);
+    h.t  = int64_t((head >> 25) / 100);
+    return true;
+}
+
+/// 2-bit 像素非 0 掩码：每个非 0 像素在其低位（偶数 bit）置 1。
+inline uint64_t raw8PixelMask(uint64_t word) {
+    return (word | (word >> 1)) & 0x5555555555555555ull;
+}
+
+/// 一个非 0 字内用 ctz 逐个取出事件（升序，与逐像素扫描顺序一致）。
+template <class Sink>
+inline void raw8EmitWord(uint64_t word, uint16_t x_base, uint16_t y, int64_t t, Sink& sink) {
+    for (uint64_t m = raw8PixelMask(word); m; m &= m - 1) {
+        const int b = __builtin_ctzll(m);
+        sink.put(uint16_t(x_base + b), y, t, ((word >> (b + 1)) & 1u) != 0);  // b = 2k → x = x0 + 64w + 2k
+    }
+}
+
+/// 一行 12 字：逐字零检测后展开。
+template <class Sink>
+inline void raw8EmitRow(const uint8_t* row, const Raw8SubHeader& h, uint16_t y, Sink& sink) {
+    for (int w = 0; w < kRaw8WordsPerRow; ++w) {
+        const uint64_t word = raw8Load64(row + 8 * w);
+        if (word) raw8EmitWord(word, uint16_t(h.x0 + 64 * w), y, h.t, sink);
+    }
+}
+
+/// 标量位图扫描：整行 OR 为 0 则跳过。
+template <class Sink>
+inline void raw8ScanScalar(const uint8_t* p, const Raw8SubHeader& h, Sink& sink) {
+    const uint8_t* row = p + kRaw8HeaderBytes;
+    for (int j = 0; j < kRaw8Rows; ++j, row += kRaw8WordsPerRow * 8) {
+        uint64_t any = 0;
+        for (int w = 0; w < kRaw8WordsPerRow; ++w) any |= raw8Load64(row + 8 * w);
+        if (any) raw8EmitRow(row, h, uint16_t(h.y0 + 2 * j), sink);
+    }
+}
+
+#if defined(SHIMETA_SIMD_AVX2)
+/// AVX2 位图扫描：一行 96 字节 = 3 个 256-bit，OR 后 testz 判空；非空行再按 256-bit 块判空。
+template <class Sink>
+SHIMETA_TARGET_AVX2 inline void raw8ScanAvx2(const uint8_t* p, const Raw8SubHeader& h, Sink& sink) {
+    const uint8_t* row = p + kRaw8HeaderBytes;
+    for (int j = 0; j < kRaw8Rows; ++j, row += kRaw8WordsPerRow * 8) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + 32));
+        const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + 64));
+        if (_mm256_testz_si256(_mm256_or_si256(_mm256_or_si256(a, b), c), _mm256_set1_epi8(-1)))
+            continue;
+        const uint16_t y = uint16_t(h.y0 + 2 * j);
+        const __m256i blk[3] = {a, b, c};
+        for (int q = 0; q < 3; ++q) {
+            if (_mm256_testz_si256(blk[q], blk[q])) continue;
+            for (int w = 4 * q; w < 4 * q + 4; ++w) {
+                const uint64_t word = raw8Load64(row + 8 * w);
+                if (word) raw8EmitWord(word, uint16_t(h.x0 + 64 * w), y, h.t, sink);
+            }
+        }
+    }
+}
+#endif
+
+#if defined(SHIMETA_SIMD_NEON)
+/// NEON 位图扫描：一行 6 个 128-bit，OR 后取最大字判空。
+template <class Sink>
+inline void raw8ScanNeon(const uint8_t* p, const Raw8SubHeader& h, Sink& sink) {
+    const uint8_t* row = p + kRaw8HeaderBytes;
+    for (int j = 0; j < kRaw8Rows; ++j, row += kRaw8WordsPerRow * 8) {
+        uint8x16_t acc = vld1q_u8(row);
+        for (int q = 1; q < 6; ++q) acc = vorrq_u8(acc, vld1q_u8(row + 16 * q));
+        if (vmaxvq_u8(acc) == 0) continue;
+        raw8EmitRow(row, h, uint16_t(h.y0 + 2 * j), sink);
+    }
+}
+#endif
+
+/// 子帧位图扫描（零块 SIMD 跳过 + 非零字 ctz 取位），耗时与事件数而非传感器面积成正比。
+template <class Sink>
+inline void raw8SubframeScan(const uint8_t* p, const Raw8SubHeader& h, Sink& sink) {
+#if defined(SHIMETA_SIMD_AVX2)
+    if (hasAvx2()) {
+        raw8ScanAvx2(p, h, sink);
+        return;
+    }
+#elif defined(SHIMETA_SIMD_NEON)
+    raw8ScanNeon(p, h, sink);
+    return;
+#endif
+    raw8ScanScalar(p, h, sink);
+}
+
+/// 解码一个 32 KiB 子帧；头无效时不产出事件。
+template <class Sink>
+inline void raw8Subframe(const uint8_t* p, Sink& sink) {
+    Raw8SubHeader h;
+    if (raw8ParseHeader(p, h)) raw8SubframeScan(p, h, sink);
+}
+
+/// 子帧事件数（头校验 + popcount，不写输出；定长输出时判断是否放得下）。
+inline size_t raw8SubframeEvents(const uint8_t* p) {
+    Raw8SubHeader h;
+    if (!raw8ParseHeader(p, h)) return 0;
+    size_t n = 0;
+    const uint8_t* px = p + kRaw8HeaderBytes;
+    for (int i = 0; i < kRaw8Rows * kRaw8WordsPerRow; ++i)
+        n += size_t(__builtin_popcountll(raw8PixelMask(raw8Load64(px + 8 * i))));
+    return n;
+}
+
+} // namespace Shimeta::codec::detail
+#endif // SHIMETA_CODEC_DETAIL_MIPI_RAW8_KERNEL_H
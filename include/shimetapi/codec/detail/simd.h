@@ -0,0 +1,50 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// codec 内部 SIMD 分派：x86_64 运行时探测 AVX2（函数级 target 属性，无需 -mavx2 编译），
+// aarch64（s100/x5）NEON 为基线指令集直接启用；其余平台走标量回退。
+// 定义 SHIMETA_CODEC_NO_SIMD 可强制标量路径（交叉校验 / 排查用）。
+#ifndef SHIMETA_CODEC_DETAIL_SIMD_H
+#define SHIMETA_CODEC_DETAIL_SIMD_H
+#include <cstdint>
+#include <cstring>
+
+#if !defined(SHIMETA_CODEC_NO_SIMD)
+#  if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#    define SHIMETA_SIMD_AVX2 1
+#    include <immintrin.h>
+#    define SHIMETA_TARGET_AVX2 __attribute__((target("avx2,bmi,popcnt")))
+#  elif defined(__aarch64__) && defined(__ARM_NEON)
+#    define SHIMETA_SIMD_NEON 1
+#    include <arm_neon.h>
+#  endif
+#endif
+
+namespace Shimeta::codec::detail {
+
+/// 运行时是否可走 AVX2 路径（结果缓存；非 x86 恒为 false）。
+inline bool hasAvx2() {
+#if defined(SHIMETA_SIMD_AVX2)
+    static const bool ok = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi") &&
+                           __builtin_cpu_supports("popcnt");
+    return ok;
+#else
+    return false;
+#endif
+}
+
+/// 非对齐小端 32-bit 读取（包缓冲区只保证字节对齐）。
+inline uint32_t loadLe32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/// 非对齐小端 16-bit 读取。
+inline uint16_t loadLe16(const uint8_t* p) {
+    return uint16_t(p[0] | (uint16_t(p[1]) << 8));
+}
+
+/// 最低置位下标（v != 0）。
+inline int ctz32(uint32_t v) { return __builtin_ctz(v); }
+
+} // namespace Shimeta::codec::detail
+#endif // SHIMETA_CODEC_DETAIL_SIMD_H
@@ -3,11 +3,16 @@
 #ifndef SHIMETA_CODEC_EVT2_CODEC_H
 #define SHIMETA_CODEC_EVT2_CODEC_H
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <string>
 #include <vector>
+#include <shimetapi/core/event_batch.h>
 #include <shimetapi/core/event_cd.h>
+#include <shimetapi/codec/decode_result.h>
+#include <shimetapi/codec/detail/event_sink.h>
+#include <shimetapi/codec/detail/evt2_batch.h>
 
 namespace Shimeta {
 namespace codec {
@@ -109,6 +114,64 @@ public:
     /// @brief 解码 32-bit word 流，把 CD 事件追加到 out。返回本调用新增 CD 事件数。
     size_t Decode(const uint8_t* buffer, size_t buffer_size, std::vector<EventCD>& out);
 
+    /// @brief 批量解码：8 字一块做 SIMD 分类（x86_64 AVX2 / aarch64 NEON，其余标量回退），
+    ///        一遍散写 x/y/t/polarity。输出与 Decode 逐位一致，且共享同一 time-base 状态
+    ///        （两者可交替调用）；out 按字数一次性扩容，热循环内无 push_back。
+    ///        返回本调用新增 CD 事件数。
+    size_t DecodeBatch(const uint8_t* buffer, size_t buffer_size, std::vector<EventCD>& out) {
+        size_t n = seekWords(buffer, buffer_size);
+        if (n == 0) return 0;
+        const size_t old = out.size();
+        out.resize(old + n);
+        detail::EventCDSink sink{out.data() + old};
+        detail::evt2Decode(buffer, n, current_time_base_, n_time_high_loop_, sink);
+        out.resize(size_t(sink.cur - out.data()));
+        return out.size() - old;
+    }
+
+    /// @brief 解码进 SoA 事件批（追加，走 DecodeBatch 同一内核；整块 CD 直接向量化写四个数组）。
+    ///        返回本调用新增 CD 事件数。
+    size_t Decode(const uint8_t* buffer, size_t buffer_size, EventBatch& out) {
+        size_t n = seekWords(buffer, buffer_size);
+        if (n == 0) return 0;
+        const size_t old = out.size();
+        out.reserve(old + n);
+        auto sink = detail::EventBatchSink::at(out);
+        detail::evt2Decode(buffer, n, current_time_base_, n_time_high_loop_, sink);
+        sink.commit(out);
+        return out.size() - old;
+    }
+
+    /// @brief 定长输出解码：最多写 capacity 个事件到 out，不分配内存。
+    ///        写满时返回 ErrBufferFull，已推进到 consumed 字节处，换输出区后从 buffer + consumed 续调。
+    ///        末尾不足 4 字节的残余不计入 consumed（与 Decode 一样丢弃）。
+    DecodeResult Decode(const uint8_t* buffer, size_t buffer_size, EventCD* out, size_t capacity) {
+        DecodeResult r;
+        const uint8_t* p = buffer;
+        const size_t n = seekWords(p, buffer_size);
+        r.consumed = size_t(p - buffer);
+        detail::EventCDSink sink{out};
+        size_t done = 0;
+        while (done < n) {
+            size_t k = std::min(n - done, capacity - size_t(sink.cur - out));   // CD 字每字至多 1 事件
+            if (k == 0) {
+                k = detail::evt2NonCdRun(p + done * sizeof(RawEvent), n - done);
+                if (k == 0) {
+                    r.status = Status::ErrBufferFull;
+                    break;
+                }
+            }
+            detail::evt2Decode(p + done * sizeof(RawEvent), k, current_time_base_, n_time_high_loop_, sink);
+            done += k;
+        }
+        r.events = size_t(sink.cur - out);
+        r.consumed += done * sizeof(RawEvent);
+        return r;
+    }
+
+    /// @brief len 字节 EVT2 流最多产出的事件数（每 32-bit 字至多 1 个），用于一次性预分配输出区。
+    static constexpr size_t MaxEventsForBytes(size_t len) { return len / sizeof(RawEvent); }
+
     /// @brief 重置解码器状态
     void Reset();
 
@@ -121,6 +184,19 @@ private:
     unsigned int n_time_high_loop_;     ///< Counter of time high loops
 
     void processEvent(const RawEvent* raw_event, std::vector<EventCD>& out);
+
+    /// 批量路径公共前导：按字截断，首包丢弃首个 TIME_HIGH 之前的字。返回待解码字数，buffer 前移。
+    size_t seekWords(const uint8_t*& buffer, size_t buffer_size) {
+        if (buffer == nullptr || buffer_size == 0) return 0;
+        size_t n = buffer_size / sizeof(RawEvent);
+        if (!first_time_base_set_) {
+            const size_t first = detail::evt2SeekTimeBase(buffer, n, current_time_base_,
+                                                          first_time_base_set_);
+            buffer += first * sizeof(RawEvent);
+            n -= first;
+        }
+        return n;
+    }
 };
 
 /// @brief EVT2 编码器（事件 → 原始字节）
@@ -5,7 +5,12 @@
 #include <cstddef>
 #include <cstdint>
 #include <vector>
+#include <shimetapi/core/event_batch.h>
 #include <shimetapi/core/event_cd.h>
+#include <shimetapi/codec/decode_result.h>
+#include <shimetapi/codec/detail/event_sink.h>
+#include <shimetapi/codec/detail/evt3_batch.h>
+#include <shimetapi/codec/detail/evt3_encode.h>
 namespace Shimeta::codec {
 
 enum class Evt3Type : uint8_t {
@@ -25,6 +30,57 @@ public:
     Evt3Decoder();
     /// 解码 16-bit word 流（字节长度 len 必须为 2 的倍数）。返回解码事件数。
     size_t Decode(const uint8_t* buf, size_t len, std::vector<EventCD>& out);
+    /// 批量解码：Vect12/Vect8 整块展开（x86_64 AVX2 一次写 4 个事件，其余平台标量），
+    /// 状态字仍逐字处理；out 按 SIMD 类型计数得到的上界一次性扩容。
+    /// 输出与 Decode 逐位一致且共享状态（两者可交替调用）。返回解码事件数。
+    size_t DecodeBatch(const uint8_t* buf, size_t len, std::vector<EventCD>& out) {
+        if (buf == nullptr || (len & 1)) return 0;
+        const size_t n = len / 2;
+        const size_t old = out.size();
+        out.resize(old + detail::evt3Bound(buf, n));
+        detail::EventCDSink sink{out.data() + old};
+        decodeWords(buf, n, sink);
+        out.resize(size_t(sink.cur - out.data()));
+        return out.size() - old;
+    }
+    /// 解码进 SoA 事件批（追加，同 DecodeBatch 内核）。返回解码事件数。
+    size_t Decode(const uint8_t* buf, size_t len, EventBatch& out) {
+        if (buf == nullptr || (len & 1)) return 0;
+        const size_t n = len / 2;
+        const size_t old = out.size();
+        out.reserve(old + detail::evt3Bound(buf, n));
+        auto sink = detail::EventBatchSink::at(out);
+        decodeWords(buf, n, sink);
+        sink.commit(out);
+        return out.size() - old;
+    }
+    /// 定长输出解码：最多写 capacity 个事件到 out，不分配内存；len 为奇数返回 ErrInvalidParam。
+    /// 下一个字（Vect12 一次 12 个）放不下时返回 ErrBufferFull，从 buf + consumed 续调。
+    DecodeResult Decode(const uint8_t* buf, size_t len, EventCD* out, size_t capacity) {
+        DecodeResult r;
+        if (buf == nullptr || len == 0) return r;
+        if (len & 1) {
+            r.status = Status::ErrInvalidParam;
+            return r;
+        }
+        const size_t n = len / 2;
+        detail::EventCDSink sink{out};
+        detail::Evt3State st = loadState();
+        size_t done;
+        if (detail::evt3Bound(buf, n) <= capacity) {
+            detail::evt3Decode(buf, n, st, sink);
+            done = n;
+        } else {
+            done = detail::evt3DecodeBounded(buf, n, st, sink, capacity);
+            if (done < n) r.status = Status::ErrBufferFull;
+        }
+        storeState(st);
+        r.events = size_t(sink.cur - out);
+        r.consumed = done * 2;
+        return r;
+    }
+    /// len 字节 EVT3 流最多产出的事件数（每 16-bit 字至多 12 个），用于一次性预分配输出区。
+    static constexpr size_t MaxEventsForBytes(size_t len) { return (len / 2) * 12; }
     void Reset();
 private:
     uint16_t cur_y_ = 0;
@@ -37,6 +93,28 @@ private:
     uint64_t overflow_ = 0;      // 24-bit 翻转计数
     void handleWord(uint16_t w, std::vector<EventCD>& out);
     int64_t fullTs() const { return int64_t((overflow_ << 24) | ts24_); }
+
+    /// 批量路径：成员状态拷入 detail::Evt3State，解码后写回。
+    detail::Evt3State loadState() const {
+        return detail::Evt3State{cur_y_, base_x_, base_x_set_, y_set_,
+                                 ts24_, last_time_high_, time_high_set_, overflow_};
+    }
+    void storeState(const detail::Evt3State& st) {
+        cur_y_ = st.cur_y;
+        base_x_ = st.base_x;
+        base_x_set_ = st.base_x_set;
+        y_set_ = st.y_set;
+        ts24_ = st.ts24;
+        last_time_high_ = st.last_time_high;
+        time_high_set_ = st.time_high_set;
+        overflow_ = st.overflow;
+    }
+    template <class Sink>
+    void decodeWords(const uint8_t* buf, size_t n, Sink& sink) {
+        detail::Evt3State st = loadState();
+        detail::evt3Decode(buf, n, st, sink);
+        storeState(st);
+    }
 };
 
 /// EVT3 编码器（逆过程）。
@@ -44,6 +122,18 @@ class Evt3Encoder {
 public:
     Evt3Encoder();
     void Encode(const EventCD* events, size_t count, std::vector<uint8_t>& out);
+    /// 向量字编码（追加到 out）：相同时间戳的一段事件按 (y, x) 归组，同行连续 12 / 8 个像素
+    /// 发 VectBaseX + Vect12 / Vect8（极性即 mask 位），其余发 AddrX；行程判定与 mask 构造
+    /// 走 SIMD。Evt3Decoder 解出的事件多重集与 Encode 相同，但段内顺序变为 (y, x, polarity)
+    /// 升序。与 Encode 共享状态，可交替调用。
+    void EncodeVector(const EventCD* events, size_t count, std::vector<uint8_t>& out) {
+        thread_local std::vector<uint32_t> keys;  // 段内排序键，按线程复用
+        detail::Evt3EncState st{last_y_, last_ts24_, rollovers_emitted_};
+        detail::evt3EncodeVector(events, count, st, keys, out);
+        last_y_ = st.last_y;
+        last_ts24_ = st.last_ts24;
+        rollovers_emitted_ = st.rollovers;
+    }
     void Reset();
 private:
     uint16_t last_y_ = 0xFFFF;
@@ -5,8 +5,12 @@
 #include <cstddef>
 #include <cstdint>
 #include <vector>
+#include <shimetapi/core/event_batch.h>
 #include <shimetapi/core/event_cd.h>
 #include <shimetapi/core/evs_timestamp.h>
+#include <shimetapi/codec/decode_result.h>
+#include <shimetapi/codec/detail/event_sink.h>
+#include <shimetapi/codec/detail/mipi_raw8_kernel.h>
 namespace Shimeta::codec {
 
 struct MipiRaw8Layout {
@@ -30,6 +34,59 @@ public:
     /// 返回解码事件数。
     size_t Decode(const uint8_t* data, size_t len, std::vector<EventCD>& out,
                   int subframe_count = 0);
+    /// 位图扫描版 Decode（同语义、输出逐位一致）：按行 / 256-bit 块 SIMD 零检测跳过空白，
+    /// 非零字用 ctz 取置位像素，耗时与事件数而非传感器面积成正比。
+    size_t DecodeBatch(const uint8_t* data, size_t len, std::vector<EventCD>& out,
+                       int subframe_count = 0) {
+        out.clear();
+        if (data == nullptr || len < MipiRaw8Layout::kSubframeBytes) return 0;
+        const size_t count = detail::raw8Subframes(len, subframe_count);
+        out.reserve(count * 10000);   // 与 Decode 相同的预留（典型密度下免扩容）
+        detail::EventCDAppendSink sink{&out};
+        for (size_t s = 0; s < count; ++s)
+            detail::raw8Subframe(data + s * MipiRaw8Layout::kSubframeBytes, sink);
+        return out.size();
+    }
+    /// 解码进 SoA 事件批（同 DecodeBatch 语义：先清空 out，返回 out.size()）。
+    size_t Decode(const uint8_t* data, size_t len, EventBatch& out, int subframe_count = 0) {
+        out.clear();
+        if (data == nullptr || len < MipiRaw8Layout::kSubframeBytes) return 0;
+        const size_t count = detail::raw8Subframes(len, subframe_count);
+        for (size_t s = 0; s < count; ++s) {
+            out.reserve(out.size() + detail::kRaw8MaxSubEvents);
+            auto sink = detail::EventBatchSink::at(out);
+            detail::raw8Subframe(data + s * MipiRaw8Layout::kSubframeBytes, sink);
+            sink.commit(out);
+        }
+        return out.size();
+    }
+    /// 定长输出解码：最多写 capacity 个事件到 out，不分配内存；以子帧为单位推进。
+    /// 下一个子帧放不下时返回 ErrBufferFull，consumed 为已处理子帧字节数；续调时传
+    /// data + consumed，subframe_count 相应减去已处理子帧数（自动档无需调整）。
+    /// capacity 至少为 MaxEventsForBytes(kSubframeBytes) 时保证每次至少推进一个子帧。
+    DecodeResult Decode(const uint8_t* data, size_t len, EventCD* out, size_t capacity,
+                        int subframe_count = 0) {
+        DecodeResult r;
+        if (data == nullptr || len < MipiRaw8Layout::kSubframeBytes) return r;
+        const size_t count = detail::raw8Subframes(len, subframe_count);
+        detail::EventCDSink sink{out};
+        for (size_t s = 0; s < count; ++s) {
+            const uint8_t* p = data + s * MipiRaw8Layout::kSubframeBytes;
+            const size_t room = capacity - size_t(sink.cur - out);
+            if (room < detail::kRaw8MaxSubEvents && detail::raw8SubframeEvents(p) > room) {
+                r.status = Status::ErrBufferFull;
+                break;
+            }
+            detail::raw8Subframe(p, sink);
+            r.consumed += MipiRaw8Layout::kSubframeBytes;
+        }
+        r.events = size_t(sink.cur - out);
+        return r;
+    }
+    /// len 字节最多产出的事件数（每个完整子帧至多 384×304 个），用于一次性预分配输出区。
+    static constexpr size_t MaxEventsForBytes(size_t len) {
+        return (len / MipiRaw8Layout::kSubframeBytes) * detail::kRaw8MaxSubEvents;
+    }
     void Reset() {}  // 无状态
 };
 
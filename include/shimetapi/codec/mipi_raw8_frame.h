@@ -0,0 +1,197 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// apx003 RAW8 → 事件帧的融合内核：位图扫描直接写极性 / ON-OFF 计数 / 最后时间戳图，
+// 不经 EventCD 中间表（显示与多数视觉前端只需要图像）。
+#ifndef SHIMETA_CODEC_MIPI_RAW8_FRAME_H
+#define SHIMETA_CODEC_MIPI_RAW8_FRAME_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <shimetapi/codec/mipi_raw8_codec.h>
+#include <shimetapi/codec/detail/mipi_raw8_kernel.h>
+namespace Shimeta::codec {
+
+/// 事件帧输出项（未启用项不分配、不写）。
+struct EventFrameOptions {
+    bool polarity  = true;   ///< uint8 极性图：0 = 无事件，1 = ON，2 = OFF（同像素后到覆盖）
+    bool on_count  = false;  ///< uint16 ON 事件计数（饱和）
+    bool off_count = false;  ///< uint16 OFF 事件计数（饱和）
+    bool last_ts   = false;  ///< int64 最后事件时间戳（微秒），无事件为 -1
+};
+
+/// 768×608 事件帧（各图行主序，stride = width）。
+struct EventFrame {
+    int width  = MipiRaw8Layout::kEvsWidth;
+    int height = MipiRaw8Layout::kEvsHeight;
+    std::vector<uint8_t>  polarity;
+    std::vector<uint16_t> on_count;
+    std::vector<uint16_t> off_count;
+    std::vector<int64_t>  last_ts;
+    int64_t t_begin   = 0;   ///< 首个有事件子帧的时间戳（微秒）
+    int64_t t_end     = 0;   ///< 最后一个有事件子帧的时间戳
+    size_t  events    = 0;
+    int     subframes = 0;   ///< 累加进来的有效子帧数
+
+    EventFrame() { configure(EventFrameOptions{}); }
+    explicit EventFrame(const EventFrameOptions& opt) { configure(opt); }
+
+    /// 按 opt 分配 / 释放各图并清空。
+    void configure(const EventFrameOptions& opt) {
+        const size_t n = size_t(width) * size_t(height);
+        polarity.assign(opt.polarity ? n : 0, 0);
+        on_count.assign(opt.on_count ? n : 0, 0);
+        off_count.assign(opt.off_count ? n : 0, 0);
+        last_ts.assign(opt.last_ts ? n : 0, -1);
+        resetStats();
+    }
+    /// 清空各图（保留分配）。
+    void clear() {
+        std::fill(polarity.begin(), polarity.end(), uint8_t(0));
+        std::fill(on_count.begin(), on_count.end(), uint16_t(0));
+        std::fill(off_count.begin(), off_count.end(), uint16_t(0));
+        std::fill(last_ts.begin(), last_ts.end(), int64_t(-1));
+        resetStats();
+    }
+
+private:
+    void resetStats() {
+        t_begin = t_end = 0;
+        events = 0;
+        subframes = 0;
+    }
+};
+
+namespace detail {
+
+/// 融合输出端：事件直接落到 EventFrame 各图。
+struct EventFrameSink {
+    uint8_t*  pol;
+    uint16_t* on;
+    uint16_t* off;
+    int64_t*  ts;
+    size_t    stride;
+    size_t    n = 0;
+
+    explicit EventFrameSink(EventFrame& f)
+        : pol(f.polarity.empty() ? nullptr : f.polarity.data()),
+          on(f.on_count.empty() ? nullptr : f.on_count.data()),
+          off(f.off_count.empty() ? nullptr : f.off_count.data()),
+          ts(f.last_ts.empty() ? nullptr : f.last_ts.data()),
+          stride(size_t(f.width)) {}
+
+    void put(uint16_t x, uint16_t y, int64_t t, bool p) {
+        const size_t i = size_t(y) * stride + x;
+        if (pol) pol[i] = p ? 1 : 2;
+        if (p) {
+            if (on && on[i] != UINT16_MAX) ++on[i];
+        } else {
+            if (off && off[i] != UINT16_MAX) ++off[i];
+        }
+        if (ts) ts[i] = t;
+        ++n;
+    }
+};
+
+/// 子帧是否含事件（任一像素字非 0）。
+inline bool raw8SubframeAny(const uint8_t* p) {
+    const uint8_t* px = p + kRaw8HeaderBytes;
+    for (int i = 0; i < kRaw8Rows * kRaw8WordsPerRow; ++i)
+        if (raw8Load64(px + 8 * i)) return true;
+    return false;
+}
+
+/// 已解析头的子帧累加进 frame（更新统计）。
+inline size_t raw8Accumulate(const uint8_t* p, const Raw8SubHeader& h, EventFrame& frame) {
+    EventFrameSink sink(frame);
+    raw8SubframeScan(p, h, sink);
+    if (sink.n) {
+        if (frame.subframes == 0) frame.t_begin = h.t;
+        frame.t_end = h.t;
+        frame.events += sink.n;
+        ++frame.subframes;
+    }
+    return sink.n;
+}
+
+} // namespace detail
+
+/// 单个子帧累加进 frame（不清空，可用于逐子帧图）。返回事件数；头无效返回 0。
+inline size_t AccumulateSubframe(const uint8_t* subframe, EventFrame& frame) {
+    detail::Raw8SubHeader h;
+    if (subframe == nullptr || !detail::raw8ParseHeader(subframe, h)) return 0;
+    return detail::raw8Accumulate(subframe, h, frame);
+}
+
+/// 整包全部子帧（subframe_count 语义同 MipiRaw8Decoder::Decode）累加进 frame（不清空）。
+/// 返回事件数。
+inline size_t AccumulatePacket(const uint8_t* data, size_t len, EventFrame& frame,
+                               int subframe_count = 0) {
+    if (data == nullptr || len < MipiRaw8Layout::kSubframeBytes) return 0;
+    const size_t count = detail::raw8Subframes(len, subframe_count);
+    size_t n = 0;
+    for (size_t s = 0; s < count; ++s)
+        n += AccumulateSubframe(data + s * MipiRaw8Layout::kSubframeBytes, frame);
+    return n;
+}
+
+/// 逐包喂入、按帧切分：连续 subframes_per_frame 个不同时间戳（仅计有事件的子帧）为一帧，
+/// 第 subframes_per_frame + 1 个新时间戳到来时交出当前帧。跨包保持切分状态。
+class MipiRaw8FrameBuilder {
+public:
+    explicit MipiRaw8FrameBuilder(const EventFrameOptions& opt = {},
+                                  int subframes_per_frame = MipiRaw8Layout::kSubFrameNum)
+        : frame_(opt), per_frame_(subframes_per_frame > 0 ? subframes_per_frame : 1) {}
+
+    /// 处理一个 RAW8 包；每凑满一帧调用一次 on_frame(const EventFrame&)（回调返回后帧被清空）。
+    /// 返回本包事件数。
+    template <class OnFrame>
+    size_t Feed(const uint8_t* data, size_t len, OnFrame&& on_frame, int subframe_count = 0) {
+        if (data == nullptr || len < MipiRaw8Layout::kSubframeBytes) return 0;
+        const size_t count = detail::raw8Subframes(len, subframe_count);
+        size_t n = 0;
+        for (size_t s = 0; s < count; ++s) {
+            const uint8_t* p = data + s * MipiRaw8Layout::kSubframeBytes;
+            detail::Raw8SubHeader h;
+            if (!detail::raw8ParseHeader(p, h) || !detail::raw8SubframeAny(p)) continue;
+            if (!started_) {
+                started_ = true;
+                cur_ts_ = h.t;
+                unique_ = 1;
+            } else if (h.t != cur_ts_) {
+                if (unique_ >= per_frame_) {
+                    on_frame(static_cast<const EventFrame&>(frame_));
+                    frame_.clear();
+                    unique_ = 0;
+                }
+                ++unique_;
+                cur_ts_ = h.t;
+            }
+            n += detail::raw8Accumulate(p, h, frame_);
+        }
+        return n;
+    }
+
+    /// 交出尚未凑满的最后一帧（无事件则不回调）。
+    template <class OnFrame>
+    void Flush(OnFrame&& on_frame) {
+        if (frame_.subframes > 0) on_frame(static_cast<const EventFrame&>(frame_));
+        Reset();
+    }
+
+    void Reset() {
+        frame_.clear();
+        started_ = false;
+        cur_ts_ = 0;
+        unique_ = 0;
+    }
+
+private:
+    EventFrame frame_;
+    int        per_frame_;
+    bool       started_ = false;
+    int64_t    cur_ts_ = 0;
+    int        unique_ = 0;
+};
+
+} // namespace Shimeta::codec
+#endif // SHIMETA_CODEC_MIPI_RAW8_FRAME_H
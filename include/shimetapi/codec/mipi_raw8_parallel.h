@@ -0,0 +1,88 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// apx003 RAW8 子帧并行解码：子帧互相独立，按子帧分派给常驻 worker 池，各 worker 写入
+// 自己的输出区，最后按子帧顺序拼接——输出与 MipiRaw8Decoder::Decode 逐位一致。
+#ifndef SHIMETA_CODEC_MIPI_RAW8_PARALLEL_H
+#define SHIMETA_CODEC_MIPI_RAW8_PARALLEL_H
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <shimetapi/core/event_cd.h>
+#include <shimetapi/codec/mipi_raw8_codec.h>
+#include <shimetapi/codec/detail/fork_join.h>
+#include <shimetapi/codec/detail/mipi_raw8_kernel.h>
+namespace Shimeta::codec {
+
+/// MipiRaw8Decoder 的多线程版本（接口与语义相同：Decode 先清空 out，返回 out.size()）。
+/// 适用于 750/1000fps 档（100/128 子帧/包）单核跟不上的场景。
+/// 同一实例的 Decode 不可并发调用；不同实例互不影响。
+class MipiRaw8ParallelDecoder {
+public:
+    /// workers <= 0 取硬件线程数；workers == 1 退化为调用线程上的顺序解码。
+    explicit MipiRaw8ParallelDecoder(int workers = 0) : pool_(workers), regions_(size_t(pool_.size())) {}
+
+    int workers() const { return pool_.size(); }
+
+    size_t Decode(const uint8_t* data, size_t len, std::vector<EventCD>& out,
+                  int subframe_count = 0) {
+        out.clear();
+        if (data == nullptr || len < MipiRaw8Layout::kSubframeBytes) return 0;
+        const size_t count = detail::raw8Subframes(len, subframe_count);
+        spans_.assign(count, Span{});
+
+        // 阶段 1：动态领取子帧，解码进各 worker 的常驻输出区
+        std::atomic<size_t> next{0};
+        pool_.run([&](int w) {
+            Region& r = regions_[size_t(w)];
+            r.used = 0;
+            for (size_t s; (s = next.fetch_add(1, std::memory_order_relaxed)) < count;) {
+                if (r.buf.size() < r.used + detail::kRaw8MaxSubEvents)
+                    r.buf.resize(std::max(r.buf.size() * 2, r.used + detail::kRaw8MaxSubEvents));
+                detail::EventCDSink sink{r.buf.data() + r.used};
+                detail::raw8Subframe(data + s * MipiRaw8Layout::kSubframeBytes, sink);
+                const size_t n = size_t(sink.cur - (r.buf.data() + r.used));
+                spans_[s] = Span{w, r.used, n, 0};
+                r.used += n;
+            }
+        });
+
+        // 阶段 2：按子帧顺序求输出偏移，各 worker 并行把自己的片段拷到位
+        size_t total = 0;
+        for (auto& sp : spans_) {
+            sp.dst = total;
+            total += sp.count;
+        }
+        out.resize(total);
+        if (total == 0) return 0;
+        EventCD* dst = out.data();
+        pool_.run([&](int w) {
+            const EventCD* src = regions_[size_t(w)].buf.data();
+            for (const auto& sp : spans_)
+                if (sp.worker == w && sp.count)
+                    std::memcpy(dst + sp.dst, src + sp.src, sp.count * sizeof(EventCD));
+        });
+        return out.size();
+    }
+
+    void Reset() {}  // 无状态
+
+private:
+    struct Region {
+        std::vector<EventCD> buf;  ///< 只增不缩，跨包复用
+        size_t used = 0;
+    };
+    struct Span {
+        int    worker = 0;
+        size_t src = 0;    ///< worker 输出区内偏移
+        size_t count = 0;
+        size_t dst = 0;    ///< 最终输出偏移
+    };
+    detail::ForkJoin    pool_;
+    std::vector<Region> regions_;
+    std::vector<Span>   spans_;
+};
+
+} // namespace Shimeta::codec
+#endif // SHIMETA_CODEC_MIPI_RAW8_PARALLEL_H
@@ -0,0 +1,189 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+#ifndef SHIMETA_CORE_EVENT_BATCH_H
+#define SHIMETA_CORE_EVENT_BATCH_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <utility>
+#include <vector>
+#include <shimetapi/core/event_cd.h>
+namespace Shimeta {
+
+/// 事件批（SoA）：x / y / t / polarity 四个独立数组，各自 64 字节（cache line）对齐。
+/// 每事件 13 字节（EventCD 为 24 字节），只读坐标或只读时间戳的下游只触及所需数组，
+/// 便于向量化滤波 / 累加。容量只增不缩，clear() 后复用，稳态无堆分配。
+/// 只读遍历（for (EventCD e : batch)）按值合成 EventCD，不物化 AoS 副本。
+class EventBatch {
+public:
+    static constexpr size_t kAlign = 64;
+
+    EventBatch() = default;
+    explicit EventBatch(size_t capacity) { reserve(capacity); }
+    EventBatch(const EventBatch& o) { *this = o; }
+    EventBatch(EventBatch&& o) noexcept { swap(o); }
+    EventBatch& operator=(const EventBatch& o) {
+        if (this != &o) {
+            clear();
+            reserve(o.size_);
+            copyArrays(o, 0, o.size_, 0);
+            size_ = o.size_;
+        }
+        return *this;
+    }
+    EventBatch& operator=(EventBatch&& o) noexcept {
+        if (this != &o) {
+            release();
+            swap(o);
+        }
+        return *this;
+    }
+    ~EventBatch() { release(); }
+
+    void swap(EventBatch& o) noexcept {
+        std::swap(block_, o.block_);
+        std::swap(x_, o.x_);
+        std::swap(y_, o.y_);
+        std::swap(t_, o.t_);
+        std::swap(p_, o.p_);
+        std::swap(size_, o.size_);
+        std::swap(capacity_, o.capacity_);
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool   empty() const { return size_ == 0; }
+    void   clear() { size_ = 0; }
+
+    /// 保证容量 >= n（保留已有事件）。
+    void reserve(size_t n) {
+        if (n <= capacity_) return;
+        EventBatch grown;
+        grown.allocate(std::max(n, capacity_ + capacity_ / 2));
+        grown.copyArrays(*this, 0, size_, 0);
+        grown.size_ = size_;
+        swap(grown);
+    }
+
+    /// 直接写入 data 数组后提交元素个数（n <= capacity()；[size(), n) 须已由调用方写好）。
+    void set_size(size_t n) { size_ = std::min(n, capacity_); }
+
+    void push_back(uint16_t x, uint16_t y, int64_t t, bool polarity) {
+        if (size_ == capacity_) reserve(size_ + 1);
+        x_[size_] = x;
+        y_[size_] = y;
+        t_[size_] = t;
+        p_[size_] = polarity ? 1 : 0;
+        ++size_;
+    }
+    void push_back(const EventCD& e) { push_back(e.x, e.y, e.t, e.polarity); }
+
+    /// 追加一段 AoS 事件（逐字段拆分）。
+    void append(const EventCD* events, size_t count) {
+        reserve(size_ + count);
+        for (size_t i = 0; i < count; ++i) {
+            x_[size_ + i] = events[i].x;
+            y_[size_ + i] = events[i].y;
+            t_[size_ + i] = events[i].t;
+            p_[size_ + i] = events[i].polarity ? 1 : 0;
+        }
+        size_ += count;
+    }
+
+    EventCD operator[](size_t i) const { return EventCD{x_[i], y_[i], t_[i], p_[i] != 0}; }
+
+    uint16_t*       x() { return x_; }
+    uint16_t*       y() { return y_; }
+    int64_t*        t() { return t_; }
+    uint8_t*        polarity() { return p_; }
+    const uint16_t* x() const { return x_; }
+    const uint16_t* y() const { return y_; }
+    const int64_t*  t() const { return t_; }
+    const uint8_t*  polarity() const { return p_; }
+
+    /// 只读前向迭代器：解引用按值合成 EventCD。
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = EventCD;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = void;
+        using reference         = EventCD;
+        const_iterator(const EventBatch* b, size_t i) : b_(b), i_(i) {}
+        EventCD operator*() const { return (*b_)[i_]; }
+        const_iterator& operator++() { ++i_; return *this; }
+        const_iterator operator++(int) { const_iterator r = *this; ++i_; return r; }
+        bool operator==(const const_iterator& o) const { return i_ == o.i_; }
+        bool operator!=(const const_iterator& o) const { return i_ != o.i_; }
+    private:
+        const EventBatch* b_;
+        size_t            i_;
+    };
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size_); }
+
+    /// 追加到 AoS vector（兼容只接受 std::vector<EventCD> 的既有接口）。
+    void appendTo(std::vector<EventCD>& out) const {
+        const size_t old = out.size();
+        out.resize(old + size_);
+        EventCD* d = out.data() + old;
+        for (size_t i = 0; i < size_; ++i) d[i] = EventCD{x_[i], y_[i], t_[i], p_[i] != 0};
+    }
+
+private:
+    static size_t roundUp(size_t v) { return (v + kAlign - 1) & ~(kAlign - 1); }
+
+    void allocate(size_t cap) {
+        const size_t xb = roundUp(cap * sizeof(uint16_t));
+        const size_t tb = roundUp(cap * sizeof(int64_t));
+        const size_t pb = roundUp(cap);
+        block_ = static_cast<uint8_t*>(::operator new(2 * xb + tb + pb, std::align_val_t(kAlign)));
+        x_ = reinterpret_cast<uint16_t*>(block_);
+        y_ = reinterpret_cast<uint16_t*>(block_ + xb);
+        t_ = reinterpret_cast<int64_t*>(block_ + 2 * xb);
+        p_ = block_ + 2 * xb + tb;
+        capacity_ = cap;
+    }
+
+    void release() {
+        if (block_) ::operator delete(block_, std::align_val_t(kAlign));
+        block_ = nullptr;
+        x_ = y_ = nullptr;
+        t_ = nullptr;
+        p_ = nullptr;
+        size_ = capacity_ = 0;
+    }
+
+    void copyArrays(const EventBatch& o, size_t from, size_t n, size_t to) {
+        if (n == 0) return;
+        std::memcpy(x_ + to, o.x_ + from, n * sizeof(uint16_t));
+        std::memcpy(y_ + to, o.y_ + from, n * sizeof(uint16_t));
+        std::memcpy(t_ + to, o.t_ + from, n * sizeof(int64_t));
+        std::memcpy(p_ + to, o.p_ + from, n);
+    }
+
+    uint8_t*  block_ = nullptr;   ///< 四个数组共用一块对齐分配
+    uint16_t* x_ = nullptr;
+    uint16_t* y_ = nullptr;
+    int64_t*  t_ = nullptr;
+    uint8_t*  p_ = nullptr;       ///< 0 / 1
+    size_t    size_ = 0;
+    size_t    capacity_ = 0;
+};
+
+/// AoS → SoA：用 events 覆盖 out（复用 out 容量）。
+inline void toEventBatch(const std::vector<EventCD>& events, EventBatch& out) {
+    out.clear();
+    out.append(events.data(), events.size());
+}
+
+/// SoA → AoS：用 batch 覆盖 out。
+inline void toEventVector(const EventBatch& batch, std::vector<EventCD>& out) {
+    out.clear();
+    batch.appendTo(out);
+}
+
+} // namespace Shimeta
+#endif // SHIMETA_CORE_EVENT_BATCH_H
@@ -12,7 +12,9 @@ namespace Shimeta {
 
 /// 统一帧。aps/evs 为池内存的只读视图；aps_owner/evs_owner 持有 slab
 /// 引用以保证视图在 Frame 存活期间有效（零拷贝、池托管生命周期）。
-/// 由 FrameDispatcher 构造，用户不应手动修改 owner 字段。
+/// 由 FrameDispatcher 构造，用户不应手动修改 owner 字段。owner 来自 SlabPool
+/// （VirtualCamera / EthernetDevice）时其控制块即在 slab 头内，SlabRef::fromShared
+/// 可取回侵入式句柄。
 struct Frame {
     BufferView    aps{};
     BufferView    evs{};
@@ -32,6 +34,11 @@ struct Frame {
     /// USB 后端 / EVS-only）时 valid=false。字段追加在结构末尾：旧版 .so
     /// 构造的 Frame 经引用传递时本字段保持调用方的零初始化值，向后兼容。
     EvsTimestamp  aps_evs_ts{};
+
+    /// 帧序号（每到一帧 +1，从 1 起），由 VirtualCamera 与 FrameSequencer（hv/frame_sequencer.h）
+    /// 填写；相邻两次取到的帧序号之差 - 1 即其间未取到的帧数。预编译 Camera::GetFrame 不写
+    /// 本字段（保持调用方的值），同 aps_evs_ts 追加在结构末尾。
+    uint64_t      seq{0};
 };
 
 } // namespace Shimeta
@@ -0,0 +1,349 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// 多尺寸档 slab 池：单一尺寸的池只能按最坏情况（最高 evs_fps 档、最大突发）定 slab 大小，
+// 实际包往往小得多。SizeClassPool 按 2 的幂分档（最小档 min_slab，最高档即 max_slab），acquire(bytes)
+// 取能容纳 bytes 的最小档；每档由若干 SlabPool 块按需增长（每块 grow_slabs 个 slab，受每档上限与
+// 全池字节上限约束），映射的内存因此随实际包长与帧尺寸走。reserve 时构造即为最高档（配置的
+// 单包 / 帧上限所在档）映射一块 class_slabs 个 slab（大页 / 预触 / mlock 随之在构造线程上完成），
+// 较小档仍按需增长。
+// 全池耗尽时 acquire(bytes, timeout) 等任一块归还（各块共用一个归还通知）；setLowWatermark 按档
+// 报告可取 slab 数降到水位。header-only。
+#ifndef SHIMETA_CORE_SIZE_CLASS_POOL_H
+#define SHIMETA_CORE_SIZE_CLASS_POOL_H
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+#include <shimetapi/core/slab_pool.h>
+namespace Shimeta {
+
+/// SizeClassPool 参数。
+struct SizeClassPoolOptions {
+    size_t          min_slab    = 4096;   ///< 最小档（向上取 2 的幂）
+    size_t          max_slab    = 0;      ///< 最大请求字节 = 最高档 slab 大小（小于 min_slab 时取 min_slab）
+    size_t          class_slabs = 8;      ///< 每档 slab 上限（增长上限）
+    size_t          grow_slabs  = 2;      ///< 每次增长的 slab 数（一个 SlabPool 块）
+    size_t          max_bytes   = 0;      ///< 全池已分配 slab 字节上限（0 = 不限）
+    /// 构造时为最高档一次映射 class_slabs 个 slab（不超过 max_bytes），较小档按需增长、受 max_bytes
+    /// 余量约束（不够时向最高档借用）。max_bytes = class_slabs × max_slab 时占用与单一尺寸池相同。
+    bool            reserve     = false;
+    SlabPoolOptions memory;               ///< 每块的内存选项（大页 / 预触 / mlock / NUMA）；不足半个大页的块不用大页
+};
+
+/// 一档的统计（自构造 / resetStats 起累计；in_use 为快照）。
+struct SizeClassStats {
+    size_t   slab_size     = 0;
+    size_t   chunks        = 0;   ///< 已增长的块数
+    size_t   capacity      = 0;   ///< 已分配 slab 数（峰值需求按 grow_slabs 取整，只增不减）
+    size_t   in_use        = 0;
+    size_t   high_water    = 0;   ///< 各块 in_use 峰值之和（上界；含借给更小档的 slab）
+    uint64_t requests      = 0;   ///< 落在本档的 acquire 次数
+    uint64_t borrowed      = 0;   ///< 本档取不到、由更大档给出
+    uint64_t exhausted     = 0;   ///< 本档与更大档都取不到（其后等到或失败）
+    uint64_t failed        = 0;   ///< 返回 nullptr（不等待或等待超时）
+    uint64_t waits         = 0;   ///< 进入等待的次数
+    uint64_t wait_ns       = 0;   ///< 累计等待时长
+    uint64_t max_wait_ns   = 0;
+    uint64_t low_watermark = 0;   ///< 本档低水位回调触发次数
+};
+
+/// 多尺寸档 slab 池。acquire 无锁（逐块尝试 SlabPool::acquire），仅在本档全部块耗尽时取
+/// 该档的增长锁建新块；本档已到上限时向更大档借用空闲 slab。slab 生命周期同 SlabPool。
+/// 计数只在本类按档记（各块的 SlabPoolStats 只用其 in_use / high_water）。
+class SizeClassPool {
+public:
+    static constexpr size_t kMaxChunks = 64;   ///< 每档块数上限（grow_slabs 按 class_slabs 自动放大）
+
+    explicit SizeClassPool(const SizeClassPoolOptions& opts) : opts_(opts) {
+        size_t size = 1;
+        while (size < std::max<size_t>(opts_.min_slab, 1)) size <<= 1;
+        opts_.min_slab = size;
+        opts_.max_slab = std::max(opts_.max_slab, size);
+        opts_.grow_slabs = std::max({opts_.grow_slabs, size_t(1), (opts_.class_slabs + kMaxChunks - 1) / kMaxChunks});
+        for (;; size <<= 1) {
+            auto c = std::make_unique<Class>();
+            c->slab_size = std::min(size, opts_.max_slab);
+            classes_.push_back(std::move(c));
+            if (size >= opts_.max_slab) break;
+        }
+        if (opts_.reserve) {
+            Class& top = *classes_.back();
+            size_t n = opts_.class_slabs;
+            if (opts_.max_bytes) n = std::min(n, opts_.max_bytes / top.slab_size);
+            if (n) addChunk(top, n);   // 映射失败则留给增长
+        }
+    }
+    SizeClassPool(const SizeClassPool&) = delete;
+    SizeClassPool& operator=(const SizeClassPool&) = delete;
+
+    /// 取一个至少 bytes 字节的 slab；bytes > max_request() 或全池耗尽返回 nullptr。
+    std::shared_ptr<uint8_t[]> acquire(size_t bytes) { return acquire(bytes, std::chrono::microseconds::zero()); }
+
+    /// 同 acquire(bytes)，但全池耗尽时至多等 timeout 让他线程归还（SlabPool::kWaitForever 为
+    /// 不限时；<= 0 不等待）。等待期间任一档有 slab 归还即重试本档、增长与借用。
+    std::shared_ptr<uint8_t[]> acquire(size_t bytes, std::chrono::microseconds timeout) {
+        return acquireRef(bytes, timeout).shared();
+    }
+
+    /// 同 acquire，返回侵入式句柄（见 SlabRef）；取不到返回空句柄。
+    SlabRef acquireRef(size_t bytes) { return acquireRef(bytes, std::chrono::microseconds::zero()); }
+    SlabRef acquireRef(size_t bytes, std::chrono::microseconds timeout) {
+        if (bytes > opts_.max_slab) return {};
+        const size_t k = classOf(bytes);
+        Class& c = *classes_[k];
+        c.requests.fetch_add(1, std::memory_order_relaxed);
+        SlabRef slab = tryAcquire(k);
+        if (!slab) slab = waitFor(k, timeout);
+        if (low_cb_) checkLow(k, bool(slab));   // 此时不持池内任何锁
+        return slab;
+    }
+
+    /// 低水位回调：某档请求可不等待取到的 slab 数（见 available(k)）降到 slabs 及以下时，在取用线程
+    /// 上调用 cb(该档 slab 大小, 可取数)。各档分别边沿触发：回到 slabs 以上前不再触发；检查在该档
+    /// 每次 acquire 之后进行，不设回调时无开销。cb 在 acquire 返回前、池内各锁释放之后调用，可调用
+    /// 本池的 stats() / available() / acquire()；它推迟该次 acquire 的返回，不应阻塞。
+    /// 须在开始取用前设置；cb 为空则关闭。
+    void setLowWatermark(size_t slabs, std::function<void(size_t slab_size, size_t available)> cb) {
+        low_mark_ = slabs;
+        low_cb_ = std::move(cb);
+        for (const auto& c : classes_) c->low_armed.store(true, std::memory_order_relaxed);
+    }
+
+    /// 落在第 k 档的请求当前可不等待取到的 slab 数：本档空闲 + 本档在 class_slabs / max_bytes 内
+    /// 余下可增长数 + 更大档空闲（可借用）。空闲数按各块全局栈计，同 SlabPool::setLowWatermark，
+    /// 他线程缓存里的不计入。
+    size_t available(size_t k) const {
+        const Class& c = *classes_[k];
+        size_t free = 0, have = 0;
+        const size_t n = c.nchunks.load(std::memory_order_acquire);
+        for (size_t i = 0; i < n; ++i) {
+            free += c.chunks[i]->impl_->globalFree();
+            have += c.chunks[i]->capacity();
+        }
+        size_t grow = n < kMaxChunks && opts_.class_slabs > have ? opts_.class_slabs - have : 0;
+        if (opts_.max_bytes) {
+            const size_t used = std::min(bytes_.load(std::memory_order_relaxed), opts_.max_bytes);
+            grow = std::min(grow, (opts_.max_bytes - used) / c.slab_size);
+        }
+        free += grow;
+        for (size_t j = k + 1; j < classes_.size(); ++j) {
+            const Class& b = *classes_[j];
+            const size_t m = b.nchunks.load(std::memory_order_acquire);
+            for (size_t i = 0; i < m; ++i) free += b.chunks[i]->impl_->globalFree();
+        }
+        return free;
+    }
+
+    size_t max_request() const { return opts_.max_slab; }
+    size_t class_count() const { return classes_.size(); }
+    size_t reserved_bytes() const { return bytes_.load(std::memory_order_relaxed); }   ///< 已分配 slab 字节
+
+    /// 各档统计，按 slab 大小升序。
+    std::vector<SizeClassStats> stats() const {
+        std::vector<SizeClassStats> out;
+        out.reserve(classes_.size());
+        for (const auto& c : classes_) {
+            SizeClassStats s;
+            s.slab_size = c->slab_size;
+            s.chunks = c->nchunks.load(std::memory_order_acquire);
+            for (size_t i = 0; i < s.chunks; ++i) {
+                const SlabPoolStats cs = c->chunks[i]->stats();
+                s.capacity += cs.capacity;
+                s.in_use += cs.in_use;
+                s.high_water += cs.high_water;
+            }
+            s.requests = c->requests.load(std::memory_order_relaxed);
+            s.borrowed = c->borrowed.load(std::memory_order_relaxed);
+            s.exhausted = c->exhausted.load(std::memory_order_relaxed);
+            s.failed = c->failed.load(std::memory_order_relaxed);
+            s.waits = c->waits.load(std::memory_order_relaxed);
+            s.wait_ns = c->wait_ns.load(std::memory_order_relaxed);
+            s.max_wait_ns = c->max_wait_ns.load(std::memory_order_relaxed);
+            s.low_watermark = c->low_events.load(std::memory_order_relaxed);
+            out.push_back(s);
+        }
+        return out;
+    }
+
+    /// 清零各档计数，峰值回到当前占用（已增长的块保留）。
+    void resetStats() {
+        for (const auto& c : classes_) {
+            for (std::atomic<uint64_t>* v : {&c->requests, &c->borrowed, &c->exhausted, &c->failed, &c->waits,
+                                             &c->wait_ns, &c->max_wait_ns, &c->low_events})
+                v->store(0, std::memory_order_relaxed);
+            const size_t n = c->nchunks.load(std::memory_order_acquire);
+            for (size_t i = 0; i < n; ++i) c->chunks[i]->resetStats();
+        }
+    }
+
+    size_t capacity() const { return total(&SizeClassStats::capacity); }   ///< 各档已分配 slab 总数
+    size_t in_use() const { return total(&SizeClassStats::in_use); }
+
+    /// 各块内存选项的合并生效情况：字节与耗时求和，标志为全部块都生效，errno 取首个非零。
+    SlabMemoryReport memory() const {
+        SlabMemoryReport r;
+        r.hugetlb = r.thp_advised = r.prefaulted = r.locked = r.numa_bound = true;
+        const auto first = [](int& dst, int src) {
+            if (!dst) dst = src;
+        };
+        size_t chunks = 0, huge_chunks = 0;
+        for (const auto& c : classes_) {
+            const size_t n = c->nchunks.load(std::memory_order_acquire);
+            for (size_t i = 0; i < n; ++i, ++chunks) {
+                const SlabMemoryReport& m = c->chunks[i]->memory();
+                if (hugeEligible(c->chunks[i]->capacity() * c->slab_size)) {   // 不用大页的小块不参与大页标志
+                    ++huge_chunks;
+                    r.hugetlb &= m.hugetlb;
+                    r.thp_advised &= m.thp_advised;
+                }
+                r.prefaulted &= m.prefaulted;
+                r.locked &= m.locked;
+                r.numa_bound &= m.numa_bound;
+                r.page_size = chunks ? std::min(r.page_size, m.page_size) : m.page_size;
+                r.bytes += m.bytes;
+                r.thp_bytes += m.thp_bytes;
+                r.prefault_us += m.prefault_us;
+                first(r.hugetlb_errno, m.hugetlb_errno);
+                first(r.thp_errno, m.thp_errno);
+                first(r.lock_errno, m.lock_errno);
+                first(r.numa_errno, m.numa_errno);
+            }
+        }
+        if (!huge_chunks) r.hugetlb = r.thp_advised = false;
+        return chunks ? r : SlabMemoryReport{};
+    }
+
+private:
+    struct Class {
+        size_t                                              slab_size = 0;
+        std::mutex                                          grow_m;
+        std::atomic<size_t>                                 nchunks{0};   ///< chunks[0 .. nchunks) 已发布
+        std::array<std::unique_ptr<SlabPool>, kMaxChunks>   chunks;
+        std::atomic<uint64_t>                               requests{0}, borrowed{0}, exhausted{0}, failed{0};
+        std::atomic<uint64_t>                               waits{0}, wait_ns{0}, max_wait_ns{0};
+        std::atomic<bool>                                   low_armed{true};
+        std::atomic<uint64_t>                               low_events{0};
+    };
+
+    size_t classOf(size_t bytes) const {
+        size_t k = 0;
+        for (size_t size = opts_.min_slab; size < bytes && k + 1 < classes_.size(); size <<= 1) ++k;
+        return k;
+    }
+
+    /// 本档 → 增长 → 向更大档借用，均不计耗尽。
+    SlabRef tryAcquire(size_t k) {
+        Class& c = *classes_[k];
+        if (auto slab = take(c)) return slab;
+        if (auto slab = grow(c)) return slab;
+        for (size_t j = k + 1; j < classes_.size(); ++j) {
+            if (auto slab = take(*classes_[j])) {
+                c.borrowed.fetch_add(1, std::memory_order_relaxed);
+                return slab;
+            }
+        }
+        return {};
+    }
+
+    /// 本档与更大档都取不到：计耗尽，timeout > 0 时等任一块归还。
+    SlabRef waitFor(size_t k, std::chrono::microseconds timeout) {
+        Class& c = *classes_[k];
+        c.exhausted.fetch_add(1, std::memory_order_relaxed);
+        SlabRef slab;
+        if (timeout > std::chrono::microseconds::zero()) {
+            std::chrono::steady_clock::time_point deadline;
+            const bool forever = !detail::SlabSignal::deadlineOf(timeout, deadline);
+            const auto t0 = std::chrono::steady_clock::now();
+            signal_->wait([&] { return bool(slab = tryAcquire(k)); }, deadline, forever);
+            const uint64_t ns = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                             std::chrono::steady_clock::now() - t0).count());
+            c.waits.fetch_add(1, std::memory_order_relaxed);
+            c.wait_ns.fetch_add(ns, std::memory_order_relaxed);
+            uint64_t mx = c.max_wait_ns.load(std::memory_order_relaxed);
+            while (ns > mx && !c.max_wait_ns.compare_exchange_weak(mx, ns, std::memory_order_relaxed)) {
+            }
+        }
+        if (!slab) c.failed.fetch_add(1, std::memory_order_relaxed);
+        return slab;
+    }
+
+    /// 第 k 档一次 acquire 之后的水位检查。取到时取用前的可取数为 free + 1：在水位之上即本次
+    /// 越过水位，先重新布防；取不到则取用前后相同。
+    void checkLow(size_t k, bool got) {
+        Class& c = *classes_[k];
+        const size_t free = available(k);
+        if (free + (got ? 1 : 0) > low_mark_) c.low_armed.store(true, std::memory_order_relaxed);
+        if (free <= low_mark_ && c.low_armed.load(std::memory_order_relaxed) &&
+            c.low_armed.exchange(false, std::memory_order_relaxed)) {
+            c.low_events.fetch_add(1, std::memory_order_relaxed);
+            low_cb_(c.slab_size, free);
+        }
+    }
+
+    static SlabRef take(Class& c) {
+        const size_t n = c.nchunks.load(std::memory_order_acquire);
+        for (size_t i = 0; i < n; ++i)
+            if (auto slab = c.chunks[i]->tryAcquire()) return slab;
+        return {};
+    }
+
+    /// 本档耗尽：在上限内新建一块。并发到达的线程在锁内复查，只建一块。
+    SlabRef grow(Class& c) {
+        std::lock_guard<std::mutex> lk(c.grow_m);
+        if (auto slab = take(c)) return slab;
+        const size_t n = c.nchunks.load(std::memory_order_relaxed);
+        size_t have = 0;
+        for (size_t i = 0; i < n; ++i) have += c.chunks[i]->capacity();
+        const size_t add = std::min(opts_.grow_slabs, opts_.class_slabs > have ? opts_.class_slabs - have : 0);
+        if (!add || !addChunk(c, add)) return {};
+        return c.chunks[n]->tryAcquire();
+    }
+
+    /// 新建一块 add 个 slab 并发布（调用方持 grow_m 或在构造中）；超出块数 / 字节上限或映射失败返回 false。
+    bool addChunk(Class& c, size_t add) {
+        const size_t n = c.nchunks.load(std::memory_order_relaxed);
+        if (n == kMaxChunks) return false;
+        const size_t bytes = add * c.slab_size;
+        size_t cur = bytes_.load(std::memory_order_relaxed);
+        do {
+            if (opts_.max_bytes && cur + bytes > opts_.max_bytes) return false;
+        } while (!bytes_.compare_exchange_weak(cur, cur + bytes, std::memory_order_relaxed));
+        SlabPoolOptions mem = opts_.memory;
+        if (!hugeEligible(bytes)) mem.hugepages = HugePages::Off;   // 整块按大页取整只会浪费
+        try {
+            c.chunks[n] = std::make_unique<SlabPool>(c.slab_size, add, mem, signal_);
+        } catch (const std::bad_alloc&) {
+            bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+            return false;
+        }
+        c.nchunks.store(n + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// bytes 字节的块是否按 memory.hugepages 用大页：不足半个大页时不用。
+    bool hugeEligible(size_t bytes) const {
+        return opts_.memory.hugepages != HugePages::Off && bytes * 2 >= SlabPool::huge_page_size();
+    }
+
+    size_t total(size_t SizeClassStats::*field) const {
+        size_t n = 0;
+        for (const SizeClassStats& s : stats()) n += s.*field;
+        return n;
+    }
+
+    SizeClassPoolOptions                opts_;
+    std::vector<std::unique_ptr<Class>> classes_;
+    std::atomic<size_t>                 bytes_{0};
+    std::shared_ptr<detail::SlabSignal> signal_ = std::make_shared<detail::SlabSignal>();   ///< 各块共用
+    size_t                              low_mark_ = 0;
+    std::function<void(size_t, size_t)> low_cb_;
+};
+
+} // namespace Shimeta
+#endif // SHIMETA_CORE_SIZE_CLASS_POOL_H
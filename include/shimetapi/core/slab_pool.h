@@ -0,0 +1,760 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// 无锁 slab 池：与 BufferPool 同接口（acquire 返回 shared_ptr<uint8_t[]>，最后一个引用释放时归还）。
+// 预编译 BufferPool 的空闲表在一把锁之后，HAL / 分发 / 用户线程同时取还时互相排队。SlabPool 的
+// 全局空闲表为带 ABA 标签的 Treiber 栈（整串压入 / 弹出各一次 CAS），另有每线程小缓存：取还先走
+// 本线程缓存，空 / 满时与全局栈成批交换半个缓存，采集线程取、消费线程还的跨线程流转因此每
+// cache/2 次取还才碰一次共享状态。slab 内存为一整块匿名映射，可选大页、预触、mlock 与 NUMA 绑定
+// （SlabPoolOptions），实际生效情况经 memory() 读回。池耗尽时 acquire(timeout) 等待归还（归还方仅在
+// 有等待者时才加锁唤醒），并计数耗尽、等待时长与占用峰值（stats()），可选低水位回调。
+// 每个 slab 前有 kHeaderBytes 的头：SlabRef（acquireRef）的引用计数就在其中，取用不另行分配；
+// acquire 返回的 shared_ptr 也把控制块就地放在头内。header-only。
+#ifndef SHIMETA_CORE_SLAB_POOL_H
+#define SHIMETA_CORE_SLAB_POOL_H
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <shimetapi/core/slab_pool_options.h>
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+namespace Shimeta {
+
+/// SlabPool 内存选项的实际生效情况（构造后读回）。
+struct SlabMemoryReport {
+    size_t   bytes        = 0;       ///< 映射字节数（含大页对齐的尾部）
+    size_t   page_size    = 0;       ///< 映射的页大小（MAP_HUGETLB 生效时为大页大小）
+    bool     hugetlb      = false;   ///< MAP_HUGETLB 生效
+    bool     thp_advised  = false;   ///< madvise(MADV_HUGEPAGE) 成功
+    size_t   thp_bytes    = 0;       ///< 已由透明大页承载的字节（/proc/self/smaps AnonHugePages；预触后才有意义）
+    bool     prefaulted   = false;
+    bool     locked       = false;
+    bool     numa_bound   = false;
+    uint64_t prefault_us  = 0;       ///< 预触（含 mlock）耗时
+    int      hugetlb_errno = 0;      ///< MAP_HUGETLB 失败的 errno（如 ENOMEM：未预留大页）
+    int      thp_errno     = 0;
+    int      lock_errno    = 0;      ///< mlock 失败的 errno（如 ENOMEM / EPERM：超出 RLIMIT_MEMLOCK）
+    int      numa_errno    = 0;      ///< mbind 失败的 errno（如 ENOSYS / EINVAL：内核无 NUMA 或节点不存在）
+};
+
+/// SlabPool 的取用统计（自构造 / resetStats 起累计；in_use 为快照）。high_water 即实测所需
+/// slab 数，可据此定 buffer_count。
+struct SlabPoolStats {
+    size_t   capacity      = 0;
+    size_t   in_use        = 0;
+    size_t   high_water    = 0;   ///< 离开全局栈的 slab 数峰值（含各线程缓存中的空闲 slab，为占用的上界）
+    uint64_t exhausted     = 0;   ///< 取用时池已空的次数（其后等到或失败）
+    uint64_t failed        = 0;   ///< 返回 nullptr 的次数（不等待或等待超时）
+    uint64_t waits         = 0;   ///< 进入等待的次数
+    uint64_t wait_ns       = 0;   ///< 累计等待时长
+    uint64_t max_wait_ns   = 0;
+    uint64_t low_watermark = 0;   ///< 低水位回调触发次数
+};
+
+class SizeClassPool;
+class SlabRef;
+
+namespace detail {
+
+/// slab 归还通知。等待方先登记再重试，归还方在入栈后检查登记数：两侧各一道 seq_cst fence
+/// 保证至少一方看见对方（归还经线程缓存时，缓存锁已给出同样的先后，可省去 fence）。无等待者时
+/// 归还只多一次 load。可由多个池共用（SizeClassPool 的各块），等待任一池归还。
+struct SlabSignal {
+    std::mutex              m;
+    std::condition_variable cv;
+    uint64_t                epoch = 0;   ///< 每次唤醒 + 1（m 保护）
+    std::atomic<uint32_t>   waiters{0};
+
+    void notify(bool fence) {
+        if (fence) std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!waiters.load(std::memory_order_relaxed)) return;
+        {
+            std::lock_guard<std::mutex> lk(m);
+            ++epoch;
+        }
+        cv.notify_all();
+    }
+
+    /// 反复调用 attempt 直到其返回 true 或到 deadline（forever 时不限时）。
+    template <class Attempt>
+    bool wait(Attempt&& attempt, std::chrono::steady_clock::time_point deadline, bool forever) {
+        waiters.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool ok = false;
+        for (;;) {
+            uint64_t seen;
+            {
+                std::lock_guard<std::mutex> lk(m);
+                seen = epoch;
+            }
+            if ((ok = attempt())) break;
+            std::unique_lock<std::mutex> lk(m);
+            const auto changed = [&] { return epoch != seen; };
+            if (forever) cv.wait(lk, changed);
+            else if (!cv.wait_until(lk, deadline, changed)) break;
+        }
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+        return ok;
+    }
+
+    /// 超时换算为截止时刻；返回 false 表示不限时。
+    static bool deadlineOf(std::chrono::microseconds timeout, std::chrono::steady_clock::time_point& deadline) {
+        constexpr auto kMax = std::chrono::hours(24 * 365);
+        if (timeout >= kMax) return false;
+        deadline = std::chrono::steady_clock::now() + timeout;
+        return true;
+    }
+};
+
+} // namespace detail
+
+/// 无锁固定大小 slab 池（接口同 BufferPool，可直接替换）。每线程缓存容量为 slab 数 / 8（至少 1，
+/// 上限 kMaxThreadCache），不足 kMinCachedPool 个 slab 的池不启用缓存、只走全局栈。全局栈空时从
+/// 其他线程（含已退出线程）的缓存取回，acquire 只在全池确无空闲 slab 时返回 nullptr。
+/// 内存选项见 SlabPoolOptions；映射失败时抛 std::bad_alloc（同 new）。
+/// 在途 slab 可晚于 SlabPool 析构：池内存在最后一个 slab 归还时释放。
+class SlabPool {
+public:
+    static constexpr size_t kMaxThreadCache = 32;
+    static constexpr size_t kMinCachedPool = 4;   ///< 启用每线程缓存的最小 slab 数
+    static constexpr size_t kSlabAlign = 64;
+    static constexpr size_t kHeaderBytes = 64;   ///< 每个 slab 前的头（计入 memory().bytes）
+    static constexpr std::chrono::microseconds kWaitForever = std::chrono::microseconds::max();
+
+    /// signal：归还通知，缺省为本池独有；多个池共用同一个时可等待其中任一池归还。
+    SlabPool(size_t slab_size, size_t slab_count, const SlabPoolOptions& opts = {},
+             std::shared_ptr<detail::SlabSignal> signal = nullptr)
+        : impl_(new Impl(slab_size, slab_count, opts, std::move(signal))) {}
+    ~SlabPool() { impl_->orphan(); }
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    /// 获取一个 slab（起始地址 kSlabAlign 对齐）；池耗尽返回 nullptr（计入 exhausted / failed）。
+    /// 控制块在 slab 头内，不另行分配；同 acquireRef().shared()。
+    std::shared_ptr<uint8_t[]> acquire() { return acquire(std::chrono::microseconds::zero()); }
+
+    /// 池耗尽时至多等 timeout 让他线程归还（kWaitForever 为不限时；<= 0 同 acquire()）；
+    /// 超时返回 nullptr。
+    std::shared_ptr<uint8_t[]> acquire(std::chrono::microseconds timeout);
+
+    /// 同 acquire()，返回侵入式句柄（见 SlabRef）；池耗尽返回空句柄。
+    SlabRef acquireRef();
+    SlabRef acquireRef(std::chrono::microseconds timeout);
+
+    /// 低水位回调：全局栈的空闲 slab 降到 slabs 及以下时，在取用线程上调用 cb(全局栈空闲数)。
+    /// 边沿触发：回到 slabs 以上前不再触发。检查只在与全局栈成批交换时进行，取还走本线程缓存
+    /// 时无开销；启用缓存的池中，他线程缓存里的空闲 slab 不计入（偏早触发）。
+    /// cb 在 acquire 返回前、池内各锁释放之后调用，可调用本池的 stats() / available() / acquire()；
+    /// 它推迟该次 acquire 的返回，不应阻塞（要做重活请转交他线程）。
+    /// 须在开始取用前设置；cb 为空则关闭。
+    void setLowWatermark(size_t slabs, std::function<void(size_t available)> cb) {
+        impl_->low_mark = slabs;
+        impl_->low_cb = std::move(cb);
+        impl_->low_armed.store(true, std::memory_order_relaxed);
+    }
+
+    size_t slab_size() const { return impl_->slab_size; }
+    size_t capacity() const { return impl_->count; }                 ///< 总 slab 数
+    size_t available() const { return impl_->available(); }          ///< 当前空闲 slab 数（含各线程缓存）
+    size_t thread_cache_size() const { return impl_->cache_cap; }    ///< 每线程缓存容量（0 = 未启用）
+    const SlabMemoryReport& memory() const { return impl_->mem; }   ///< 内存选项的实际生效情况
+
+    /// 默认大页大小（/proc/meminfo Hugepagesize，读不到按 2 MiB；首次调用时读取）。
+    static size_t huge_page_size() {
+        static const size_t size = [] {
+            size_t kb = 0;
+#if defined(__linux__)
+            if (FILE* f = std::fopen("/proc/meminfo", "r")) {
+                char line[128];
+                while (std::fgets(line, sizeof(line), f))
+                    if (std::sscanf(line, "Hugepagesize: %zu kB", &kb) == 1) break;
+                std::fclose(f);
+            }
+#endif
+            return kb ? kb << 10 : size_t(2) << 20;
+        }();
+        return size;
+    }
+    SlabPoolStats stats() const { return impl_->stats(); }
+    /// 清零计数，high_water 回到当前占用。
+    void resetStats() { impl_->resetStats(); }
+
+private:
+    friend class SizeClassPool;
+    friend class SlabRef;
+    struct Impl;
+    static constexpr uint32_t kNil = UINT32_MAX;
+
+    /// 不计耗尽、不等待的 acquireRef()（低水位照常检查）；SizeClassPool 逐块尝试时用，耗尽由其按档计数。
+    SlabRef tryAcquire();
+
+    /// slab 头，取出时就地构造。ctrl 存放 SlabRef::shared() 的 shared_ptr 控制块（libstdc++ 32 字节、
+    /// libc++ 40 字节）；已被占用（同一 slab 多次 shared()）或放不下时改在堆上分配。
+    struct Header {
+        std::atomic<uint32_t> refs;
+        uint32_t              index;
+        Impl*                 pool;
+        std::atomic<uint32_t> ctrl_used;
+        alignas(8) unsigned char ctrl[40];
+
+        Header(Impl* p, uint32_t i) : refs(1), index(i), pool(p), ctrl_used(0) {}
+    };
+    static_assert(sizeof(Header) <= kHeaderBytes, "slab header overflow");
+
+    /// 一个线程在一个池上的缓存。lock 平时只有属主线程获取（无争用），仅在他线程全局栈空
+    /// 取回时才有竞争；n 供 available() 跨线程读取。
+    struct ThreadCache {
+        std::atomic_flag      lock = ATOMIC_FLAG_INIT;
+        std::atomic<uint32_t> n{0};
+        bool                  orphan = false;   ///< 池已析构（属主线程据此清理表项）
+        bool                  dead = false;     ///< 属主线程已退出（池据此回收其 slab）
+        uint32_t              slots[kMaxThreadCache];
+
+        void lockNow() {
+            while (lock.test_and_set(std::memory_order_acquire)) std::this_thread::yield();
+        }
+        void unlock() { lock.clear(std::memory_order_release); }
+    };
+
+    /// 本线程持有的各池缓存（按池 id 查找，最近使用的在前）。线程退出时标记 dead。
+    struct LocalCaches {
+        struct Entry {
+            uint64_t                     id;
+            std::shared_ptr<ThreadCache> cache;
+        };
+        std::vector<Entry> entries;
+
+        ~LocalCaches() {
+            for (Entry& e : entries) {
+                e.cache->lockNow();
+                e.cache->dead = true;
+                e.cache->unlock();
+            }
+        }
+    };
+    static LocalCaches& locals() {
+        thread_local LocalCaches l;
+        return l;
+    }
+
+    struct Impl {
+        Impl(size_t size, size_t n, const SlabPoolOptions& opts, std::shared_ptr<detail::SlabSignal> sig)
+            : slab_size(size),
+              count(std::min<size_t>(n, kNil - 1)),
+              stride((kHeaderBytes + std::max<size_t>(size, 1) + kSlabAlign - 1) / kSlabAlign * kSlabAlign),
+              cache_cap(uint32_t(count >= kMinCachedPool ? std::clamp<size_t>(count / 8, 1, kMaxThreadCache) : 0)),
+              id(nextId()),
+              signal(sig ? std::move(sig) : std::make_shared<detail::SlabSignal>()) {
+            if (count) mapMemory(opts);
+            next = std::make_unique<std::atomic<uint32_t>[]>(count);
+            for (size_t i = 0; i < count; ++i) next[i].store(i + 1 < count ? uint32_t(i + 1) : kNil, std::memory_order_relaxed);
+            head.store(pack(0, count ? 0 : kNil), std::memory_order_relaxed);
+            global_free.store(int64_t(count), std::memory_order_relaxed);
+        }
+        ~Impl() { unmapMemory(); }
+
+        /// 取出下标 i：构造其头（引用计数 1）。
+        Header* header(uint32_t i) { return new (base + size_t(i) * stride) Header(this, i); }
+
+        uint32_t pop() {
+            uint32_t i = kNil;
+            if (ThreadCache* c = cache()) {
+                c->lockNow();
+                uint32_t n = c->n.load(std::memory_order_relaxed);
+                if (!n) n = popGlobal(c->slots, std::max<uint32_t>(cache_cap / 2, 1));
+                if (n) i = c->slots[--n];
+                c->n.store(n, std::memory_order_relaxed);
+                c->unlock();
+            } else if (!popGlobal(&i, 1)) {
+                i = kNil;
+            }
+            return i != kNil ? i : steal();
+        }
+
+        /// slab 归还：入栈，有等待者时唤醒。经线程缓存时全程在缓存锁内：缓存锁与等待方 steal 的
+        /// 加锁构成先后，无需 fence；orphan() 逐个取缓存锁，解锁后即不再碰 Impl。只走全局栈的池
+        /// 需要 fence，计数放在最后。池已析构（缓存停用）时只计数；计数是对 Impl 的最后一次访问，
+        /// 凑满 count + kOrphan 的一方释放 Impl。
+        void release(uint32_t i) {
+            if (ThreadCache* c = cache()) {
+                c->lockNow();
+                if (!c->orphan) {
+                    uint32_t n = c->n.load(std::memory_order_relaxed);
+                    if (n == cache_cap) {   // 满：较早归还的一半交回全局栈，较热的一半留在本线程
+                        const uint32_t half = std::max<uint32_t>(cache_cap / 2, 1);
+                        pushGlobal(c->slots, half);
+                        std::memmove(c->slots, c->slots + half, (n - half) * sizeof(uint32_t));
+                        n -= half;
+                    }
+                    c->slots[n++] = i;
+                    c->n.store(n, std::memory_order_relaxed);
+                    signal->notify(false);
+                    c->unlock();
+                    return;
+                }
+                c->unlock();
+            } else if (!cache_cap) {
+                linkGlobal(&i, 1);
+                signal->notify(true);
+            }
+            if (addFree(1)) delete this;
+        }
+
+        /// SlabPool 析构：各线程缓存中的空闲 slab 并入计数并停用缓存（此后归还不再入栈），再加上
+        /// kOrphan。slab 已全部归还则当即释放 Impl，否则由最后一次归还释放。
+        void orphan() {
+            int64_t cached = 0;
+            {
+                std::lock_guard<std::mutex> lk(reg_m);
+                orphaned = true;
+                for (auto& c : caches) {
+                    c->lockNow();
+                    cached += c->n.load(std::memory_order_relaxed);
+                    c->n.store(0, std::memory_order_relaxed);
+                    c->orphan = true;
+                    c->unlock();
+                }
+            }
+            if (addFree(cached + kOrphan)) delete this;
+        }
+
+        /// 全局栈弹出后剩 free 个：更新峰值，越过低水位时记下待触发（此时持有缓存锁或 reg_m，
+        /// 回调由 fireLow 在锁外调用）。
+        void onGlobalTake(size_t free) {
+            const size_t used = count - std::min(free, count);
+            size_t hw = high_water.load(std::memory_order_relaxed);
+            while (used > hw && !high_water.compare_exchange_weak(hw, used, std::memory_order_relaxed)) {
+            }
+            if (low_cb && free <= low_mark && low_armed.load(std::memory_order_relaxed) &&
+                low_armed.exchange(false, std::memory_order_relaxed)) {
+                low_events.fetch_add(1, std::memory_order_relaxed);
+                low_pending.store(free + 1, std::memory_order_relaxed);
+            }
+        }
+        /// acquire 返回前（锁外）调用待触发的低水位回调。
+        void fireLow() {
+            if (!low_cb || !low_pending.load(std::memory_order_relaxed)) return;
+            if (const size_t v = low_pending.exchange(0, std::memory_order_relaxed)) low_cb(v - 1);
+        }
+
+        /// 池空：计一次耗尽，timeout > 0 时等待归还。返回下标或 kNil。
+        uint32_t waitFor(std::chrono::microseconds timeout) {
+            exhausted.fetch_add(1, std::memory_order_relaxed);
+            uint32_t i = kNil;
+            if (timeout > std::chrono::microseconds::zero()) {
+                std::chrono::steady_clock::time_point deadline;
+                const bool forever = !detail::SlabSignal::deadlineOf(timeout, deadline);
+                const auto t0 = std::chrono::steady_clock::now();
+                signal->wait([&] { return (i = pop()) != kNil; }, deadline, forever);
+                const uint64_t ns = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                 std::chrono::steady_clock::now() - t0).count());
+                waits.fetch_add(1, std::memory_order_relaxed);
+                wait_ns.fetch_add(ns, std::memory_order_relaxed);
+                uint64_t mx = max_wait_ns.load(std::memory_order_relaxed);
+                while (ns > mx && !max_wait_ns.compare_exchange_weak(mx, ns, std::memory_order_relaxed)) {
+                }
+            }
+            if (i == kNil) failed.fetch_add(1, std::memory_order_relaxed);
+            return i;
+        }
+
+        /// 全局栈空闲数。入栈后才计数，并发弹出时可短暂为负，读数截到 [0, count]。
+        size_t globalFree() const {
+            return size_t(std::clamp<int64_t>(global_free.load(std::memory_order_relaxed), 0, int64_t(count)));
+        }
+
+        size_t available() const {
+            size_t n = globalFree();
+            std::lock_guard<std::mutex> lk(reg_m);
+            for (auto& c : caches) n += c->n.load(std::memory_order_relaxed);
+            return std::min(n, count);
+        }
+
+        SlabPoolStats stats() const {
+            SlabPoolStats s;
+            s.capacity = count;
+            s.in_use = count - available();
+            s.high_water = high_water.load(std::memory_order_relaxed);
+            s.exhausted = exhausted.load(std::memory_order_relaxed);
+            s.failed = failed.load(std::memory_order_relaxed);
+            s.waits = waits.load(std::memory_order_relaxed);
+            s.wait_ns = wait_ns.load(std::memory_order_relaxed);
+            s.max_wait_ns = max_wait_ns.load(std::memory_order_relaxed);
+            s.low_watermark = low_events.load(std::memory_order_relaxed);
+            return s;
+        }
+        void resetStats() {
+            for (std::atomic<uint64_t>* c : {&exhausted, &failed, &waits, &wait_ns, &max_wait_ns, &low_events})
+                c->store(0, std::memory_order_relaxed);
+            high_water.store(count - globalFree(), std::memory_order_relaxed);
+        }
+
+        // --- 全局 Treiber 栈：head = (tag << 32) | 栈顶下标，每次成功 CAS tag + 1 防 ABA ---
+        static uint64_t pack(uint32_t tag, uint32_t idx) { return (uint64_t(tag) << 32) | idx; }
+        static uint32_t idxOf(uint64_t h) { return uint32_t(h); }
+        static uint32_t tagOf(uint64_t h) { return uint32_t(h >> 32); }
+
+        /// 弹出至多 max 个（一次 CAS 摘下整串），返回个数 k。栈中节点的 next 只在压入前写，head 的
+        /// tag 未变即说明遍历期间无人取还，所读链路有效。out 只有前 k 个有效：CAS 失败重试前已写入的
+        /// 下标不会清掉，返回 0 时 out[0] 可能是别人已取走的 slab。
+        uint32_t popGlobal(uint32_t* out, uint32_t max) {
+            uint64_t h = head.load(std::memory_order_acquire);
+            for (;;) {
+                uint32_t k = 0, cur = idxOf(h);
+                if (cur == kNil) return 0;
+                while (k < max && cur != kNil) {
+                    out[k++] = cur;
+                    cur = next[cur].load(std::memory_order_relaxed);
+                }
+                if (head.compare_exchange_weak(h, pack(tagOf(h) + 1, cur), std::memory_order_acquire,
+                                               std::memory_order_acquire)) {
+                    onGlobalTake(size_t(std::max<int64_t>(global_free.fetch_sub(k, std::memory_order_relaxed) - k, 0)));
+                    return k;
+                }
+            }
+        }
+        /// 把 in[0 .. n) 链成一串后一次 CAS 压入并计数（池未析构，计数不会凑满）。
+        void pushGlobal(const uint32_t* in, uint32_t n) {
+            linkGlobal(in, n);
+            addFree(n);
+        }
+        /// 只入栈不计数：回到低水位以上时重新启用回调（按入栈前的计数估算）。
+        void linkGlobal(const uint32_t* in, uint32_t n) {
+            for (uint32_t k = 0; k + 1 < n; ++k) next[in[k]].store(in[k + 1], std::memory_order_relaxed);
+            if (!low_armed.load(std::memory_order_relaxed) && globalFree() + n > low_mark)
+                low_armed.store(true, std::memory_order_relaxed);
+            uint64_t h = head.load(std::memory_order_relaxed);
+            do {
+                next[in[n - 1]].store(idxOf(h), std::memory_order_relaxed);
+            } while (!head.compare_exchange_weak(h, pack(tagOf(h) + 1, in[0]), std::memory_order_release,
+                                                 std::memory_order_relaxed));
+        }
+        /// 空闲计数 + n；返回 true 表示池已析构且 slab 全部归还（调用方随即释放 Impl）。
+        /// acq_rel：释放方看见此前各方对 Impl 的全部访问。
+        bool addFree(int64_t n) {
+            return global_free.fetch_add(n, std::memory_order_acq_rel) + n == int64_t(count) + kOrphan;
+        }
+
+        /// 本线程在本池的缓存（首次使用时登记）；未启用缓存返回 nullptr。
+        ThreadCache* cache() {
+            if (!cache_cap) return nullptr;
+            auto& v = locals().entries;
+            for (size_t k = 0; k < v.size(); ++k) {
+                if (v[k].id != id) continue;
+                if (k) std::swap(v[k], v[0]);
+                return v[0].cache.get();
+            }
+            if (v.size() >= 8) {   // 清掉已析构池的表项
+                v.erase(std::remove_if(v.begin(), v.end(), [](auto& e) {
+                            e.cache->lockNow();
+                            const bool gone = e.cache->orphan;
+                            e.cache->unlock();
+                            return gone;
+                        }), v.end());
+            }
+            auto c = std::make_shared<ThreadCache>();
+            {
+                std::lock_guard<std::mutex> lk(reg_m);
+                if (orphaned) return nullptr;   // 池已析构：归还只计数
+                caches.push_back(c);
+            }
+            v.insert(v.begin(), {id, c});
+            return c.get();
+        }
+
+        /// 全局栈空：从各线程缓存取一个；已退出线程的缓存整体交回全局栈并注销。
+        uint32_t steal() {
+            if (!cache_cap) return kNil;   // 无缓存时空闲 slab 全在全局栈
+            std::lock_guard<std::mutex> lk(reg_m);
+            uint32_t i = kNil;
+            if (popGlobal(&i, 1)) return i;
+            i = kNil;
+            for (auto it = caches.begin(); it != caches.end();) {
+                ThreadCache& c = **it;
+                c.lockNow();
+                uint32_t n = c.n.load(std::memory_order_relaxed);
+                if (n && i == kNil) i = c.slots[--n];
+                const bool dead = c.dead;
+                if (dead && n) {
+                    pushGlobal(c.slots, n);
+                    n = 0;
+                }
+                c.n.store(n, std::memory_order_relaxed);
+                c.unlock();
+                it = dead ? caches.erase(it) : it + 1;
+            }
+            return i;
+        }
+
+        // --- slab 内存 ---
+#if defined(__linux__)
+        void mapMemory(const SlabPoolOptions& o) {
+            const size_t bytes = count * stride;
+            const size_t page = size_t(::sysconf(_SC_PAGESIZE));
+            const size_t huge = hugePageSize();
+            mem.page_size = page;
+            if (o.hugepages == HugePages::Explicit) {
+                const size_t len = roundUp(bytes, huge);
+                void* p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if (p != MAP_FAILED) {
+                    map = p;
+                    map_len = len;
+                    base = static_cast<uint8_t*>(p);
+                    mem.bytes = len;
+                    mem.page_size = huge;
+                    mem.hugetlb = true;
+                } else {
+                    mem.hugetlb_errno = errno;
+                }
+            }
+            if (!map) {
+                // 透明大页要求大页对齐：多映射一个大页，从对齐处起用
+                const bool thp = o.hugepages != HugePages::Off;
+                const size_t len = thp ? roundUp(bytes, huge) : roundUp(bytes, page);
+                map_len = len + (thp ? huge : 0);
+                map = ::mmap(nullptr, map_len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (map == MAP_FAILED) {
+                    map = nullptr;
+                    throw std::bad_alloc();
+                }
+                base = reinterpret_cast<uint8_t*>(roundUp(reinterpret_cast<uintptr_t>(map), thp ? huge : page));
+                mem.bytes = len;
+                if (thp) {
+                    if (::madvise(base, len, MADV_HUGEPAGE) == 0) mem.thp_advised = true;
+                    else mem.thp_errno = errno;
+                }
+            }
+            if (o.numa_node >= 0) {
+                constexpr unsigned long kMpolBind = 2, kMpolMfMove = 1u << 1;
+                unsigned long mask[16] = {};
+                constexpr size_t kBits = sizeof(mask) * 8;
+                if (size_t(o.numa_node) < kBits - 1) {
+                    mask[size_t(o.numa_node) / 64] = 1ul << (size_t(o.numa_node) % 64);
+                    if (::syscall(SYS_mbind, base, mem.bytes, kMpolBind, mask, kBits, kMpolMfMove) == 0) mem.numa_bound = true;
+                    else mem.numa_errno = errno;
+                } else {
+                    mem.numa_errno = EINVAL;
+                }
+            }
+            const auto t0 = std::chrono::steady_clock::now();
+            if (o.prefault) {
+                for (size_t off = 0; off < mem.bytes; off += mem.page_size) base[off] = 0;
+                mem.prefaulted = true;
+            }
+            if (o.lock) {
+                if (::mlock(base, mem.bytes) == 0) mem.locked = true;
+                else mem.lock_errno = errno;
+            }
+            mem.prefault_us = uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(
+                                           std::chrono::steady_clock::now() - t0).count());
+            if (mem.thp_advised) mem.thp_bytes = std::min(anonHugeBytes(base), mem.bytes);
+        }
+        void unmapMemory() {
+            if (map) ::munmap(map, map_len);
+        }
+
+        static size_t roundUp(size_t v, size_t a) { return (v + a - 1) / a * a; }
+        static size_t hugePageSize() { return huge_page_size(); }
+        /// addr 所在映射的 AnonHugePages（/proc/self/smaps）。
+        static size_t anonHugeBytes(const void* addr) {
+            FILE* f = std::fopen("/proc/self/smaps", "r");
+            if (!f) return 0;
+            const uintptr_t a = reinterpret_cast<uintptr_t>(addr);
+            char line[512];
+            bool in = false;
+            size_t kb = 0;
+            while (std::fgets(line, sizeof(line), f)) {
+                unsigned long lo = 0, hi = 0;
+                if (std::sscanf(line, "%lx-%lx ", &lo, &hi) == 2) {   // 映射头行
+                    if (in) break;
+                    in = a >= lo && a < hi;
+                } else if (in && std::sscanf(line, "AnonHugePages: %zu kB", &kb) == 1) {
+                    break;
+                }
+            }
+            std::fclose(f);
+            return kb << 10;
+        }
+#else
+        void mapMemory(const SlabPoolOptions&) {
+            base = static_cast<uint8_t*>(::operator new(count * stride, std::align_val_t(kSlabAlign)));
+            mem.bytes = count * stride;
+        }
+        void unmapMemory() {
+            if (base) ::operator delete(base, std::align_val_t(kSlabAlign));
+        }
+#endif
+
+        static constexpr int64_t kOrphan = int64_t(1) << 40;   ///< orphan() 加到 global_free 上的标记（count < 2^32）
+
+        static uint64_t nextId() {
+            static std::atomic<uint64_t> ids{0};
+            return ids.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        const size_t                             slab_size, count, stride;
+        const uint32_t                           cache_cap;
+        const uint64_t                           id;   ///< 进程内唯一，不复用（线程缓存表以此为键）
+        uint8_t*                                 base = nullptr;
+        void*                                    map = nullptr;   ///< 原始映射（base 可能在其中对齐后偏移）
+        size_t                                   map_len = 0;
+        SlabMemoryReport                         mem;
+        std::unique_ptr<std::atomic<uint32_t>[]> next;
+        alignas(64) std::atomic<uint64_t>        head{0};
+        std::atomic<int64_t>                     global_free{0};   ///< 全局栈空闲数；析构后另加 kOrphan
+        alignas(64) mutable std::mutex           reg_m;
+        std::vector<std::shared_ptr<ThreadCache>> caches;
+        bool                                     orphaned = false;   ///< SlabPool 已析构（reg_m 保护）
+        // 以下只在与全局栈交换或池空时读写，本线程缓存命中的取还不碰
+        alignas(64) std::atomic<size_t>          high_water{0};
+        std::atomic<bool>                        low_armed{true};
+        size_t                                   low_mark = 0;
+        std::function<void(size_t)>              low_cb;
+        std::atomic<size_t>                      low_pending{0};   ///< 待触发：全局栈空闲数 + 1（0 = 无）
+        std::atomic<uint64_t>                    exhausted{0}, failed{0}, waits{0}, wait_ns{0}, max_wait_ns{0};
+        std::atomic<uint64_t>                    low_events{0};
+        std::shared_ptr<detail::SlabSignal>      signal;
+    };
+
+    Impl* impl_;
+};
+
+/// 侵入式 slab 句柄（SlabPool::acquireRef）：引用计数在 slab 头内，取用不另行分配。拷贝为一次
+/// 原子加；独占（计数为 1）时释放直接归还、不做原子读改写，单一属主的取用—填充—释放因此没有
+/// 引用计数开销。shared() 转为 shared_ptr<uint8_t[]> 供既有接口（Frame::evs_owner 等），控制块就地
+/// 放在 slab 头内；fromShared 从这样的 shared_ptr 取回句柄。
+class SlabRef {
+public:
+    SlabRef() = default;
+    SlabRef(const SlabRef& o) noexcept : h_(o.h_) {
+        if (h_) h_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    SlabRef(SlabRef&& o) noexcept : h_(std::exchange(o.h_, nullptr)) {}
+    SlabRef& operator=(SlabRef o) noexcept {
+        std::swap(h_, o.h_);
+        return *this;
+    }
+    ~SlabRef() { reset(); }
+
+    uint8_t* get() const { return h_ ? reinterpret_cast<uint8_t*>(h_) + SlabPool::kHeaderBytes : nullptr; }
+    uint8_t& operator[](size_t i) const { return get()[i]; }
+    size_t size() const { return h_ ? h_->pool->slab_size : 0; }   ///< slab 字节数
+    explicit operator bool() const { return h_ != nullptr; }
+    /// 句柄数（并发时为近似值）；由 shared() 转出的 shared_ptr 不论多少份合计为 1。
+    uint32_t use_count() const { return h_ ? h_->refs.load(std::memory_order_relaxed) : 0; }
+    void reset() {
+        if (h_) drop(std::exchange(h_, nullptr));
+    }
+
+    /// 兼容既有 shared_ptr 接口：本句柄保留，shared_ptr 另持一个引用。
+    std::shared_ptr<uint8_t[]> shared() const& {
+        if (!h_) return nullptr;
+        h_->refs.fetch_add(1, std::memory_order_relaxed);
+        return makeShared(h_);
+    }
+    /// 同上，引用转给 shared_ptr（计数不变），本句柄置空。
+    std::shared_ptr<uint8_t[]> shared() && {
+        if (!h_) return nullptr;
+        return makeShared(std::exchange(h_, nullptr));
+    }
+
+    /// p 由 shared() / SlabPool::acquire 得到时返回其 slab 的句柄，否则返回空句柄。
+    /// p 须指向 slab 起始（不适用于别名构造的 shared_ptr）。
+    static SlabRef fromShared(const std::shared_ptr<uint8_t[]>& p) {
+        if (!p || !std::get_deleter<SharedDeleter>(p)) return {};
+        auto* h = reinterpret_cast<SlabPool::Header*>(p.get() - SlabPool::kHeaderBytes);
+        h->refs.fetch_add(1, std::memory_order_relaxed);
+        return SlabRef(h);
+    }
+
+private:
+    friend class SlabPool;
+    using Header = SlabPool::Header;
+
+    explicit SlabRef(Header* h) : h_(h) {}
+
+    /// 放掉一个引用，最后一个归还 slab。独占时无人能并发增减计数，读到 1 即归还。
+    static void drop(Header* h) {
+        if (h->refs.load(std::memory_order_acquire) == 1 || h->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            h->pool->release(h->index);
+    }
+
+    /// shared_ptr 的删除器不做事：slab 在控制块释放（HeaderAlloc::deallocate）时才放掉，
+    /// 此后不再碰 slab 头。
+    struct SharedDeleter {
+        void operator()(uint8_t*) const {}
+    };
+    /// 把控制块放进 slab 头的分配器。
+    template <class T>
+    struct HeaderAlloc {
+        using value_type = T;
+        Header* h;
+
+        explicit HeaderAlloc(Header* hdr) : h(hdr) {}
+        template <class U>
+        HeaderAlloc(const HeaderAlloc<U>& o) : h(o.h) {}
+
+        T* allocate(size_t n) {
+            if (n * sizeof(T) <= sizeof(h->ctrl) && alignof(T) <= alignof(Header) &&
+                !h->ctrl_used.exchange(1, std::memory_order_acquire))
+                return reinterpret_cast<T*>(h->ctrl);
+            return std::allocator<T>().allocate(n);
+        }
+        void deallocate(T* p, size_t n) {
+            Header* hdr = h;
+            if (reinterpret_cast<unsigned char*>(p) == hdr->ctrl) hdr->ctrl_used.store(0, std::memory_order_release);
+            else std::allocator<T>().deallocate(p, n);
+            drop(hdr);
+        }
+        template <class U>
+        bool operator==(const HeaderAlloc<U>& o) const { return h == o.h; }
+        template <class U>
+        bool operator!=(const HeaderAlloc<U>& o) const { return h != o.h; }
+    };
+
+    /// 接管 h 的一个引用。
+    static std::shared_ptr<uint8_t[]> makeShared(Header* h) {
+        try {
+            return std::shared_ptr<uint8_t[]>(reinterpret_cast<uint8_t*>(h) + SlabPool::kHeaderBytes, SharedDeleter{},
+                                              HeaderAlloc<uint8_t>(h));
+        } catch (...) {
+            drop(h);
+            throw;
+        }
+    }
+
+    Header* h_ = nullptr;
+};
+
+inline std::shared_ptr<uint8_t[]> SlabPool::acquire(std::chrono::microseconds timeout) {
+    return acquireRef(timeout).shared();
+}
+inline SlabRef SlabPool::acquireRef() { return acquireRef(std::chrono::microseconds::zero()); }
+inline SlabRef SlabPool::acquireRef(std::chrono::microseconds timeout) {
+    uint32_t i = impl_->pop();
+    if (i == kNil) i = impl_->waitFor(timeout);
+    impl_->fireLow();
+    return i == kNil ? SlabRef() : SlabRef(impl_->header(i));
+}
+inline SlabRef SlabPool::tryAcquire() {
+    const uint32_t i = impl_->pop();
+    impl_->fireLow();
+    return i == kNil ? SlabRef() : SlabRef(impl_->header(i));
+}
+
+} // namespace Shimeta
+#endif // SHIMETA_CORE_SLAB_POOL_H
@@ -0,0 +1,24 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// SlabPool / SizeClassPool 的内存选项。单独成头：DeviceConfig 只需这几个类型，不必引入池本身。
+#ifndef SHIMETA_CORE_SLAB_POOL_OPTIONS_H
+#define SHIMETA_CORE_SLAB_POOL_OPTIONS_H
+#include <cstdint>
+namespace Shimeta {
+
+/// slab 内存的大页方式。
+enum class HugePages : uint8_t {
+    Off,           ///< 普通页
+    Transparent,   ///< 透明大页：按大页对齐映射并 madvise(MADV_HUGEPAGE)（THP 为 never 时无效）
+    Explicit,      ///< MAP_HUGETLB（需预留 vm.nr_hugepages）；失败时回落到 Transparent
+};
+
+/// SlabPool 的内存选项。各项失败不致命：记下 errno，池以普通内存继续可用。
+struct SlabPoolOptions {
+    HugePages hugepages = HugePages::Off;
+    bool      prefault  = false;   ///< 构造时逐页写触，StartStream 后首次取用不再缺页
+    bool      lock      = false;   ///< mlock 常驻（受 RLIMIT_MEMLOCK 限制，或需 CAP_IPC_LOCK）
+    int       numa_node = -1;      ///< >= 0：mbind(MPOL_BIND) 到该节点（在预触之前）
+};
+
+} // namespace Shimeta
+#endif // SHIMETA_CORE_SLAB_POOL_OPTIONS_H
@@ -0,0 +1,324 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// 回调执行器：相机的帧 / 事件 / 图像回调都在同一个派发线程串行触发，一个慢的事件回调会推迟
+// APS 与其后的一切。CallbackExecutor 接管相机回调，按类型分到三条通道（Frame / Event / Image），
+// 每条通道是一个有界队列 + strand（同一通道内严格按到达顺序、一次只执行一个），队列深度与满时
+// 策略按通道设置，通道之间在线程池（或用户提供的执行器）上并发执行；并统计各通道排队深度与回调
+// 耗时。header-only。
+#ifndef SHIMETA_HV_CALLBACK_EXECUTOR_H
+#define SHIMETA_HV_CALLBACK_EXECUTOR_H
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <shimetapi/core/frame.h>
+#include <shimetapi/core/slab_pool.h>
+#include <shimetapi/hv/camera.h>
+#include <shimetapi/hv/detail/frame_copy.h>
+#include <shimetapi/hv/detail/worker_pool.h>
+#include <shimetapi/hv/device_config.h>
+namespace Shimeta::hv {
+
+enum class CallbackLane { Frame, Event, Image };
+
+/// 一条通道的队列参数。
+struct LaneOptions {
+    size_t                    depth  = 8;                                   ///< 队列容量
+    DeviceConfig::QueuePolicy policy = DeviceConfig::QueuePolicy::Block;   ///< 队满时
+};
+
+/// 执行器参数。
+struct ExecutorOptions {
+    size_t                     threads = 3;   ///< 内置线程池线程数（设了 executor 时忽略）
+    /// 各通道的深度与满时策略，按 CallbackLane 下标（Frame / Event / Image）。例如 Image 保持
+    /// Block 不丢 APS 帧、Event 用 DropOldest 让慢事件回调只丢旧包而不阻塞派发线程。
+    std::array<LaneOptions, 3> lanes;
+    /// 用户提供的执行器（非空时不建线程池）：接受一个任务并在任意线程上执行它。通道顺序由
+    /// strand 保证，执行器本身无需有序；须在 CallbackExecutor::Close 返回前执行完已接受的任务。
+    std::function<void(std::function<void()>)> executor;
+
+    LaneOptions&       lane(CallbackLane l) { return lanes[size_t(l)]; }
+    const LaneOptions& lane(CallbackLane l) const { return lanes[size_t(l)]; }
+};
+
+/// 一条通道的统计（自 Attach 起累计）。
+struct CallbackStats {
+    uint64_t posted         = 0;   ///< 派发线程交来的回调数
+    uint64_t executed       = 0;   ///< 已执行
+    uint64_t dropped        = 0;   ///< DropOldest 通道满时丢弃
+    uint64_t copied_bytes   = 0;   ///< Event / Image 通道拷出的载荷字节（见 CallbackExecutor）
+    uint64_t heap_fallbacks = 0;   ///< 任务槽或载荷 slab 耗尽、改在堆上分配的次数（正常为 0）
+    size_t   pending        = 0;   ///< 当前排队
+    size_t   max_pending    = 0;   ///< 排队峰值
+    uint64_t busy_ns        = 0;   ///< 回调累计耗时
+    uint64_t max_ns         = 0;   ///< 单次回调最长耗时
+
+    double meanMs() const { return executed ? double(busy_ns) / double(executed) / 1e6 : 0.0; }
+};
+
+/// 回调执行器。Frame 通道零拷贝（Frame 持有 slab 引用）；EventPacket / ImageData 不带 owner，
+/// 其视图只在相机回调期间有效，Event / Image 通道因此把载荷拷入执行器自有的 SlabPool
+/// （每通道 depth + 2 个 slab，按最大包长增长），计入 copied_bytes。
+/// 每次投递的任务（回调指针 + Frame / 包头 + 载荷引用）连同其 shared_ptr 控制块放在通道的任务槽
+/// SlabPool 里复用，回调本身在包装时放进 shared_ptr、投递只加一次引用计数：稳态下投递不做堆分配。
+/// 用法：构造 → Attach（StartStream 前）→ 相机 StopStream → Close（或析构）。
+class CallbackExecutor {
+public:
+    using FrameCallback = Camera::FrameCallback;
+    using EventCallback = Camera::EventCallback;
+    using ImageCallback = Camera::ImageCallback;
+
+    explicit CallbackExecutor(ExecutorOptions opts = {}) : opts_(std::move(opts)) {
+        for (size_t i = 0; i < lanes_.size(); ++i) {
+            lanes_[i].cap = std::max<size_t>(opts_.lanes[i].depth, 1);
+            lanes_[i].policy = opts_.lanes[i].policy;
+        }
+        if (!opts_.executor) {
+            pool_ = std::make_unique<detail::WorkerPool>(opts_.threads);
+            opts_.executor = [p = pool_.get()](std::function<void()> t) { p->submit(std::move(t)); };
+        }
+    }
+    ~CallbackExecutor() { Close(); }
+    CallbackExecutor(const CallbackExecutor&) = delete;
+    CallbackExecutor& operator=(const CallbackExecutor&) = delete;
+
+    /// 接管 cam 的回调（StartStream 之前）；只设置非空的回调，其余保持未设。
+    /// Cam 为 Camera 或 VirtualCamera。
+    template <class Cam>
+    void Attach(Cam& cam, FrameCallback frame_cb, EventCallback event_cb = nullptr,
+                ImageCallback image_cb = nullptr) {
+        if (frame_cb) cam.SetFrameCallback(WrapFrame(std::move(frame_cb)));
+        if (event_cb) cam.SetEventCallback(WrapEvent(std::move(event_cb)));
+        if (image_cb) cam.SetImageCallback(WrapImage(std::move(image_cb)));
+    }
+
+    /// 单独包装一个回调（自行注册到相机时用）。
+    FrameCallback WrapFrame(FrameCallback cb) {
+        return [this, fn = std::make_shared<const FrameCallback>(std::move(cb))](const Frame& f) {
+            Lane& l = lane(CallbackLane::Frame);
+            auto job = makeJob(l, fn);
+            detail::copyFrame(job->arg, f);
+            post(CallbackLane::Frame, std::move(job));
+        };
+    }
+    EventCallback WrapEvent(EventCallback cb) {
+        return [this, fn = std::make_shared<const EventCallback>(std::move(cb))](const EventPacket& pkt) {
+            Lane& l = lane(CallbackLane::Event);
+            auto job = makeJob(l, fn);
+            job->arg = pkt;
+            job->slab = l.copyIn(pkt.data, job->arg.data);
+            post(CallbackLane::Event, std::move(job));
+        };
+    }
+    ImageCallback WrapImage(ImageCallback cb) {
+        return [this, fn = std::make_shared<const ImageCallback>(std::move(cb))](const ImageData& img) {
+            Lane& l = lane(CallbackLane::Image);
+            auto job = makeJob(l, fn);
+            job->arg = img;
+            job->slab = l.copyIn(img.pixels, job->arg.pixels);
+            post(CallbackLane::Image, std::move(job));
+        };
+    }
+
+    /// 停止接收新回调；drain 为 true 时等各通道排队回调执行完，否则丢弃排队回调
+    /// （正在执行的回调总会执行完）。之后包装出的回调直接返回。
+    void Close(bool drain = true) {
+        for (Lane& l : lanes_) l.close(drain);
+        if (pool_) pool_->close();
+    }
+
+    CallbackStats Stats(CallbackLane which) const { return lane(which).stats(); }
+
+private:
+    /// 一次投递：执行时以 arg 调用回调。
+    struct Task {
+        virtual ~Task() = default;
+        virtual void run() const = 0;
+    };
+    using TaskPtr = std::shared_ptr<const Task>;
+
+    template <class Arg>
+    struct Job final : Task {
+        using Callback = std::function<void(const Arg&)>;
+
+        explicit Job(std::shared_ptr<const Callback> f) : fn(std::move(f)) {}
+        void run() const override { (*fn)(arg); }
+
+        std::shared_ptr<const Callback> fn;
+        Arg                             arg{};
+        std::shared_ptr<uint8_t[]>      slab;   ///< Event / Image 载荷拷贝
+    };
+
+    /// 一条通道：有界队列 + strand。scheduled 为真时已有一个 drain 任务在执行器中，
+    /// 新到的回调只入队，由该任务依序执行。
+    struct Lane {
+        mutable std::mutex          m;
+        std::condition_variable     not_full, idle;
+        std::deque<TaskPtr>         q;
+        bool                        scheduled = false, closed = false;
+        CallbackStats               st;
+        size_t                      cap = 1;
+        DeviceConfig::QueuePolicy   policy = DeviceConfig::QueuePolicy::Block;
+        std::unique_ptr<SlabPool>   copy_pool;   ///< 仅派发线程访问
+        std::unique_ptr<SlabPool>   job_pool;    ///< 任务槽（JobAlloc），仅派发线程访问
+
+        /// 把 src 拷入本通道的 slab，dst 指向拷贝；池耗尽时临时分配（不应发生，见类注释）。
+        std::shared_ptr<uint8_t[]> copyIn(const BufferView& src, BufferView& dst) {
+            if (!src.data || !src.size) return nullptr;
+            if (!copy_pool || copy_pool->slab_size() < src.size) {
+                const size_t want = std::max(src.size, copy_pool ? copy_pool->slab_size() * 2 : size_t(64) << 10);
+                copy_pool = std::make_unique<SlabPool>(want, cap + 2);   // 旧池的在途 slab 随引用释放
+            }
+            std::shared_ptr<uint8_t[]> slab = copy_pool->acquire();
+            const bool heap = !slab;
+            if (heap) slab = std::shared_ptr<uint8_t[]>(new uint8_t[src.size]);
+            std::memcpy(slab.get(), src.data, src.size);
+            dst = BufferView{slab.get(), src.size};
+            {
+                std::lock_guard<std::mutex> lk(m);
+                st.copied_bytes += src.size;
+                st.heap_fallbacks += heap;
+            }
+            return slab;
+        }
+        void countFallback() {
+            std::lock_guard<std::mutex> lk(m);
+            ++st.heap_fallbacks;
+        }
+
+        void close(bool drain) {
+            std::unique_lock<std::mutex> lk(m);
+            closed = true;
+            if (!drain) q.clear();
+            not_full.notify_all();
+            idle.wait(lk, [&] { return !scheduled; });
+        }
+
+        CallbackStats stats() const {
+            std::lock_guard<std::mutex> lk(m);
+            CallbackStats s = st;
+            s.pending = q.size();
+            return s;
+        }
+    };
+
+    /// allocate_shared 的分配器：控制块连同 Job 放进通道 job_pool 的一个 slab（首次分配时按块长
+    /// 建池，通道 depth + 2 个，即排队满 + 执行中 + 正在投递），slab 末尾存其 SlabRef，最后一个
+    /// 引用释放时归还。池耗尽时退回堆，计入 heap_fallbacks。
+    template <class T>
+    struct JobAlloc {
+        using value_type = T;
+        static constexpr size_t kRefAt = (sizeof(T) + alignof(SlabRef) - 1) / alignof(SlabRef) * alignof(SlabRef);
+        static constexpr size_t kBlock = kRefAt + sizeof(SlabRef);
+        static_assert(alignof(T) <= SlabPool::kSlabAlign, "job over-aligned for slab");
+
+        Lane* lane;
+
+        explicit JobAlloc(Lane* l) : lane(l) {}
+        template <class U>
+        JobAlloc(const JobAlloc<U>& o) : lane(o.lane) {}
+
+        T* allocate(size_t n) {
+            if (n == 1) {
+                if (!lane->job_pool) lane->job_pool = std::make_unique<SlabPool>(kBlock, lane->cap + 2);
+                if (lane->job_pool->slab_size() >= kBlock) {
+                    if (SlabRef r = lane->job_pool->acquireRef()) {
+                        uint8_t* p = r.get();
+                        new (p + kRefAt) SlabRef(std::move(r));   // slab 持有自身，deallocate 时取出
+                        return reinterpret_cast<T*>(p);
+                    }
+                }
+            }
+            lane->countFallback();
+            uint8_t* p = static_cast<uint8_t*>(::operator new(kRefAt * n + sizeof(SlabRef)));
+            new (p + kRefAt * n) SlabRef();
+            return reinterpret_cast<T*>(p);
+        }
+        void deallocate(T* p, size_t n) {
+            SlabRef& at = *reinterpret_cast<SlabRef*>(reinterpret_cast<uint8_t*>(p) + kRefAt * n);
+            SlabRef r = std::move(at);
+            at.~SlabRef();
+            if (!r) ::operator delete(p);
+            // 否则 r 析构时归还 slab（p 在其中，此后不再访问）
+        }
+        template <class U>
+        bool operator==(const JobAlloc<U>& o) const { return lane == o.lane; }
+        template <class U>
+        bool operator!=(const JobAlloc<U>& o) const { return lane != o.lane; }
+    };
+
+    template <class Arg>
+    static std::shared_ptr<Job<Arg>> makeJob(Lane& l, const std::shared_ptr<const std::function<void(const Arg&)>>& fn) {
+        return std::allocate_shared<Job<Arg>>(JobAlloc<Job<Arg>>(&l), fn);
+    }
+
+    Lane& lane(CallbackLane which) { return lanes_[size_t(which)]; }
+    const Lane& lane(CallbackLane which) const { return lanes_[size_t(which)]; }
+
+    /// 派发线程调用：入队（按本通道 policy），必要时向执行器提交 drain 任务。
+    void post(CallbackLane which, TaskPtr task) {
+        Lane& l = lane(which);
+        std::unique_lock<std::mutex> lk(l.m);
+        if (l.closed) return;
+        if (l.policy == DeviceConfig::QueuePolicy::Block) {
+            l.not_full.wait(lk, [&] { return l.closed || l.q.size() < l.cap; });
+            if (l.closed) return;
+        } else if (l.q.size() >= l.cap) {
+            l.q.pop_front();
+            ++l.st.dropped;
+        }
+        l.q.push_back(std::move(task));
+        ++l.st.posted;
+        l.st.max_pending = std::max(l.st.max_pending, l.q.size());
+        if (l.scheduled) return;
+        l.scheduled = true;
+        lk.unlock();
+        opts_.executor([this, &l] { drain(l); });
+    }
+
+    /// 在执行器线程上依序执行本通道的回调；每次至多 kBatch 个后让出线程（重新提交），
+    /// 线程数少于通道数时各通道轮流前进。
+    void drain(Lane& l) {
+        using Clock = std::chrono::steady_clock;
+        for (int n = 0; n < kBatch; ++n) {
+            TaskPtr task;
+            {
+                std::lock_guard<std::mutex> lk(l.m);
+                if (l.q.empty()) {
+                    l.scheduled = false;
+                    l.idle.notify_all();
+                    return;
+                }
+                task = std::move(l.q.front());
+                l.q.pop_front();
+            }
+            l.not_full.notify_one();
+            const auto t0 = Clock::now();
+            task->run();
+            task.reset();   // 回调返回即释放 slab 与任务槽
+            const uint64_t ns = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count());
+            std::lock_guard<std::mutex> lk(l.m);
+            ++l.st.executed;
+            l.st.busy_ns += ns;
+            l.st.max_ns = std::max(l.st.max_ns, ns);
+        }
+        opts_.executor([this, &l] { drain(l); });
+    }
+
+    static constexpr int kBatch = 16;
+
+    ExecutorOptions                     opts_;
+    std::unique_ptr<detail::WorkerPool> pool_;
+    std::array<Lane, 3>                 lanes_;
+};
+
+} // namespace Shimeta::hv
+#endif // SHIMETA_HV_CALLBACK_EXECUTOR_H
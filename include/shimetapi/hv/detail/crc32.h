@@ -0,0 +1,201 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// 以太网包校验用的 CRC-32（IEEE 802.3，反射多项式 0xEDB88320）各实现与运行时分派。
+// 均以取反后的内部状态工作：state 初值 0xFFFFFFFF，结果取反即 CRC。
+//   bytewise  : 逐字节查表（参照实现，交叉校验用）
+//   slice8/16 : 每次 8 / 16 字节、8 / 16 张表（无硬件加速时的默认）
+//   pclmul    : x86_64 PCLMULQDQ 折叠（SSE4.2 的 crc32 指令算的是 CRC32C，多项式不同，不适用）
+//   armv8     : ARMv8 CRC32 扩展的 crc32x / crc32b（S100 / RK3588 等 aarch64 平台）
+#ifndef SHIMETA_HV_DETAIL_CRC32_H
+#define SHIMETA_HV_DETAIL_CRC32_H
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define SHIMETA_CRC32_PCLMUL 1
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__)) && defined(__linux__)
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#define SHIMETA_CRC32_ARMV8 1
+#endif
+namespace Shimeta::hv::detail {
+
+/// tables[k][b]：字节 b 之后再经 k 个零字节的 CRC 贡献（slicing-by-N 的第 k 张表）。
+inline const std::array<std::array<uint32_t, 256>, 16>& crc32Tables() {
+    static const auto tables = [] {
+        std::array<std::array<uint32_t, 256>, 16> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[0][i] = c;
+        }
+        for (uint32_t i = 0; i < 256; ++i)
+            for (size_t k = 1; k < 16; ++k) t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xFF];
+        return t;
+    }();
+    return tables;
+}
+
+inline uint32_t loadLe32(const uint8_t* p) {
+    return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+}
+
+inline uint32_t crc32Bytewise(uint32_t state, const uint8_t* p, size_t n) {
+    const auto& t = crc32Tables()[0];
+    for (size_t i = 0; i < n; ++i) state = t[(state ^ p[i]) & 0xFF] ^ (state >> 8);
+    return state;
+}
+
+inline uint32_t crc32Slice8(uint32_t state, const uint8_t* p, size_t n) {
+    const auto& t = crc32Tables();
+    for (; n >= 8; p += 8, n -= 8) {
+        const uint32_t a = loadLe32(p) ^ state, b = loadLe32(p + 4);
+        state = t[7][a & 0xFF] ^ t[6][(a >> 8) & 0xFF] ^ t[5][(a >> 16) & 0xFF] ^ t[4][a >> 24] ^
+                t[3][b & 0xFF] ^ t[2][(b >> 8) & 0xFF] ^ t[1][(b >> 16) & 0xFF] ^ t[0][b >> 24];
+    }
+    return crc32Bytewise(state, p, n);
+}
+
+inline uint32_t crc32Slice16(uint32_t state, const uint8_t* p, size_t n) {
+    const auto& t = crc32Tables();
+    for (; n >= 16; p += 16, n -= 16) {
+        const uint32_t a = loadLe32(p) ^ state, b = loadLe32(p + 4), c = loadLe32(p + 8), d = loadLe32(p + 12);
+        state = t[15][a & 0xFF] ^ t[14][(a >> 8) & 0xFF] ^ t[13][(a >> 16) & 0xFF] ^ t[12][a >> 24] ^
+                t[11][b & 0xFF] ^ t[10][(b >> 8) & 0xFF] ^ t[9][(b >> 16) & 0xFF] ^ t[8][b >> 24] ^
+                t[7][c & 0xFF] ^ t[6][(c >> 8) & 0xFF] ^ t[5][(c >> 16) & 0xFF] ^ t[4][c >> 24] ^
+                t[3][d & 0xFF] ^ t[2][(d >> 8) & 0xFF] ^ t[1][(d >> 16) & 0xFF] ^ t[0][d >> 24];
+    }
+    return crc32Bytewise(state, p, n);
+}
+
+#if SHIMETA_CRC32_PCLMUL
+/// 4×128 位并行折叠到 128 位，再 Barrett 归约到 32 位；处理 n 向下取 16 的倍数（>= 64），
+/// 余下字节由 slicing-by-16 收尾。折叠常数为 0xEDB88320 反射域下的 x^(k) mod P。
+__attribute__((target("pclmul,sse4.1"))) inline uint32_t crc32Pclmul(uint32_t state, const uint8_t* p, size_t n) {
+    if (n < 64) return crc32Slice16(state, p, n);
+    alignas(16) static const uint64_t k1k2[2] = {0x0154442bd4, 0x01c6e41596};
+    alignas(16) static const uint64_t k3k4[2] = {0x01751997d0, 0x00ccaa009e};
+    alignas(16) static const uint64_t k5k0[2] = {0x0163cd6124, 0x0000000000};
+    alignas(16) static const uint64_t poly[2] = {0x01db710641, 0x01f7011641};
+    const size_t tail = n & 15;
+    size_t len = n - tail;
+    __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16));
+    __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 32));
+    __m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 48));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(int(state)));
+    __m128i x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+    p += 64;
+    len -= 64;
+    for (; len >= 64; p += 64, len -= 64) {
+        const __m128i x5 = _mm_clmulepi64_si128(x1, x0, 0x00), x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        const __m128i x7 = _mm_clmulepi64_si128(x3, x0, 0x00), x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), x5),
+                           _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+        x2 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x2, x0, 0x11), x6),
+                           _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16)));
+        x3 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x3, x0, 0x11), x7),
+                           _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 32)));
+        x4 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x4, x0, 0x11), x8),
+                           _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 48)));
+    }
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+    for (__m128i next : {x2, x3, x4}) {
+        const __m128i x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), next), x5);
+    }
+    for (; len >= 16; p += 16, len -= 16) {
+        const __m128i x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11),
+                                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(p))), x5);
+    }
+    // 128 → 64 位
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+    __m128i x2f = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2f);
+    x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+    x2f = _mm_srli_si128(x1, 4);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask32), x0, 0x00), x2f);
+    // Barrett 归约 64 → 32 位
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+    x2f = _mm_and_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask32), x0, 0x10), mask32);
+    x1 = _mm_xor_si128(x1, _mm_clmulepi64_si128(x2f, x0, 0x00));
+    return crc32Slice16(uint32_t(_mm_extract_epi32(x1, 1)), p, tail);
+}
+
+inline bool crc32PclmulSupported() { return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1"); }
+#endif
+
+#if SHIMETA_CRC32_ARMV8
+#if defined(__clang__)
+#define SHIMETA_CRC32_ARMV8_TARGET __attribute__((target("crc")))
+#else
+#define SHIMETA_CRC32_ARMV8_TARGET __attribute__((target("+crc")))
+#endif
+SHIMETA_CRC32_ARMV8_TARGET inline uint32_t crc32Armv8(uint32_t state, const uint8_t* p, size_t n) {
+    for (; n && (reinterpret_cast<uintptr_t>(p) & 7); --n) state = __crc32b(state, *p++);
+    for (; n >= 32; p += 32, n -= 32) {
+        uint64_t v[4];
+        std::memcpy(v, p, sizeof(v));
+        state = __crc32d(__crc32d(__crc32d(__crc32d(state, v[0]), v[1]), v[2]), v[3]);
+    }
+    for (; n >= 8; p += 8, n -= 8) {
+        uint64_t v;
+        std::memcpy(&v, p, 8);
+        state = __crc32d(state, v);
+    }
+    for (; n; --n) state = __crc32b(state, *p++);
+    return state;
+}
+#undef SHIMETA_CRC32_ARMV8_TARGET
+
+inline bool crc32Armv8Supported() {
+#ifndef HWCAP_CRC32
+#define HWCAP_CRC32 (1 << 7)
+#endif
+    return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+}
+#endif
+
+using Crc32Fn = uint32_t (*)(uint32_t state, const uint8_t* p, size_t n);
+
+struct Crc32Impl {
+    const char* name;
+    Crc32Fn     fn;
+};
+
+/// 本机可用的实现列表：参照实现在前，最快者在末尾。
+struct Crc32ImplList {
+    std::array<Crc32Impl, 4> items{};
+    size_t                   count = 0;
+
+    const Crc32Impl* begin() const { return items.data(); }
+    const Crc32Impl* end() const { return items.data() + count; }
+    const Crc32Impl& best() const { return items[count - 1]; }
+};
+
+inline const Crc32ImplList& crc32Impls() {
+    static const Crc32ImplList list = [] {
+        Crc32ImplList l;
+        l.items[l.count++] = {"bytewise", crc32Bytewise};
+        l.items[l.count++] = {"slice8", crc32Slice8};
+        l.items[l.count++] = {"slice16", crc32Slice16};
+#if SHIMETA_CRC32_PCLMUL
+        if (crc32PclmulSupported()) l.items[l.count++] = {"pclmul", crc32Pclmul};
+#elif SHIMETA_CRC32_ARMV8
+        if (crc32Armv8Supported()) l.items[l.count++] = {"armv8", crc32Armv8};
+#endif
+        return l;
+    }();
+    return list;
+}
+
+/// 运行时选定的实现（首次调用时探测 CPU，之后固定）。
+inline Crc32Fn crc32Fn() {
+    static const Crc32Fn fn = crc32Impls().best().fn;
+    return fn;
+}
+
+} // namespace Shimeta::hv::detail
+#endif // SHIMETA_HV_DETAIL_CRC32_H
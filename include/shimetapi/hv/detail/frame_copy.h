@@ -0,0 +1,24 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// 从相机回调收到的 Frame 逐字段拷贝：预编译 .so 构造的 Frame 不含后来追加的字段（seq 等），
+// 整体拷贝会越过其对象末尾。拷贝只增加 slab 引用计数，不搬移像素 / 事件数据。
+#ifndef SHIMETA_HV_DETAIL_FRAME_COPY_H
+#define SHIMETA_HV_DETAIL_FRAME_COPY_H
+#include <shimetapi/core/frame.h>
+namespace Shimeta::hv::detail {
+
+/// 拷贝 .so 已知的字段（至 aps_evs_ts 为止）；dst 其余追加字段保持原值。
+inline void copyFrame(Frame& dst, const Frame& src) {
+    dst.aps = src.aps;
+    dst.evs = src.evs;
+    dst.ts = src.ts;
+    dst.width = src.width;
+    dst.height = src.height;
+    dst.frame_id = src.frame_id;
+    dst.format = src.format;
+    dst.aps_owner = src.aps_owner;
+    dst.evs_owner = src.evs_owner;
+    dst.aps_evs_ts = src.aps_evs_ts;
+}
+
+} // namespace Shimeta::hv::detail
+#endif // SHIMETA_HV_DETAIL_FRAME_COPY_H
@@ -0,0 +1,157 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// VirtualCamera 内部的有界帧队列：容量 = DeviceConfig::buffer_count，满时按 QueuePolicy
+// 丢最旧（DropOldest）或阻塞生产者（Block）。close() 唤醒所有等待方。
+// popBatch 一次取出多条（包合并）：消费方按时间窗等待，凑够条数或窗口到期才醒，其间入队
+// 不通知，每批只唤醒一次。
+#ifndef SHIMETA_HV_DETAIL_FRAME_QUEUE_H
+#define SHIMETA_HV_DETAIL_FRAME_QUEUE_H
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <shimetapi/hv/device_config.h>
+namespace Shimeta::hv::detail {
+
+template <class T>
+class BoundedQueue {
+public:
+    using Policy = DeviceConfig::QueuePolicy;
+    using Clock = std::chrono::steady_clock;
+
+    void configure(size_t capacity, Policy policy) {
+        std::lock_guard<std::mutex> lk(m_);
+        cap_ = capacity > 0 ? capacity : 1;
+        policy_ = policy;
+        closed_ = false;
+        q_.clear();
+        t_.clear();
+        dropped_ = 0;
+        peak_ = 0;
+    }
+
+    /// 入队。Block 策略下队满等待空位；返回 false 表示队列已关闭。
+    bool push(T&& item) {
+        std::unique_lock<std::mutex> lk(m_);
+        if (policy_ == Policy::Block) {
+            not_full_.wait(lk, [&] { return closed_ || q_.size() < cap_; });
+        } else if (q_.size() >= cap_ && !closed_) {
+            q_.pop_front();
+            t_.pop_front();
+            ++dropped_;
+        }
+        if (closed_) return false;
+        q_.push_back(std::move(item));
+        t_.push_back(Clock::now());
+        if (q_.size() > peak_) peak_ = q_.size();
+        const bool wake = q_.size() >= want_;   // popBatch 凑批期间不逐条唤醒
+        lk.unlock();
+        if (wake) not_empty_.notify_one();
+        return true;
+    }
+
+    /// 出队，至多等待 timeout_ms（< 0 无限等待）。超时或已关闭且为空返回 false。
+    bool pop(T& out, int timeout_ms) {
+        std::unique_lock<std::mutex> lk(m_);
+        const auto ready = [&] { return closed_ || !q_.empty(); };
+        if (timeout_ms < 0) {
+            not_empty_.wait(lk, ready);
+        } else if (!not_empty_.wait_for(lk, std::chrono::milliseconds(timeout_ms), ready)) {
+            return false;
+        }
+        if (q_.empty()) return false;
+        out = std::move(q_.front());
+        q_.pop_front();
+        t_.pop_front();
+        lk.unlock();
+        not_full_.notify_one();
+        return true;
+    }
+
+    /// 批量出队：取出至多 max 条追加到 out，返回条数（timeout_ms 内无数据或已关闭为 0；
+    /// < 0 无限等待）。等待按长 max_wait 的时间窗进行：凑够 max 条即返回，窗口到期时有数据
+    /// 就返回、无数据则开下一个窗口，故每条的附加等待不超过 max_wait。窗口起点为开始等待时刻，
+    /// 若有上一批剩下的条目则为其队首入队时刻。max 超过容量时按容量计；max <= 1 等同 pop。
+    /// 只支持一个批量消费方。
+    size_t popBatch(std::vector<T>& out, size_t max, std::chrono::microseconds max_wait, int timeout_ms) {
+        std::unique_lock<std::mutex> lk(m_);
+        max = std::max<size_t>(std::min(max, cap_), 1);
+        const auto now0 = Clock::now();
+        const auto until = now0 + (timeout_ms < 0 ? std::chrono::milliseconds(std::chrono::hours(24 * 365))
+                                                  : std::chrono::milliseconds(timeout_ms));
+        if (max == 1 || max_wait.count() <= 0) {
+            if (!not_empty_.wait_until(lk, until, [&] { return closed_ || !q_.empty(); })) return 0;
+        } else {
+            auto window = q_.empty() ? now0 + max_wait : std::min(now0, t_.front()) + max_wait;
+            want_ = max;
+            while (!closed_ && q_.size() < max) {
+                not_empty_.wait_until(lk, std::min(window, until), [&] { return closed_ || q_.size() >= max; });
+                const auto now = Clock::now();
+                if (closed_ || q_.size() >= max) break;
+                if (now >= window) {
+                    if (!q_.empty()) break;
+                    window = now + max_wait;   // 空窗口：无数据到达，开下一个
+                }
+                if (now >= until) break;
+            }
+            want_ = 1;
+        }
+        const size_t n = std::min(max, q_.size());
+        for (size_t i = 0; i < n; ++i) {
+            out.push_back(std::move(q_.front()));
+            q_.pop_front();
+            t_.pop_front();
+        }
+        lk.unlock();
+        if (n) not_full_.notify_all();
+        return n;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            closed_ = true;
+            q_.clear();
+            t_.clear();
+        }
+        not_empty_.notify_all();
+        not_full_.notify_all();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lk(m_);
+        return q_.size();
+    }
+    uint64_t dropped() const {
+        std::lock_guard<std::mutex> lk(m_);
+        return dropped_;
+    }
+    /// 自 configure 起的最大排队数。
+    size_t peak() const {
+        std::lock_guard<std::mutex> lk(m_);
+        return peak_;
+    }
+    size_t capacity() const {
+        std::lock_guard<std::mutex> lk(m_);
+        return cap_;
+    }
+
+private:
+    mutable std::mutex            m_;
+    std::condition_variable       not_empty_, not_full_;
+    std::deque<T>                 q_;
+    std::deque<Clock::time_point> t_;         ///< 各条入队时刻（popBatch 的时限从队首算起）
+    size_t                        want_ = 1;  ///< 入队后达到此条数才唤醒消费方
+    size_t                        cap_ = 1;
+    Policy                        policy_ = Policy::DropOldest;
+    bool                          closed_ = false;
+    uint64_t                      dropped_ = 0;
+    size_t                        peak_ = 0;
+};
+
+} // namespace Shimeta::hv::detail
+#endif // SHIMETA_HV_DETAIL_FRAME_QUEUE_H
@@ -0,0 +1,72 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// 虚拟设备（回放 / 合成）共用的节拍时钟：按 speed 把数据时间戳映射到墙钟并可中断地等待。
+#ifndef SHIMETA_HV_DETAIL_MEDIA_CLOCK_H
+#define SHIMETA_HV_DETAIL_MEDIA_CLOCK_H
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+namespace Shimeta::hv::detail {
+
+/// 虚拟设备节拍：媒体时间（纳秒）→ 墙钟。首个 anchor / waitUntil 定原点；speed <= 0 不等待。
+class MediaClock {
+public:
+    void reset(double speed) {
+        std::lock_guard<std::mutex> lk(m_);
+        speed_ = speed;
+        anchored_ = false;
+        stopped_ = false;
+    }
+    void anchor(int64_t media_ns) {
+        std::lock_guard<std::mutex> lk(m_);
+        anchorLocked(media_ns);
+    }
+    int64_t origin() const {
+        std::lock_guard<std::mutex> lk(m_);
+        return anchored_ ? media0_ : 0;
+    }
+    /// 等到 media_ns 对应的墙钟时刻。到点返回 true；timeout_ms（>= 0）内到不了或已 stop 返回 false。
+    bool waitUntil(int64_t media_ns, int timeout_ms) {
+        std::unique_lock<std::mutex> lk(m_);
+        if (stopped_) return false;
+        if (speed_ <= 0) return true;
+        anchorLocked(media_ns);
+        const auto due = wall0_ + std::chrono::nanoseconds(int64_t(double(media_ns - media0_) / speed_));
+        const auto stopped = [&] { return stopped_; };
+        if (timeout_ms >= 0) {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+            if (due > deadline) {
+                cv_.wait_until(lk, deadline, stopped);
+                return false;
+            }
+        }
+        cv_.wait_until(lk, due, stopped);
+        return !stopped_;
+    }
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            stopped_ = true;
+        }
+        cv_.notify_all();
+    }
+
+private:
+    void anchorLocked(int64_t media_ns) {
+        if (anchored_) return;
+        anchored_ = true;
+        media0_ = media_ns;
+        wall0_ = std::chrono::steady_clock::now();
+    }
+
+    mutable std::mutex      m_;
+    std::condition_variable cv_;
+    double   speed_ = 1.0;
+    bool     anchored_ = false;
+    bool     stopped_ = false;
+    int64_t  media0_ = 0;
+    std::chrono::steady_clock::time_point wall0_{};
+};
+
+} // namespace Shimeta::hv::detail
+#endif // SHIMETA_HV_DETAIL_MEDIA_CLOCK_H
@@ -0,0 +1,127 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// 有状态 EVS 流的分包并行解码：EVT2 / EVT3 的 time-base 跨包延续，包与包不能各自独立解码。
+// PacketScanner 在到达线程上按包序只推进解码状态（EVT2 只看 TIME_HIGH 字，EVT3 只走状态字、
+// 跳过事件字），记下每包的起始状态；decode 持该起始状态在任意线程上解出与顺序解码逐位一致的
+// 事件。RAW8 无跨包状态，扫描为空操作。
+#ifndef SHIMETA_HV_DETAIL_PACKET_SCANNER_H
+#define SHIMETA_HV_DETAIL_PACKET_SCANNER_H
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <shimetapi/codec/detail/evt2_batch.h>
+#include <shimetapi/codec/detail/evt3_batch.h>
+#include <shimetapi/codec/evt2_codec.h>
+#include <shimetapi/codec/evt3_codec.h>
+#include <shimetapi/codec/mipi_raw8_codec.h>
+#include <shimetapi/core/event_cd.h>
+#include <shimetapi/hv/virtual_device.h>
+namespace Shimeta::hv::detail {
+
+/// 一包的解码起始状态（PacketScanner::advance 给出）。
+struct PacketStart {
+    size_t                   skip = 0;         ///< EVT2 首个 TIME_HIGH 之前被丢弃的字节
+    uint64_t                 evt2_base = 0;
+    unsigned                 evt2_loops = 0;
+    codec::detail::Evt3State evt3{};
+};
+
+class PacketScanner {
+public:
+    explicit PacketScanner(EvsPayload payload) : payload_(payload) {}
+
+    EvsPayload payload() const { return payload_; }
+
+    /// 返回本包的起始状态，并把扫描状态推进到包尾。语义同对应解码器 DecodeBatch 的状态推进。
+    PacketStart advance(const uint8_t* p, size_t len) {
+        PacketStart s;
+        if (!p || !len) return s;
+        switch (payload_) {
+        case EvsPayload::Evt2: {
+            size_t n = len / 4, first = 0;
+            if (!evt2_base_set_) first = codec::detail::evt2SeekTimeBase(p, n, evt2_base_, evt2_base_set_);
+            s.skip = first * 4;
+            s.evt2_base = evt2_base_;
+            s.evt2_loops = evt2_loops_;
+            for (size_t i = first; i < n; ++i) {
+                const uint32_t w = codec::detail::loadLe32(p + 4 * i);
+                if ((w >> 28) == codec::detail::kEvt2TypeTimeHigh)
+                    codec::detail::evt2TimeHigh(w, evt2_base_, evt2_loops_);
+            }
+            break;
+        }
+        case EvsPayload::Evt3: {
+            s.evt3 = evt3_;
+            if (len & 1) break;   // 同 Evt3Decoder：奇数长度整包丢弃
+            NullSink sink;
+            const size_t n = len / 2;
+            for (size_t i = 0; i < n; ++i) {
+                const uint16_t w = codec::detail::loadLe16(p + 2 * i);
+                const uint16_t type = w >> 12;
+                if (type == 0x1 || type == 0x3 || type == 0x4) continue;   // 事件字不改状态
+                codec::detail::evt3Word(w, evt3_, sink);
+            }
+            break;
+        }
+        case EvsPayload::MipiRaw8:
+            break;
+        }
+        return s;
+    }
+
+    /// 以起始状态 s 解码一包到 out（覆盖，容量跨调用复用）。可在任意线程并发调用。返回事件数。
+    static size_t decode(EvsPayload payload, const PacketStart& s, const uint8_t* p, size_t len,
+                         std::vector<EventCD>& out) {
+        out.clear();
+        if (!p || !len) return 0;
+        switch (payload) {
+        case EvsPayload::Evt2: {
+            if (s.skip >= len) return 0;
+            const size_t n = (len - s.skip) / 4;
+            uint64_t base = s.evt2_base;
+            unsigned loops = s.evt2_loops;
+            out.resize(n);
+            codec::detail::EventCDSink sink{out.data()};
+            codec::detail::evt2Decode(p + s.skip, n, base, loops, sink);
+            out.resize(size_t(sink.cur - out.data()));
+            break;
+        }
+        case EvsPayload::Evt3: {
+            if (len & 1) return 0;
+            const size_t n = len / 2;
+            codec::detail::Evt3State st = s.evt3;
+            out.resize(codec::detail::evt3Bound(p, n));
+            codec::detail::EventCDSink sink{out.data()};
+            codec::detail::evt3Decode(p, n, st, sink);
+            out.resize(size_t(sink.cur - out.data()));
+            break;
+        }
+        case EvsPayload::MipiRaw8:
+            codec::MipiRaw8Decoder().DecodeBatch(p, len, out);
+            break;
+        }
+        return out.size();
+    }
+
+    /// 回到流起点（下一包按首包处理）。
+    void reset() {
+        evt2_base_ = 0;
+        evt2_base_set_ = false;
+        evt2_loops_ = 0;
+        evt3_ = codec::detail::Evt3State{};
+    }
+
+private:
+    /// 只推进状态、不落地事件。
+    struct NullSink {
+        void put(uint16_t, uint16_t, int64_t, bool) {}
+    };
+
+    EvsPayload               payload_;
+    uint64_t                 evt2_base_ = 0;
+    bool                     evt2_base_set_ = false;
+    unsigned                 evt2_loops_ = 0;
+    codec::detail::Evt3State evt3_{};
+};
+
+} // namespace Shimeta::hv::detail
+#endif // SHIMETA_HV_DETAIL_PACKET_SCANNER_H
@@ -0,0 +1,50 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// 在当前线程上应用 DeviceConfig::ThreadPlacement（线程名、CPU 亲和、SCHED_FIFO），并读回实际
+// 生效值。失败不致命：记下 errno，线程以默认设置继续运行。非 Linux 平台只回报 running。
+#ifndef SHIMETA_HV_DETAIL_THREAD_PLACEMENT_H
+#define SHIMETA_HV_DETAIL_THREAD_PLACEMENT_H
+#include <cerrno>
+#include <string>
+#include <shimetapi/hv/device_config.h>
+#include <shimetapi/hv/stream_stats.h>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+namespace Shimeta::hv::detail {
+
+inline ThreadReport applyThreadPlacement(const DeviceConfig::ThreadPlacement& p, const char* default_name) {
+    ThreadReport r;
+    r.running = true;
+    r.name = (p.name.empty() ? std::string(default_name) : p.name).substr(0, 15);
+#if defined(__linux__)
+    const pthread_t self = pthread_self();
+    pthread_setname_np(self, r.name.c_str());
+    if (p.cpu_mask) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int i = 0; i < 64; ++i)
+            if (p.cpu_mask >> i & 1) CPU_SET(i, &set);
+        r.affinity_errno = pthread_setaffinity_np(self, sizeof(set), &set);
+    }
+    if (p.priority > 0) {
+        sched_param sp{};
+        sp.sched_priority = p.priority;
+        r.sched_errno = pthread_setschedparam(self, SCHED_FIFO, &sp);
+    }
+    // 读回
+    char name[16] = {};
+    if (pthread_getname_np(self, name, sizeof(name)) == 0) r.name = name;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (pthread_getaffinity_np(self, sizeof(set), &set) == 0)
+        for (int i = 0; i < 64; ++i)
+            if (CPU_ISSET(i, &set)) r.cpu_mask |= uint64_t(1) << i;
+    sched_param sp{};
+    if (pthread_getschedparam(self, &r.policy, &sp) == 0) r.priority = sp.sched_priority;
+#endif
+    return r;
+}
+
+} // namespace Shimeta::hv::detail
+#endif // SHIMETA_HV_DETAIL_THREAD_PLACEMENT_H
@@ -0,0 +1,74 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// 固定线程数的任务池（FIFO，无界）。任务量由上层的有界队列约束，本池不做背压。
+// close() 执行完已提交任务后退出全部线程。
+#ifndef SHIMETA_HV_DETAIL_WORKER_POOL_H
+#define SHIMETA_HV_DETAIL_WORKER_POOL_H
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+namespace Shimeta::hv::detail {
+
+class WorkerPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkerPool(size_t threads) {
+        if (threads == 0) threads = 1;
+        for (size_t i = 0; i < threads; ++i) threads_.emplace_back([this] { run(); });
+    }
+    ~WorkerPool() { close(); }
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /// 提交任务；已关闭返回 false（任务不执行）。
+    bool submit(Task t) {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            if (closed_) return false;
+            tasks_.push_back(std::move(t));
+        }
+        cv_.notify_one();
+        return true;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            closed_ = true;
+        }
+        cv_.notify_all();
+        for (std::thread& t : threads_)
+            if (t.joinable()) t.join();
+    }
+
+    size_t size() const { return threads_.size(); }
+
+private:
+    void run() {
+        while (true) {
+            Task t;
+            {
+                std::unique_lock<std::mutex> lk(m_);
+                cv_.wait(lk, [&] { return closed_ || !tasks_.empty(); });
+                if (tasks_.empty()) return;   // 已关闭且已执行完
+                t = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            t();
+        }
+    }
+
+    std::mutex               m_;
+    std::condition_variable  cv_;
+    std::deque<Task>         tasks_;
+    std::vector<std::thread> threads_;
+    bool                     closed_ = false;
+};
+
+} // namespace Shimeta::hv::detail
+#endif // SHIMETA_HV_DETAIL_WORKER_POOL_H
@@ -3,10 +3,13 @@
 #define SHIMETA_HV_DEVICE_CONFIG_H
 #include <cstdint>
 #include <string>
+#include <shimetapi/core/slab_pool_options.h>
 #include <shimetapi/hv/event_format.h>
 namespace Shimeta::hv {
 
-enum class Backend { Auto, Usb, Mipi, MipiHvs, Ethernet };
+/// Replay / Synthetic 为宿主侧虚拟后端（见 hv/virtual_camera.h），预编译 Camera 不识别。
+/// Ethernet 另可由 VirtualCamera 承载（批量零拷贝接收，见 hv/ethernet_device.h）。
+enum class Backend { Auto, Usb, Mipi, MipiHvs, Ethernet, Replay, Synthetic };
 
 struct DeviceConfig {
     Backend     backend      = Backend::Auto;
@@ -28,6 +31,45 @@ struct DeviceConfig {
     uint8_t     i2c_bus      = 1;                   ///< MIPI 安全芯片认证 I2C 总线
     uint16_t    listen_port = 8888;                 ///< Ethernet: TCP 监听端口（相机协议默认 8888）
     std::string bind_ip;                            ///< Ethernet: 本地绑定 IP（空=INADDR_ANY）
+    // 以下字段追加在结构末尾（预编译 Camera 只读取前面的字段，向后兼容）。
+    std::string replay_evs_path;                    ///< Replay: EVS 录制（HybridWriter / EventWriter 的 .raw）
+    std::string replay_aps_path;                    ///< Replay: APS 录制（HybridWriter 的 .avi，空=仅 EVS）
+    double      replay_speed = 1.0;                 ///< Replay: 1=实时，N=N 倍速，<=0=尽快（不节拍）
+    bool        replay_loop  = false;               ///< Replay: 读完从头循环
+    enum class SynthScene { MovingEdges, Flicker, Noise, Burst };
+    SynthScene  synth_scene = SynthScene::MovingEdges;  ///< Synthetic: 场景
+    bool        synth_mipi_raw8   = false;          ///< Synthetic: true=apx003 RAW8 包（按 evs_fps 档），false=按 event_fmt
+    double      synth_mev_per_s   = 10.0;           ///< Synthetic: 平均事件率（Mev/s）
+    uint32_t    synth_packet_us   = 1000;           ///< Synthetic: EVT 包周期（微秒）；RAW8 由 evs_fps 档决定
+    double      synth_aps_fps     = 0.0;            ///< Synthetic: >0 时输出 768×608 NV12 APS
+    double      synth_speed       = 1.0;            ///< Synthetic: 1=实时，N=N 倍速，<=0=尽快（饱和测试）
+    uint32_t    synth_duration_ms = 0;              ///< Synthetic: 传感器时间时长（0=不结束）
+    uint32_t    synth_seed        = 1;              ///< Synthetic: 随机种子（同种子同输出）
+    // Ethernet 经 VirtualCamera（EthernetDevice）接收时生效；预编译 Camera 不读取。
+    uint32_t    eth_recv_chunk_bytes = 1u << 20;    ///< Ethernet: 接收 slab 大小（单次 recv 上限，>= 64 KiB）
+    int         eth_recv_slabs       = 0;           ///< Ethernet: 接收 slab 数（0 = buffer_count + 4）
+    bool        eth_verify_crc       = true;        ///< Ethernet: 校验包 CRC（不符丢弃）
+    /// 线程放置与调度：VirtualCamera 的 EVS / APS 采集线程与分发线程在启动时自行应用，实际生效值
+    /// 经 VirtualCamera::GetStats 回报。预编译 Camera 不读取。
+    struct ThreadPlacement {
+        uint64_t    cpu_mask = 0;    ///< 允许运行的 CPU 位图（bit i = CPU i；0 = 不绑定）
+        int         priority = 0;    ///< >0：SCHED_FIFO 该优先级（1..99，需 CAP_SYS_NICE）；0 = 默认调度
+        std::string name;            ///< 线程名（截断到 15 字节；空 = hv-evs / hv-aps / hv-disp）
+    };
+    ThreadPlacement evs_thread;                     ///< EVS 采集线程（evLoop）
+    ThreadPlacement aps_thread;                     ///< APS 采集线程（imgLoop）
+    ThreadPlacement dispatch_thread;                ///< 回调分发线程（dispLoop）
+    /// 包合并（VirtualCamera）：coalesce_packets > 1 时分发线程 / GetFrames 一次取出至多该数的
+    /// 连续帧，凑批最多等到队首帧入队后 coalesce_us；其间不逐帧唤醒。预编译 Camera 不读取。
+    uint32_t    coalesce_packets = 0;               ///< 每批帧数上限（0 / 1 = 不合并，逐帧交付）
+    uint32_t    coalesce_us      = 2000;            ///< 凑批的最大附加延迟（微秒）
+    /// slab 池内存（VirtualCamera 的 EVS / APS 池与 EthernetDevice 的接收池）：大页、预触、mlock、
+    /// NUMA 绑定，Init 时一次性生效，实际结果经 GetStats 的 evs_pool_memory / aps_pool_memory 回报。
+    SlabPoolOptions pool_memory;
+    /// slab 池尺寸档（VirtualCamera）：按 2 的幂分档、按需增长；pool_memory 要求预触 / mlock / 大页时
+    /// Init 即映射最高档。见 core/size_class_pool.h。
+    uint32_t    pool_class_slabs = 0;               ///< 每档 slab 上限（0 = buffer_count + 2）
+    uint64_t    pool_max_bytes   = 0;               ///< 每个池的 slab 字节上限（0 = 每档上限 × 单包 / 帧上限）
 };
 
 } // namespace Shimeta::hv
@@ -0,0 +1,337 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// 以太网批量接收设备：与预编译 Camera 的 Backend::Ethernet 同一线协议（hv/ethernet_protocol.h）、
+// 同一连接方式（主机监听，相机连入），但接收路径改为大块 recv 进池 slab、就地切包：
+// EventPacket / Frame.evs 直接指向接收 slab（零拷贝），有积压时每次 recv 取回多包。
+// 由 VirtualCamera 承载（cfg.backend = Backend::Ethernet）。header-only。
+#ifndef SHIMETA_HV_ETHERNET_DEVICE_H
+#define SHIMETA_HV_ETHERNET_DEVICE_H
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shimetapi/core/slab_pool.h>
+#include <shimetapi/hv/ethernet_protocol.h>
+#include <shimetapi/hv/virtual_device.h>
+namespace Shimeta::hv {
+
+/// Backend::Ethernet 的宿主侧设备。start() 在 bind_ip:listen_port 监听并等待相机连入
+/// （上限 ethernet::kAcceptTimeoutMs）；之后读线程以 MSG_DONTWAIT 大块 recv 填充当前 slab
+/// （eth_recv_chunk_bytes，池容量 eth_recv_slabs），在 slab 内按包头定界：完整的事件包
+/// 原地交付，owner 为该 slab 的引用（同一 slab 可被多帧共享，全部释放后归还池）。
+/// recv 的填充上限按上一包大小对齐到预计的包边界，换 slab 时通常无半包可搬
+/// （包长变化时半包搬到新 slab 开头，计入 copiedBytes）；大于 slab 的包先只收包头，
+/// 载荷直接收进单独分配的缓冲。
+/// 与 HAL 一致：CRC 不符的包丢弃，非事件包跳过；通过 CRC 的包的 seq 跳号计入 seqGaps()。
+class EthernetDevice : public VirtualDevice {
+public:
+    static constexpr size_t kMinChunkBytes = 64 * 1024;
+    static constexpr int    kRcvBufBytes = 4 << 20;   ///< SO_RCVBUF（与 HAL 相同）
+    static constexpr std::chrono::milliseconds kStopPoll{10};   ///< 等池归还时检查 stop 的间隔
+
+    EthernetDevice() = default;
+    ~EthernetDevice() override {
+        stop();
+        closeSockets();
+    }
+
+    Status init(const DeviceConfig& cfg) override {
+        stop();
+        closeSockets();
+        cfg_ = cfg;
+        sockaddr_in addr{};
+        if (!cfg.bind_ip.empty() && ::inet_pton(AF_INET, cfg.bind_ip.c_str(), &addr.sin_addr) != 1)
+            return Status::ErrInvalidParam;
+        slab_bytes_ = std::max<size_t>(cfg.eth_recv_chunk_bytes, kMinChunkBytes);
+        const size_t slabs = cfg.eth_recv_slabs > 0 ? size_t(cfg.eth_recv_slabs)
+                                                    : size_t(std::max(cfg.buffer_count, 1)) + 4;
+        pool_ = std::make_unique<SlabPool>(slab_bytes_, std::max<size_t>(slabs, 2), cfg.pool_memory);
+        return Status::Ok;
+    }
+
+    /// 监听并等待相机连入；超时 ErrNetworkTimeout，端口不可用 ErrDeviceNotFound。
+    Status start() override {
+        closeSockets();
+        stopping_ = false;
+        ended_ = false;
+        cur_.reset();
+        big_.reset();
+        owner_.reset();
+        begin_ = fill_ = big_fill_ = last_total_ = 0;
+        drained_ = true;
+        have_seq_ = false;
+        packets_ = bytes_ = syscalls_ = copied_ = crc_errors_ = skipped_ = seq_gaps_ = 0;
+
+        const int lfd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (lfd < 0) return Status::ErrDeviceNotFound;
+        const int one = 1;
+        ::setsockopt(lfd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(cfg_.listen_port ? cfg_.listen_port : ethernet::kDefaultListenPort);
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        if (!cfg_.bind_ip.empty()) ::inet_pton(AF_INET, cfg_.bind_ip.c_str(), &addr.sin_addr);
+        if (::bind(lfd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(lfd, 1) != 0) {
+            ::close(lfd);
+            return Status::ErrDeviceNotFound;
+        }
+        listen_fd_ = lfd;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(ethernet::kAcceptTimeoutMs);
+        while (!stopping_ && std::chrono::steady_clock::now() < deadline) {
+            pollfd pfd{lfd, POLLIN, 0};
+            if (::poll(&pfd, 1, 100) <= 0) continue;
+            const int fd = ::accept(lfd, nullptr, nullptr);
+            if (fd < 0) continue;
+            const int rcvbuf = kRcvBufBytes;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+            fd_ = fd;
+            return Status::Ok;
+        }
+        return Status::ErrNetworkTimeout;
+    }
+
+    /// 关闭连接的读写两端，令阻塞中的 readEventPacket 立即返回；套接字在下次 start / 析构时关闭。
+    void stop() override {
+        stopping_ = true;
+        const int fd = fd_;
+        if (fd >= 0) ::shutdown(fd, SHUT_RDWR);
+    }
+
+    /// 读下一事件包。pkt.data 指向接收 slab（或超大包的独立缓冲），owner 由 eventPacketOwner() 取得。
+    bool readEventPacket(EventPacket& pkt, int timeout_ms) override {
+        owner_.reset();
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(std::max(timeout_ms, 0));
+        while (!ended_ && !stopping_) {
+            if (big_) {   // 超大包：续收到独立缓冲
+                const size_t total = ethernet::kHeaderBytes + big_hdr_.payload_len;
+                if (big_fill_ < total) {
+                    if (!recvInto(big_.get(), big_fill_, total, deadline)) return false;
+                    continue;
+                }
+                std::shared_ptr<uint8_t[]> big = std::move(big_);
+                big_.reset();
+                if (deliver(big_hdr_, big.get() + ethernet::kHeaderBytes, big, pkt)) return true;
+                continue;
+            }
+            if (!cur_ && !nextSlab(deadline)) return false;
+            const size_t avail = fill_ - begin_;
+            size_t cap = slab_bytes_;   // 本次 recv 的填充上限：按上一包大小对齐到预计的包边界
+            if (last_total_ > 0 && last_total_ <= slab_bytes_)
+                cap = begin_ + (slab_bytes_ - begin_) / last_total_ * last_total_;
+            if (avail >= ethernet::kHeaderBytes) {
+                const uint8_t* p = cur_.get() + begin_;
+                ethernet::PacketHeader h;
+                if (!ethernet::decodeHeader(p, h)) {   // 失步后无法重新定界：按断连处理
+                    ended_ = true;
+                    break;
+                }
+                const size_t total = ethernet::kHeaderBytes + h.payload_len;
+                if (total > slab_bytes_) {
+                    big_.reset(new uint8_t[total]);
+                    std::memcpy(big_.get(), p, avail);
+                    copied_ += avail;
+                    big_hdr_ = h;
+                    big_fill_ = avail;
+                    begin_ = fill_;
+                    last_total_ = total;
+                    continue;
+                }
+                if (avail >= total) {
+                    begin_ += total;
+                    last_total_ = total;
+                    if (deliver(h, p + ethernet::kHeaderBytes, cur_, pkt)) return true;
+                    continue;
+                }
+                if (begin_ + total > slab_bytes_) {   // 本包放不下：半包搬到新 slab
+                    if (!nextSlab(deadline)) return false;
+                    continue;
+                }
+                cap = std::max(cap, begin_ + total);
+            } else if (begin_ + ethernet::kHeaderBytes > slab_bytes_ || (avail == 0 && cap == begin_)) {
+                if (!nextSlab(deadline)) return false;   // 余量不足一包：换 slab（无半包时不拷贝）
+                continue;
+            } else if (last_total_ > slab_bytes_) {
+                cap = begin_ + ethernet::kHeaderBytes;   // 超大包：先只收包头，载荷直接收进独立缓冲
+            } else {
+                cap = std::max(cap, begin_ + ethernet::kHeaderBytes);
+            }
+            if (!recvInto(cur_.get(), fill_, cap, deadline)) return false;
+        }
+        return false;
+    }
+
+    /// 最近一次 readEventPacket 交付包的缓冲 owner（VirtualCamera 据此零拷贝出帧）。
+    std::shared_ptr<uint8_t[]> eventPacketOwner() override { return owner_; }
+    SlabMemoryReport eventPoolMemory() const override { return pool_ ? pool_->memory() : SlabMemoryReport{}; }
+    SlabPoolStats eventPoolStats() const override { return pool_ ? pool_->stats() : SlabPoolStats{}; }
+    void resetEventPoolStats() override {
+        if (pool_) pool_->resetStats();
+    }
+
+    bool readImageFrame(ImageData&, EvsTimestamp&, int) override { return false; }
+
+    bool       hasEvents() const override { return true; }
+    bool       hasImages() const override { return false; }
+    bool       eventsEnded() const override { return ended_; }
+    bool       imagesEnded() const override { return true; }
+    EvsPayload evsPayload() const override {
+        return cfg_.event_fmt == EventFormat::Evt2 ? EvsPayload::Evt2 : EvsPayload::Evt3;
+    }
+    size_t     maxEventPacketBytes() const override { return 0; }   ///< 缓冲由设备自管
+    size_t     maxImageBytes() const override { return 0; }
+
+    /// 经同一连接下发 SetFrameRate 命令包（与 Camera::SetFrameRate 的线上格式相同）。
+    bool setFrameRate(unsigned fps) override {
+        const int fd = fd_;
+        if (fd < 0 || fps > 0xFFFF) return false;
+        uint8_t buf[ethernet::kHeaderBytes + 2];
+        buf[ethernet::kHeaderBytes] = uint8_t(fps >> 8);
+        buf[ethernet::kHeaderBytes + 1] = uint8_t(fps);
+        ethernet::PacketHeader h;
+        h.type = uint8_t(ethernet::PacketType::SetFrameRate);
+        h.payload_len = 2;
+        h.setTimestampNs(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::system_clock::now().time_since_epoch()).count());
+        std::lock_guard<std::mutex> lk(send_mutex_);
+        h.seq = cmd_seq_++;
+        h.crc = ethernet::packetChecksum(h, ethernet::crc32(buf + ethernet::kHeaderBytes, 2));
+        ethernet::encodeHeader(h, buf);
+        size_t off = 0;
+        while (off < sizeof(buf)) {
+            const ssize_t n = ::send(fd, buf + off, sizeof(buf) - off, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            off += size_t(n);
+        }
+        fps_ = fps;
+        return true;
+    }
+    bool getFrameRate(unsigned& fps) const override {
+        fps = fps_;
+        return fps_ != 0;
+    }
+
+    uint64_t packetsReceived() const { return packets_; }
+    uint64_t bytesReceived() const { return bytes_; }      ///< 线上字节（含包头与被跳过的包）
+    uint64_t recvSyscalls() const { return syscalls_; }    ///< recv + poll 调用数
+    uint64_t copiedBytes() const { return copied_; }       ///< 跨 slab 半包与超大包的搬移字节
+    uint64_t crcErrors() const { return crc_errors_; }
+    uint64_t skippedPackets() const { return skipped_; }   ///< 非事件包
+    uint64_t seqGaps() const { return seq_gaps_; }
+
+private:
+    void closeSockets() {
+        for (std::atomic<int>* fd : {&fd_, &listen_fd_}) {
+            const int v = fd->exchange(-1);
+            if (v >= 0) ::close(v);
+        }
+    }
+
+    /// 换新 slab，未解析完的尾部搬到开头。当前 slab 已无他人引用且已解析完时原地复用。
+    /// 池耗尽（下游仍持有帧）时等到 deadline，期间不读套接字，由 TCP 流控反压相机。
+    bool nextSlab(std::chrono::steady_clock::time_point deadline) {
+        const size_t tail = fill_ - begin_;
+        if (cur_ && tail == 0 && cur_.use_count() == 1) {
+            begin_ = fill_ = 0;
+            return true;
+        }
+        std::shared_ptr<uint8_t[]> slab = pool_->acquire();
+        while (!slab) {   // 按归还唤醒；分段等待以响应 stopping_
+            const auto now = std::chrono::steady_clock::now();
+            if (stopping_ || now >= deadline) return false;
+            slab = pool_->acquire(std::min<std::chrono::microseconds>(
+                std::chrono::duration_cast<std::chrono::microseconds>(deadline - now), kStopPoll));
+        }
+        if (tail) std::memcpy(slab.get(), cur_.get() + begin_, tail);
+        copied_ += tail;
+        cur_ = std::move(slab);
+        begin_ = 0;
+        fill_ = tail;
+        return true;
+    }
+
+    /// 一次 recv 尽量填满 [fill, cap)。上次 recv 已读空套接字时先 poll 再读，否则直接读，
+    /// 有积压时每包摊到的系统调用远少于 1。超时 / 断连返回 false。
+    bool recvInto(uint8_t* buf, size_t& fill, size_t cap, std::chrono::steady_clock::time_point deadline) {
+        const int fd = fd_;
+        if (drained_) {
+            const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                  deadline - std::chrono::steady_clock::now()).count();
+            pollfd pfd{fd, POLLIN, 0};
+            ++syscalls_;
+            if (::poll(&pfd, 1, int(std::max<int64_t>(left, 0))) <= 0) return false;
+        }
+        const size_t want = cap - fill;
+        const ssize_t n = ::recv(fd, buf + fill, want, MSG_DONTWAIT);
+        ++syscalls_;
+        if (n > 0) {
+            fill += size_t(n);
+            bytes_ += uint64_t(n);
+            drained_ = size_t(n) < want;
+            return true;
+        }
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            ended_ = true;
+            return false;
+        }
+        drained_ = true;
+        return true;
+    }
+
+    /// 校验并交付一包（包头已由 decodeHeader 校验）；CRC 不符或非事件包返回 false（调用方继续
+    /// 解析下一包）。seq 只取自通过 CRC 的包：损坏包的 seq 不可信，不计跳号也不作为下一包的基准，
+    /// 它本身作为丢失的一包计入下一个好包的跳号。
+    bool deliver(const ethernet::PacketHeader& h, const uint8_t* payload, const std::shared_ptr<uint8_t[]>& owner,
+                 EventPacket& pkt) {
+        if (cfg_.eth_verify_crc && ethernet::packetChecksum(h, ethernet::crc32(payload, h.payload_len)) != h.crc) {
+            ++crc_errors_;
+            return false;
+        }
+        if (have_seq_ && h.seq != last_seq_ + 1) seq_gaps_ += uint32_t(h.seq - last_seq_ - 1);
+        have_seq_ = true;
+        last_seq_ = h.seq;
+        if (h.type != uint8_t(ethernet::PacketType::Event)) {
+            ++skipped_;
+            return false;
+        }
+        pkt.data = BufferView{payload, h.payload_len};
+        pkt.t_begin_ns = pkt.t_end_ns = h.timestampNs();
+        owner_ = owner;
+        ++packets_;
+        return true;
+    }
+
+    DeviceConfig                cfg_;
+    std::unique_ptr<SlabPool>   pool_;
+    size_t                      slab_bytes_ = 0;
+    std::atomic<int>            fd_{-1}, listen_fd_{-1};
+    std::atomic<bool>           stopping_{false}, ended_{false};
+    std::mutex                  send_mutex_;
+    uint32_t                    cmd_seq_ = 0;
+    std::atomic<unsigned>       fps_{0};
+
+    // 读线程状态：当前 slab 中 [begin_, fill_) 为未解析字节。
+    std::shared_ptr<uint8_t[]>  cur_, big_, owner_;
+    size_t                      begin_ = 0, fill_ = 0, big_fill_ = 0;
+    size_t                      last_total_ = 0;   ///< 上一包线上字节数（预判下一包能否放进当前 slab）
+    ethernet::PacketHeader      big_hdr_;
+    bool                        drained_ = true, have_seq_ = false;
+    uint32_t                    last_seq_ = 0;
+    std::atomic<uint64_t>       packets_{0}, bytes_{0}, syscalls_{0}, copied_{0}, crc_errors_{0}, skipped_{0},
+                                seq_gaps_{0};
+};
+
+} // namespace Shimeta::hv
+#endif // SHIMETA_HV_ETHERNET_DEVICE_H
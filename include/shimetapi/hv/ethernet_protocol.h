@@ -0,0 +1,106 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// 以太网后端线协议（Backend::Ethernet）。主机侧 Camera 在 bind_ip:listen_port 监听，相机主动
+// 连入后在同一条 TCP 连接上推送事件包；主机经该连接下发命令包（SetFrameRate）。
+// 每包 = 40 字节包头（多字节字段大端）+ payload_len 字节载荷：
+//   [0, 4)   magic "DVS1"       [4] version = 1     [5] type（PacketType）
+//   [8, 12)  seq（逐包 +1，主机统计跳号）
+//   [16, 20) ts_sec  [20, 24) ts_usec（包时间戳 = ts_sec·1e9 + ts_usec·1e3 ns → Frame.ts.evs_ts_ns）
+//   [24, 28) payload_len（<= kMaxPayloadBytes）
+//   [32, 36) crc = crc32(包头 [36, 40)) ^ crc32(载荷)（载荷为空时仅前项）
+//   [36, 40) aux（计入 CRC，目前填 0）；其余字节保留，填 0
+// 供相机替身（hv/ethernet_standin.h）与抓包分析使用；主机侧实现在预编译 shimetapi_hv 内。
+#ifndef SHIMETA_HV_ETHERNET_PROTOCOL_H
+#define SHIMETA_HV_ETHERNET_PROTOCOL_H
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <shimetapi/hv/detail/crc32.h>
+namespace Shimeta::hv::ethernet {
+
+constexpr size_t   kHeaderBytes       = 40;
+constexpr uint8_t  kVersion           = 1;
+constexpr uint32_t kMaxPayloadBytes   = 32u << 20;
+constexpr uint16_t kDefaultListenPort = 8888;   ///< DeviceConfig::listen_port 为 0 时
+constexpr int      kAcceptTimeoutMs   = 30000;  ///< StartStream 等待相机连入的上限
+
+/// 包类型。主机只交付 Event；其余类型的包被跳过（连续 16 个非事件包按超时处理）。
+enum class PacketType : uint8_t {
+    Event        = 0x01,   ///< 事件载荷（格式由相机配置决定，EVT2 / EVT3）
+    Image        = 0x02,   ///< APS 帧（当前主机端不解析）
+    SetFrameRate = 0x20,   ///< 主机 → 相机：载荷为 2 字节大端帧率（Camera::SetFrameRate）
+};
+
+struct PacketHeader {
+    uint8_t  version = kVersion;
+    uint8_t  type = uint8_t(PacketType::Event);
+    uint32_t seq = 0;
+    uint32_t ts_sec = 0, ts_usec = 0;
+    uint32_t payload_len = 0;
+    uint32_t crc = 0;
+    uint32_t aux = 0;
+
+    int64_t timestampNs() const { return int64_t(ts_sec) * 1000000000 + int64_t(ts_usec) * 1000; }
+    void setTimestampNs(int64_t ns) {
+        ts_sec = uint32_t(ns / 1000000000);
+        ts_usec = uint32_t((ns % 1000000000) / 1000);
+    }
+};
+
+namespace detail {
+
+inline void putBe32(uint8_t* p, uint32_t v) {
+    p[0] = uint8_t(v >> 24);
+    p[1] = uint8_t(v >> 16);
+    p[2] = uint8_t(v >> 8);
+    p[3] = uint8_t(v);
+}
+inline uint32_t getBe32(const uint8_t* p) {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+} // namespace detail
+
+/// CRC-32（IEEE 802.3，反射多项式 0xEDB88320）；空输入返回 0（与主机侧一致）。
+/// 按 CPU 选用 PCLMUL / ARMv8 CRC32 / slicing-by-16（见 hv/detail/crc32.h）。
+inline uint32_t crc32(const uint8_t* data, size_t n) {
+    if (n == 0) return 0;
+    return ~hv::detail::crc32Fn()(0xFFFFFFFFu, data, n);
+}
+
+/// 包头 crc 字段应有的值；payload_crc 为 crc32(载荷)（可预先算好复用）。
+inline uint32_t packetChecksum(const PacketHeader& h, uint32_t payload_crc) {
+    uint8_t aux[4];
+    detail::putBe32(aux, h.aux);
+    return h.payload_len ? crc32(aux, 4) ^ payload_crc : crc32(aux, 4);
+}
+
+/// 序列化包头到 out[0, kHeaderBytes)。
+inline void encodeHeader(const PacketHeader& h, uint8_t* out) {
+    std::memset(out, 0, kHeaderBytes);
+    std::memcpy(out, "DVS1", 4);
+    out[4] = h.version;
+    out[5] = h.type;
+    detail::putBe32(out + 8, h.seq);
+    detail::putBe32(out + 16, h.ts_sec);
+    detail::putBe32(out + 20, h.ts_usec);
+    detail::putBe32(out + 24, h.payload_len);
+    detail::putBe32(out + 32, h.crc);
+    detail::putBe32(out + 36, h.aux);
+}
+
+/// 解析包头；magic / version / payload_len 不合法返回 false（主机侧 validateHeader 的规则）。
+inline bool decodeHeader(const uint8_t* in, PacketHeader& h) {
+    if (std::memcmp(in, "DVS1", 4) != 0 || in[4] != kVersion) return false;
+    h.version = in[4];
+    h.type = in[5];
+    h.seq = detail::getBe32(in + 8);
+    h.ts_sec = detail::getBe32(in + 16);
+    h.ts_usec = detail::getBe32(in + 20);
+    h.payload_len = detail::getBe32(in + 24);
+    h.crc = detail::getBe32(in + 32);
+    h.aux = detail::getBe32(in + 36);
+    return h.payload_len <= kMaxPayloadBytes;
+}
+
+} // namespace Shimeta::hv::ethernet
+#endif // SHIMETA_HV_ETHERNET_PROTOCOL_H
@@ -0,0 +1,275 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// 以太网相机替身：按 hv/ethernet_protocol.h 的线协议连入主机 Camera（Backend::Ethernet）的监听端口，
+// 以可控带宽推送带 CRC 的事件包（可选 APS 帧包），并响应主机下发的命令包。用于无相机时在回环 /
+// 局域网上压测以太网接收路径。header-only，需链接 shimetapi_codec（载荷由 SyntheticDevice 生成）。
+#ifndef SHIMETA_HV_ETHERNET_STANDIN_H
+#define SHIMETA_HV_ETHERNET_STANDIN_H
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include <shimetapi/hv/ethernet_protocol.h>
+#include <shimetapi/hv/synthetic_device.h>
+namespace Shimeta::hv {
+
+struct EthernetStandInConfig {
+    std::string host = "127.0.0.1";                   ///< 主机 Camera 的 bind_ip
+    uint16_t    port = ethernet::kDefaultListenPort;  ///< 主机 Camera 的 listen_port
+    double      mb_per_s = 0;                         ///< 事件包带宽（MB/s），0=尽快
+    size_t      packet_bytes = 64 * 1024;             ///< 事件包载荷字节数（向下取 4 的倍数）
+    EventFormat event_fmt = EventFormat::Evt3;        ///< 载荷格式
+    double      aps_fps = 0;                          ///< >0 时按此帧率插入 768×608 NV12 Image 包
+    int         connect_timeout_ms = 5000;            ///< 等待主机开始监听的上限
+};
+
+/// 相机替身。事件载荷为 SyntheticDevice（Noise 场景，20 Mev/s）预先生成的约 8 MiB 流，切成
+/// packet_bytes 的包循环发送（载荷 CRC 预先算好，发送路径只写包头）；循环回绕时事件时间戳回跳。
+/// 包头时间戳取发送时刻的系统时钟，同机回环时主机侧 now - Frame.ts.evs_ts_ns 即单包延迟。
+/// 收到 SetFrameRate(fps) 后改按 fps 包 / 秒发送（帧率 0 恢复按带宽）。
+class EthernetStandIn {
+public:
+    static constexpr size_t kRingBytes = 8u << 20;
+
+    EthernetStandIn() = default;
+    ~EthernetStandIn() { stop(); }
+    EthernetStandIn(const EthernetStandIn&) = delete;
+    EthernetStandIn& operator=(const EthernetStandIn&) = delete;
+
+    /// 生成载荷并启动发送线程；线程在 connect_timeout_ms 内重试连入主机（主机 Camera 在
+    /// StartStream 时才开始监听，替身可先于它启动）。仅配置非法时返回 false。
+    bool start(const EthernetStandInConfig& cfg) {
+        stop();
+        cfg_ = cfg;
+        cfg_.packet_bytes = std::max<size_t>(cfg.packet_bytes & ~size_t(3), 4);
+        sockaddr_in addr{};
+        if (cfg_.packet_bytes > ethernet::kMaxPayloadBytes || cfg_.aps_fps < 0 ||
+            ::inet_pton(AF_INET, cfg_.host.c_str(), &addr.sin_addr) != 1)
+            return false;
+        buildPayloads();
+        running_ = true;
+        thread_ = std::thread([this] {
+            if (connectHost()) sendLoop();
+            finished_ = true;
+        });
+        return true;
+    }
+
+    void stop() {
+        running_ = false;
+        if (thread_.joinable()) thread_.join();
+        connected_ = finished_ = false;
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    bool     connected() const { return connected_; }
+    /// 发送线程已退出（连接超时、主机断开或 stop）。
+    bool     finished() const { return finished_; }
+    uint64_t packetsSent() const { return packets_; }
+    uint64_t bytesSent() const { return bytes_; }   ///< 含包头
+    uint64_t imagesSent() const { return images_; }
+    uint64_t commandsReceived() const { return commands_; }
+    uint64_t badCommands() const { return bad_commands_; }   ///< 包头 / CRC 不合法或类型未知
+    unsigned frameRate() const { return frame_rate_; }       ///< 最近一次 SetFrameRate，0=未设
+
+private:
+    struct Payload {
+        size_t   off = 0, len = 0;
+        uint32_t crc = 0;
+    };
+
+    void buildPayloads() {
+        DeviceConfig dc;
+        dc.backend = Backend::Synthetic;
+        dc.event_fmt = cfg_.event_fmt;
+        dc.synth_scene = DeviceConfig::SynthScene::Noise;
+        dc.synth_mev_per_s = 20.0;
+        dc.synth_speed = 0;
+        ring_.clear();
+        SyntheticDevice dev;
+        EventPacket pkt;
+        if (dev.init(dc) == Status::Ok && dev.start() == Status::Ok) {
+            while (ring_.size() < kRingBytes && dev.readEventPacket(pkt, 0))
+                ring_.insert(ring_.end(), pkt.data.data, pkt.data.data + pkt.data.size);
+        }
+        const size_t n = std::max<size_t>(ring_.size() / cfg_.packet_bytes, 1);
+        ring_.resize(n * cfg_.packet_bytes);
+        payloads_.assign(n, Payload{});
+        for (size_t i = 0; i < n; ++i) {
+            payloads_[i].off = i * cfg_.packet_bytes;
+            payloads_[i].len = cfg_.packet_bytes;
+            payloads_[i].crc = ethernet::crc32(ring_.data() + payloads_[i].off, cfg_.packet_bytes);
+        }
+        image_.clear();
+        if (cfg_.aps_fps > 0) {
+            const int w = SyntheticDevice::kWidth, h = SyntheticDevice::kHeight;
+            image_.assign(size_t(w) * h * 3 / 2, 128);
+            for (int y = 0; y < h; ++y)
+                for (int x = 0; x < w; ++x) image_[size_t(y) * w + x] = uint8_t(((x + y) & 0x7F) + 32);
+            image_crc_ = ethernet::crc32(image_.data(), image_.size());
+        }
+    }
+
+    bool connectHost() {
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(cfg_.port);
+        ::inet_pton(AF_INET, cfg_.host.c_str(), &addr.sin_addr);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(cfg_.connect_timeout_ms);
+        do {
+            fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+            if (fd_ < 0) return false;
+            if (::connect(fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0) {
+                const int one = 1;
+                ::setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+                connected_ = true;
+                return true;
+            }
+            ::close(fd_);
+            fd_ = -1;
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        } while (running_ && std::chrono::steady_clock::now() < deadline);
+        return false;
+    }
+
+    /// 整包发送（包头 + 载荷一次 sendmsg，短写续发）。
+    bool sendPacket(ethernet::PacketType type, const uint8_t* payload, size_t len, uint32_t payload_crc) {
+        ethernet::PacketHeader h;
+        h.type = uint8_t(type);
+        h.seq = seq_++;
+        h.setTimestampNs(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::system_clock::now().time_since_epoch()).count());
+        h.payload_len = uint32_t(len);
+        h.crc = ethernet::packetChecksum(h, payload_crc);
+        uint8_t head[ethernet::kHeaderBytes];
+        ethernet::encodeHeader(h, head);
+        iovec iov[2] = {{head, sizeof(head)}, {const_cast<uint8_t*>(payload), len}};
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = len ? 2 : 1;
+        size_t left = sizeof(head) + len;
+        while (left) {
+            const ssize_t n = ::sendmsg(fd_, &msg, MSG_NOSIGNAL);
+            if (n <= 0) return false;
+            left -= size_t(n);
+            size_t adv = size_t(n);
+            while (msg.msg_iovlen && adv >= msg.msg_iov[0].iov_len) {
+                adv -= msg.msg_iov[0].iov_len;
+                ++msg.msg_iov;
+                --msg.msg_iovlen;
+            }
+            if (msg.msg_iovlen) {
+                msg.msg_iov[0].iov_base = static_cast<uint8_t*>(msg.msg_iov[0].iov_base) + adv;
+                msg.msg_iov[0].iov_len -= adv;
+            }
+        }
+        bytes_ += sizeof(head) + len;
+        return true;
+    }
+
+    bool recvExact(uint8_t* p, size_t n) {
+        while (n) {
+            pollfd pfd{fd_, POLLIN, 0};
+            if (::poll(&pfd, 1, 100) <= 0) return false;
+            const ssize_t r = ::recv(fd_, p, n, 0);
+            if (r <= 0) return false;
+            p += r;
+            n -= size_t(r);
+        }
+        return true;
+    }
+
+    /// 读一个主机命令包；连接出错返回 false。
+    bool readCommand() {
+        uint8_t head[ethernet::kHeaderBytes];
+        ethernet::PacketHeader h;
+        if (!recvExact(head, sizeof(head))) return false;
+        if (!ethernet::decodeHeader(head, h)) {
+            ++bad_commands_;
+            return false;   // 失步，无法再定位包边界
+        }
+        cmd_buf_.resize(h.payload_len);
+        if (h.payload_len && !recvExact(cmd_buf_.data(), h.payload_len)) return false;
+        ++commands_;
+        if (ethernet::packetChecksum(h, ethernet::crc32(cmd_buf_.data(), h.payload_len)) != h.crc ||
+            h.type != uint8_t(ethernet::PacketType::SetFrameRate) || h.payload_len != 2) {
+            ++bad_commands_;
+            return true;
+        }
+        frame_rate_ = unsigned(cmd_buf_[0]) << 8 | cmd_buf_[1];
+        rate_changed_ = true;
+        return true;
+    }
+
+    void sendLoop() {
+        using Clock = std::chrono::steady_clock;
+        auto t0 = Clock::now();
+        uint64_t paced = 0;   // t0 起按节拍计的已发包数 / 字节数
+        size_t next = 0;
+        uint64_t aps_index = 0;
+        while (running_) {
+            pollfd pfd{fd_, POLLIN, 0};
+            if (::poll(&pfd, 1, 0) > 0) {
+                if ((pfd.revents & (POLLERR | POLLHUP)) || !readCommand()) break;
+            }
+            if (rate_changed_) {
+                rate_changed_ = false;
+                t0 = Clock::now();
+                paced = 0;
+            }
+            const auto now = Clock::now();
+            if (!image_.empty()) {
+                const auto due = t0 + std::chrono::duration_cast<Clock::duration>(
+                                          std::chrono::duration<double>(double(aps_index) / cfg_.aps_fps));
+                if (now >= due) {
+                    if (!sendPacket(ethernet::PacketType::Image, image_.data(), image_.size(), image_crc_)) break;
+                    ++images_;
+                    ++aps_index;
+                    continue;
+                }
+            }
+            // 节拍：帧率模式按包数，带宽模式按字节数；超前则睡到应发时刻。
+            double due_s = 0;
+            if (frame_rate_) due_s = double(paced) / double(frame_rate_);
+            else if (cfg_.mb_per_s > 0) due_s = double(paced) / (cfg_.mb_per_s * 1e6);
+            const auto due = t0 + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(due_s));
+            if (due > now) {
+                std::this_thread::sleep_for(std::min<Clock::duration>(due - now, std::chrono::milliseconds(10)));
+                continue;
+            }
+            const Payload& p = payloads_[next];
+            if (!sendPacket(ethernet::PacketType::Event, ring_.data() + p.off, p.len, p.crc)) break;
+            next = (next + 1) % payloads_.size();
+            ++packets_;
+            paced += frame_rate_ ? 1 : ethernet::kHeaderBytes + p.len;
+        }
+        connected_ = false;
+    }
+
+    EthernetStandInConfig  cfg_;
+    int                    fd_ = -1;
+    std::thread            thread_;
+    std::atomic<bool>      running_{false}, connected_{false}, finished_{false}, rate_changed_{false};
+    std::vector<uint8_t>   ring_, image_, cmd_buf_;
+    std::vector<Payload>   payloads_;
+    uint32_t               image_crc_ = 0, seq_ = 0;
+    std::atomic<uint64_t>  packets_{0}, bytes_{0}, images_{0}, commands_{0}, bad_commands_{0};
+    std::atomic<unsigned>  frame_rate_{0};
+};
+
+} // namespace Shimeta::hv
+#endif // SHIMETA_HV_ETHERNET_STANDIN_H
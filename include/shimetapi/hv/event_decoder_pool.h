@@ -0,0 +1,322 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// 解码事件回调：应用原本要自己知道哪个后端配哪个解码器（USB → EVT2、Ethernet → event_fmt、
+// MIPI / MIPI-HVS → apx003 RAW8），并在唯一的回调线程上顺序解码。EventDecoderPool 挂在相机的
+// 帧回调上，按载荷格式选解码内核，在内部线程池上逐包并行解码，按包序交付解码好的事件批。
+// EVT2 / EVT3 的跨包状态由到达线程上的顺序扫描（detail::PacketScanner）给出每包起始状态，
+// 输出与单个解码器顺序解码逐位一致。header-only。
+#ifndef SHIMETA_HV_EVENT_DECODER_POOL_H
+#define SHIMETA_HV_EVENT_DECODER_POOL_H
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <shimetapi/core/event_cd.h>
+#include <shimetapi/core/frame.h>
+#include <shimetapi/core/slab_pool.h>
+#include <shimetapi/hv/camera.h>
+#include <shimetapi/hv/detail/packet_scanner.h>
+#include <shimetapi/hv/detail/worker_pool.h>
+#include <shimetapi/hv/device_config.h>
+#include <shimetapi/hv/stream_stats.h>
+#include <shimetapi/hv/virtual_device.h>
+namespace Shimeta::hv {
+
+/// 一个 EVS 包解出的事件批。批按包序交付，批内事件保持传感器流顺序（EVT 流即时间序）。
+struct DecodedEvents {
+    uint64_t       packet     = 0;         ///< 包序号（从 1 起；被丢弃的包也占号）
+    uint64_t       skipped    = 0;         ///< 与上一批之间被丢弃的包数
+    int64_t        t_begin_ns = 0;         ///< 包的 EVS 参考时间戳（Frame::ts.evs_ts_ns）
+    const EventCD* events     = nullptr;   ///< 回调期间有效
+    size_t         count      = 0;
+    BufferView     raw{};                  ///< 原始载荷（回调期间有效）
+};
+using DecodedEventCallback = std::function<void(const DecodedEvents&)>;
+
+/// 解码池参数。
+struct DecoderPoolOptions {
+    size_t threads = 2;   ///< 解码线程数
+    /// 已到达、尚未交付的包数上限（0 = threads * 2，至少 threads + 1）。在途包持有相机池 slab，
+    /// 应小于 DeviceConfig::buffer_count。
+    size_t max_in_flight = 0;
+    /// 在途包满时：Block 令到达线程等待（背压传到相机，由其 queue_policy 处理）；
+    /// DropOldest 丢弃最早一个尚未开始解码的包（解码状态照常推进，后续包不受影响）。
+    DeviceConfig::QueuePolicy policy = DeviceConfig::QueuePolicy::Block;
+};
+
+/// 解码池统计（自构造起累计）。
+struct DecoderPoolStats {
+    uint64_t       packets   = 0;   ///< 到达的非空 EVS 包
+    uint64_t       delivered = 0;   ///< 已交付的批
+    uint64_t       dropped   = 0;   ///< DropOldest / Close(false) 丢弃的包
+    uint64_t       events    = 0;   ///< 已解码事件
+    uint64_t       bytes     = 0;   ///< 已解码载荷字节
+    size_t         in_flight = 0, max_in_flight = 0;
+    LatencySummary scan;            ///< 到达线程上的状态扫描
+    LatencySummary decode;          ///< 单包解码（线程池上）
+    LatencySummary callback;        ///< 用户回调
+    LatencySummary delivery;        ///< 到达 → 回调开始
+};
+
+/// 后端 → EVS 载荷格式：Usb → EVT2；Mipi / MipiHvs → apx003 RAW8；Ethernet → event_fmt；
+/// Synthetic → synth_mipi_raw8 ? RAW8 : event_fmt。Auto / Replay 取决于探测或文件内容，无法由
+/// 配置得出，返回 false（VirtualCamera 用 device()->evsPayload()）。
+inline bool evsPayloadFor(const DeviceConfig& cfg, EvsPayload& out) {
+    const EvsPayload fmt = cfg.event_fmt == EventFormat::Evt2 ? EvsPayload::Evt2 : EvsPayload::Evt3;
+    switch (cfg.backend) {
+    case Backend::Usb:       out = EvsPayload::Evt2; return true;
+    case Backend::Mipi:
+    case Backend::MipiHvs:   out = EvsPayload::MipiRaw8; return true;
+    case Backend::Ethernet:  out = fmt; return true;
+    case Backend::Synthetic: out = cfg.synth_mipi_raw8 ? EvsPayload::MipiRaw8 : fmt; return true;
+    case Backend::Auto:
+    case Backend::Replay:    break;
+    }
+    return false;
+}
+
+/// 分包并行解码器。Publish 只能由一个线程（相机回调线程）调用；回调在解码线程上串行、按包序
+/// 执行（同一时刻至多一个），不得在回调内调用 Close。相机帧不带 evs_owner 时（视图只在回调
+/// 期间有效）载荷先拷入自有 SlabPool。
+/// 用法：构造 → SetDecodedEventCallback → Attach（StartStream 前）→ 相机 StopStream → Close（或析构）。
+class EventDecoderPool {
+public:
+    using FrameCallback = Camera::FrameCallback;
+
+    explicit EventDecoderPool(EvsPayload payload, DecoderPoolOptions opts = {})
+        : opts_(opts), scanner_(payload) {
+        opts_.threads = std::max<size_t>(opts_.threads, 1);
+        if (!opts_.max_in_flight) opts_.max_in_flight = opts_.threads * 2;
+        // 满时至少有一个包尚未开始解码，DropOldest 才有可丢的包
+        opts_.max_in_flight = std::max(opts_.max_in_flight, opts_.threads + 1);
+        pool_ = std::make_unique<detail::WorkerPool>(opts_.threads);
+    }
+    ~EventDecoderPool() { Close(); }
+    EventDecoderPool(const EventDecoderPool&) = delete;
+    EventDecoderPool& operator=(const EventDecoderPool&) = delete;
+
+    /// 设置解码事件回调（第一次 Publish 之前）。
+    void SetDecodedEventCallback(DecodedEventCallback cb) { cb_ = std::move(cb); }
+
+    /// 占用 cam 的帧回调（StartStream 之前调用）；chained 非空时每帧先交给它再解码。
+    /// Cam 为 Camera 或 VirtualCamera。
+    template <class Cam>
+    void Attach(Cam& cam, FrameCallback chained = nullptr) {
+        chained_ = std::move(chained);
+        cam.SetFrameCallback([this](const Frame& f) {
+            if (chained_) chained_(f);
+            Publish(f);
+        });
+    }
+
+    /// 交来一帧（回调线程调用）：无 EVS 载荷的帧忽略；扫描状态后提交解码。
+    void Publish(const Frame& f) {
+        if (!f.evs.data || !f.evs.size) return;
+        const int64_t t_arrive = nowNs();
+        const detail::PacketStart start = scanner_.advance(f.evs.data, f.evs.size);
+        hist_scan_.record(uint64_t(nowNs() - t_arrive));
+
+        std::shared_ptr<uint8_t[]> owner = f.evs_owner;
+        BufferView raw = f.evs;
+        if (!owner) owner = copyIn(f.evs, raw);
+
+        std::unique_lock<std::mutex> lk(m_);
+        ++packets_;
+        const uint64_t packet = ++seq_;
+        while (!closed_ && in_flight_ >= opts_.max_in_flight) {
+            if (opts_.policy == DeviceConfig::QueuePolicy::DropOldest && !pending_.empty()) {
+                dropOldest();
+                continue;
+            }
+            not_full_.wait(lk);
+        }
+        if (closed_) return;
+        std::unique_ptr<Job> job = takeJob();
+        job->packet = packet;
+        job->t_begin_ns = f.ts.evs_ts_ns;
+        job->t_arrive_ns = t_arrive;
+        job->raw = raw;
+        job->owner = std::move(owner);
+        job->start = start;
+        pending_.push_back(std::move(job));
+        max_in_flight_ = std::max(max_in_flight_, ++in_flight_);
+        lk.unlock();
+        pool_->submit([this] { decodeOne(); });
+    }
+
+    /// 停止接收新包；drain 为 true 时等在途包全部解码、交付完，否则丢弃尚未开始解码的包
+    /// （正在解码的包照常交付）。之后 Publish 直接返回。
+    void Close(bool drain = true) {
+        {
+            std::unique_lock<std::mutex> lk(m_);
+            closed_ = true;
+            if (!drain)
+                while (!pending_.empty()) dropOldest();
+            not_full_.notify_all();
+            idle_.wait(lk, [&] { return in_flight_ == 0 && !delivering_; });
+        }
+        pool_->close();
+    }
+
+    EvsPayload Payload() const { return scanner_.payload(); }
+
+    DecoderPoolStats Stats() const {
+        DecoderPoolStats s;
+        s.scan = hist_scan_.summary();
+        s.decode = hist_decode_.summary();
+        s.callback = hist_callback_.summary();
+        s.delivery = hist_delivery_.summary();
+        s.events = events_.load(std::memory_order_relaxed);
+        s.bytes = bytes_.load(std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lk(m_);
+        s.packets = packets_;
+        s.delivered = delivered_;
+        s.dropped = dropped_;
+        s.in_flight = in_flight_;
+        s.max_in_flight = max_in_flight_;
+        return s;
+    }
+
+private:
+    /// 一个在途包；解码输出区随 Job 复用（只增不缩）。
+    struct Job {
+        uint64_t                   packet = 0;
+        int64_t                    t_begin_ns = 0;
+        int64_t                    t_arrive_ns = 0;
+        BufferView                 raw{};
+        std::shared_ptr<uint8_t[]> owner;
+        detail::PacketStart        start;
+        std::vector<EventCD>       events;
+    };
+
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /// 把载荷拷入自有 slab（仅 Publish 线程访问 copy_pool_）；池耗尽时临时分配。
+    std::shared_ptr<uint8_t[]> copyIn(const BufferView& src, BufferView& dst) {
+        if (!copy_pool_ || copy_pool_->slab_size() < src.size) {
+            const size_t want = std::max(src.size, copy_pool_ ? copy_pool_->slab_size() * 2 : size_t(64) << 10);
+            copy_pool_ = std::make_unique<SlabPool>(want, opts_.max_in_flight + 2);
+        }
+        std::shared_ptr<uint8_t[]> slab = copy_pool_->acquire();
+        if (!slab) slab = std::shared_ptr<uint8_t[]>(new uint8_t[src.size]);
+        std::memcpy(slab.get(), src.data, src.size);
+        dst = BufferView{slab.get(), src.size};
+        return slab;
+    }
+
+    std::unique_ptr<Job> takeJob() {
+        if (free_.empty()) return std::make_unique<Job>();
+        std::unique_ptr<Job> job = std::move(free_.back());
+        free_.pop_back();
+        return job;
+    }
+    void recycle(std::unique_ptr<Job> job) {
+        job->owner.reset();   // 归还 slab
+        job->raw = BufferView{};
+        free_.push_back(std::move(job));
+    }
+
+    /// 丢弃最早一个尚未开始解码的包（持锁调用）：在交付序中留一个空位，由交付方跳过。
+    void dropOldest() {
+        std::unique_ptr<Job> job = std::move(pending_.front());
+        pending_.pop_front();
+        done_.emplace(job->packet, nullptr);
+        recycle(std::move(job));
+        ++dropped_;
+        --in_flight_;
+        not_full_.notify_all();
+        // 空位可能正是下一个待交付的包，而其后各包已解完、不会再有解码任务来推动交付
+        pool_->submit([this] {
+            std::unique_lock<std::mutex> lk(m_);
+            deliverReady(lk);
+        });
+    }
+
+    /// 线程池任务：取最早的待解码包（可能已被 dropOldest 取走，此时无事可做）。
+    void decodeOne() {
+        std::unique_ptr<Job> job;
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            if (pending_.empty()) return;
+            job = std::move(pending_.front());
+            pending_.pop_front();
+        }
+        const int64_t t0 = nowNs();
+        detail::PacketScanner::decode(scanner_.payload(), job->start, job->raw.data, job->raw.size, job->events);
+        hist_decode_.record(uint64_t(nowNs() - t0));
+        events_.fetch_add(job->events.size(), std::memory_order_relaxed);
+        bytes_.fetch_add(job->raw.size, std::memory_order_relaxed);
+        std::unique_lock<std::mutex> lk(m_);
+        const uint64_t packet = job->packet;
+        done_.emplace(packet, std::move(job));
+        deliverReady(lk);
+    }
+
+    /// 按包序交付已解完的包（持锁调用，回调时释放锁）。delivering_ 保证同一时刻只有一个
+    /// 线程在交付：后解完的包只入 done_，由正在交付的线程顺带交付。
+    void deliverReady(std::unique_lock<std::mutex>& lk) {
+        if (delivering_) return;
+        delivering_ = true;
+        for (auto it = done_.begin(); it != done_.end() && it->first == next_; it = done_.begin()) {
+            std::unique_ptr<Job> job = std::move(it->second);
+            done_.erase(it);
+            ++next_;
+            if (!job) continue;   // 已丢弃
+            DecodedEvents batch;
+            batch.packet = job->packet;
+            batch.skipped = job->packet - last_delivered_ - 1;
+            batch.t_begin_ns = job->t_begin_ns;
+            batch.events = job->events.data();
+            batch.count = job->events.size();
+            batch.raw = job->raw;
+            last_delivered_ = job->packet;
+            lk.unlock();
+            const int64_t t_cb = nowNs();
+            hist_delivery_.record(uint64_t(t_cb - job->t_arrive_ns));
+            if (cb_) cb_(batch);
+            hist_callback_.record(uint64_t(nowNs() - t_cb));
+            lk.lock();
+            recycle(std::move(job));
+            ++delivered_;
+            --in_flight_;
+            not_full_.notify_all();
+        }
+        delivering_ = false;
+        idle_.notify_all();
+    }
+
+    DecoderPoolOptions                  opts_;
+    detail::PacketScanner               scanner_;   ///< 仅 Publish 线程访问
+    std::unique_ptr<SlabPool>           copy_pool_;
+    std::unique_ptr<detail::WorkerPool> pool_;
+    DecodedEventCallback                cb_;
+    FrameCallback                       chained_;
+
+    mutable std::mutex                         m_;
+    std::condition_variable                    not_full_, idle_;
+    std::deque<std::unique_ptr<Job>>           pending_;   ///< 待解码（包序）
+    std::map<uint64_t, std::unique_ptr<Job>>   done_;      ///< 已解码 / 已丢弃（空指针），待交付
+    std::vector<std::unique_ptr<Job>>          free_;
+    uint64_t seq_ = 0, next_ = 1, last_delivered_ = 0;
+    uint64_t packets_ = 0, delivered_ = 0, dropped_ = 0;
+    size_t   in_flight_ = 0, max_in_flight_ = 0;
+    bool     closed_ = false, delivering_ = false;
+
+    std::atomic<uint64_t> events_{0}, bytes_{0};
+    LatencyHistogram      hist_scan_, hist_decode_, hist_callback_, hist_delivery_;
+};
+
+} // namespace Shimeta::hv
+#endif // SHIMETA_HV_EVENT_DECODER_POOL_H
@@ -0,0 +1,171 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// 多订阅方分发：DeviceConfig::queue_policy 对整条流生效，同一相机上的无损录制、有损显示与
+// 尽力而为的推理无法各取所需。FrameFanout 挂在相机的帧回调上，每个订阅方有自己的有界队列、
+// 深度与 QueuePolicy 及丢帧计数；各队列持有同一 slab 的引用（零拷贝，最后一个订阅方取走后
+// 归还池）。header-only。
+#ifndef SHIMETA_HV_FRAME_FANOUT_H
+#define SHIMETA_HV_FRAME_FANOUT_H
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <shimetapi/core/frame.h>
+#include <shimetapi/hv/camera.h>
+#include <shimetapi/hv/detail/frame_copy.h>
+#include <shimetapi/hv/detail/frame_queue.h>
+#include <shimetapi/hv/device_config.h>
+namespace Shimeta::hv {
+
+/// 订阅参数。
+struct SubscriberOptions {
+    std::string               name;                                      ///< 仅用于统计输出
+    size_t                    depth  = 4;                                ///< 队列容量（帧）
+    DeviceConfig::QueuePolicy policy = DeviceConfig::QueuePolicy::DropOldest;
+};
+
+/// 一个订阅方的队列。由 FrameFanout::Subscribe 创建；消费线程调用 Pop。
+class Subscription {
+public:
+    explicit Subscription(SubscriberOptions opts) : opts_(std::move(opts)) {
+        opts_.depth = std::max<size_t>(opts_.depth, 1);
+        queue_.configure(opts_.depth, opts_.policy);
+    }
+    Subscription(const Subscription&) = delete;
+    Subscription& operator=(const Subscription&) = delete;
+
+    /// 取下一帧，至多等待 timeout_ms（< 0 无限等待）；超时或已退订返回 false。
+    bool Pop(Frame& frame, int timeout_ms = 1000) {
+        if (!queue_.pop(frame, timeout_ms)) return false;
+        ++popped_;
+        return true;
+    }
+
+    const SubscriberOptions& Options() const { return opts_; }
+    bool     Closed() const { return closed_; }
+    size_t   Pending() const { return queue_.size(); }      ///< 当前排队帧数
+    uint64_t Delivered() const { return delivered_; }        ///< 入队帧数
+    uint64_t Popped() const { return popped_; }              ///< 已取走帧数
+    uint64_t Dropped() const { return queue_.dropped(); }    ///< DropOldest 队满丢弃的帧数
+
+private:
+    friend class FrameFanout;
+
+    void push(const Frame& f) {
+        Frame copy = f;   // 只增加 slab 引用
+        if (queue_.push(std::move(copy))) ++delivered_;
+    }
+    void close() {
+        closed_ = true;
+        queue_.close();
+    }
+
+    SubscriberOptions          opts_;
+    detail::BoundedQueue<Frame> queue_;
+    std::atomic<uint64_t>      delivered_{0}, popped_{0};
+    std::atomic<bool>          closed_{false};
+};
+
+/// 帧分发器。Subscribe / Unsubscribe 可在取流期间任意时刻调用。帧回调线程依次入队：先
+/// DropOldest 订阅方、后 Block 订阅方，慢的无损订阅方令回调线程等待（背压传到相机，由其
+/// queue_policy 处理），不拖延有损订阅方。排队帧占用池 slab：各订阅方深度之和应小于
+/// buffer_count，否则池耗尽时相机按 queue_policy 丢帧或停顿。须在相机 StopStream 之后析构。
+class FrameFanout {
+public:
+    using FrameCallback = Camera::FrameCallback;
+
+    FrameFanout() : subs_(std::make_shared<const SubList>()) {}
+    ~FrameFanout() { Close(); }
+    FrameFanout(const FrameFanout&) = delete;
+    FrameFanout& operator=(const FrameFanout&) = delete;
+
+    /// 占用 cam 的帧回调（StartStream 之前调用）；chained 非空时每帧先交给它再分发。
+    /// Cam 为 Camera 或 VirtualCamera。
+    template <class Cam>
+    void Attach(Cam& cam, FrameCallback chained = nullptr) {
+        chained_ = std::move(chained);
+        cam.SetFrameCallback([this](const Frame& f) {
+            if (chained_) chained_(f);
+            Publish(f);
+        });
+    }
+
+    std::shared_ptr<Subscription> Subscribe(SubscriberOptions opts) {
+        auto sub = std::make_shared<Subscription>(std::move(opts));
+        std::lock_guard<std::mutex> lk(m_);
+        if (closed_) {
+            sub->close();
+            return sub;
+        }
+        auto next = std::make_shared<SubList>(*subs_);
+        // Block 订阅方排在末尾，见类注释
+        auto pos = sub->opts_.policy == DeviceConfig::QueuePolicy::Block
+                       ? next->end()
+                       : std::find_if(next->begin(), next->end(), [](const auto& s) {
+                             return s->opts_.policy == DeviceConfig::QueuePolicy::Block;
+                         });
+        next->insert(pos, sub);
+        subs_ = std::move(next);
+        return sub;
+    }
+
+    /// 退订：关闭其队列（唤醒 Pop 与被它阻塞的回调线程）并丢弃排队帧。
+    void Unsubscribe(const std::shared_ptr<Subscription>& sub) {
+        if (!sub) return;
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            auto next = std::make_shared<SubList>(*subs_);
+            next->erase(std::remove(next->begin(), next->end(), sub), next->end());
+            subs_ = std::move(next);
+        }
+        sub->close();
+    }
+
+    /// 分发一帧（帧回调线程调用）：编号后入各订阅方队列。
+    void Publish(const Frame& f) {
+        std::shared_ptr<const SubList> subs;
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            if (closed_) return;
+            subs = subs_;
+        }
+        Frame copy;
+        detail::copyFrame(copy, f);
+        copy.seq = ++seq_;
+        for (const auto& s : *subs) s->push(copy);
+    }
+
+    /// 关闭全部订阅方；之后 Publish 不再分发。
+    void Close() {
+        std::shared_ptr<const SubList> subs;
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            closed_ = true;
+            subs = std::move(subs_);
+            subs_ = std::make_shared<const SubList>();
+        }
+        for (const auto& s : *subs) s->close();
+    }
+
+    size_t SubscriberCount() const {
+        std::lock_guard<std::mutex> lk(m_);
+        return subs_->size();
+    }
+    uint64_t Published() const { return seq_; }   ///< 已分发帧数（即最近的 Frame::seq）
+
+private:
+    using SubList = std::vector<std::shared_ptr<Subscription>>;
+
+    mutable std::mutex             m_;
+    std::shared_ptr<const SubList> subs_;   ///< 写时复制：Publish 只在锁内取快照
+    std::atomic<uint64_t>          seq_{0};
+    bool                           closed_ = false;
+    FrameCallback                  chained_;
+};
+
+} // namespace Shimeta::hv
+#endif // SHIMETA_HV_FRAME_FANOUT_H
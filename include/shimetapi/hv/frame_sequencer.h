@@ -0,0 +1,89 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// 边沿触发取帧：预编译 Camera::GetFrame 为电平触发（返回最新帧快照、不出队），轮询方须自行去重
+// 并 sleep。FrameSequencer 挂在相机的帧回调上，逐帧编号（Frame::seq）并以条件变量唤醒等待方，
+// WaitForNext 只在出现比 last_seq 更新的帧时返回，并给出其间跳过的帧数。header-only。
+#ifndef SHIMETA_HV_FRAME_SEQUENCER_H
+#define SHIMETA_HV_FRAME_SEQUENCER_H
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <shimetapi/core/frame.h>
+#include <shimetapi/hv/camera.h>
+#include <shimetapi/hv/detail/frame_copy.h>
+namespace Shimeta::hv {
+
+/// 帧序号发布器。只保留最新一帧（持有其 slab 引用）：等待方慢于到达率时，中间的帧不排队，
+/// 计入 WaitForNext 的 skipped。须在相机 StopStream 之后析构（回调引用本对象）。
+class FrameSequencer {
+public:
+    using FrameCallback = Camera::FrameCallback;
+
+    FrameSequencer() = default;
+    FrameSequencer(const FrameSequencer&) = delete;
+    FrameSequencer& operator=(const FrameSequencer&) = delete;
+
+    /// 占用 cam 的帧回调（StartStream 之前调用）；chained 非空时每帧先交给它再发布。
+    /// Cam 为 Camera 或 VirtualCamera。
+    template <class Cam>
+    void Attach(Cam& cam, FrameCallback chained = nullptr) {
+        chained_ = std::move(chained);
+        cam.SetFrameCallback([this](const Frame& f) {
+            if (chained_) chained_(f);
+            Publish(f);
+        });
+    }
+
+    /// 发布一帧（帧回调线程调用）：编号、替换最新帧并唤醒等待方。
+    void Publish(const Frame& f) {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            detail::copyFrame(latest_, f);
+            latest_.seq = ++seq_;
+        }
+        cv_.notify_all();
+    }
+
+    /// 等待 seq > last_seq 的帧，至多 timeout_ms（< 0 无限等待）；超时或 Close 后返回 false。
+    /// skipped 非空时写入 frame.seq - last_seq - 1（last_seq 之后到达、未被本次取到的帧数）。
+    bool WaitForNext(Frame& frame, uint64_t last_seq, int timeout_ms = 1000, uint64_t* skipped = nullptr) {
+        std::unique_lock<std::mutex> lk(m_);
+        const auto ready = [&] { return closed_ || seq_ > last_seq; };
+        if (timeout_ms < 0) cv_.wait(lk, ready);
+        else if (!cv_.wait_for(lk, std::chrono::milliseconds(timeout_ms), ready)) return false;
+        if (closed_ || seq_ <= last_seq) return false;
+        frame = latest_;
+        if (skipped) *skipped = seq_ - last_seq - 1;
+        return true;
+    }
+
+    /// 最近发布的帧序号（0 = 尚无帧）。
+    uint64_t LastSeq() const {
+        std::lock_guard<std::mutex> lk(m_);
+        return seq_;
+    }
+
+    /// 唤醒全部等待方并释放所持最新帧；之后 WaitForNext 立即返回 false。
+    void Close() {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            closed_ = true;
+            latest_.aps_owner.reset();
+            latest_.evs_owner.reset();
+            latest_.aps = latest_.evs = BufferView{};
+        }
+        cv_.notify_all();
+    }
+
+private:
+    mutable std::mutex      m_;
+    std::condition_variable cv_;
+    Frame                   latest_;
+    uint64_t                seq_ = 0;
+    bool                    closed_ = false;
+    FrameCallback           chained_;
+};
+
+} // namespace Shimeta::hv
+#endif // SHIMETA_HV_FRAME_SEQUENCER_H
@@ -0,0 +1,272 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// 回放虚拟设备：按录制时间戳节拍重放 HybridWriter / EventWriter 产出的 EVS .raw 与 APS .avi，
+// 供 VirtualCamera 在无硬件时驱动整条管线（Backend::Replay）。需链接 shimetapi_io。
+#ifndef SHIMETA_HV_REPLAY_DEVICE_H
+#define SHIMETA_HV_REPLAY_DEVICE_H
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <shimetapi/codec/evt2_codec.h>
+#include <shimetapi/codec/evt3_codec.h>
+#include <shimetapi/codec/mipi_raw8_codec.h>
+#include <shimetapi/core/event_batch.h>
+#include <shimetapi/core/frame.h>
+#include <shimetapi/io/event_reader.h>
+#include <shimetapi/io/hybrid_reader.h>
+#include <shimetapi/hv/detail/media_clock.h>
+#include <shimetapi/hv/virtual_device.h>
+namespace Shimeta::hv {
+
+namespace detail {
+
+/// 循环回放的媒体时间展开：每圈把时间轴平移到上一圈末尾之后（间隔取最后一步）。
+struct ReplayTimeline {
+    int64_t offset = 0, first = 0, last = 0, step = 0;
+    size_t  items = 0;   ///< 本圈已出条目数（0 圈不再循环，防空文件死循环）
+
+    int64_t pace(int64_t t_ns) {
+        if (items == 0) first = t_ns;
+        else if (t_ns > last) step = t_ns - last;
+        last = t_ns;
+        ++items;
+        return t_ns + offset;
+    }
+    void rewind() {
+        offset += last - first + std::max<int64_t>(step, 1);
+        items = 0;
+    }
+};
+
+} // namespace detail
+
+/// Backend::Replay 设备。EVS 载荷格式按文件内容识别：首个子帧头有效 → apx003 RAW8
+/// （按 evs_fps 档整包读取），否则按 RAW 头 ev_version 取 EVT2/EVT3（定长块读取）。
+/// 包 / 帧时间戳为录制值（循环回放时每圈重新开始），节拍按 replay_speed 释放。
+class ReplayDevice : public VirtualDevice {
+public:
+    static constexpr size_t kEvtChunkBytes = 64 * 1024;   ///< EVT2/EVT3 回放块（4 字节字对齐）
+
+    Status init(const DeviceConfig& cfg) override {
+        stop();
+        cfg_ = cfg;
+        evs_on_ = !cfg.replay_evs_path.empty();
+        aps_on_ = !cfg.replay_aps_path.empty();
+        evs_line_ = aps_line_ = detail::ReplayTimeline{};
+        evs_last_us_ = 0;
+        aps_index_ = 0;
+        if (!evs_on_ && !aps_on_) return Status::ErrInvalidParam;
+        if (evs_on_) {
+            if (cfg.evs_fps != 0 && evsSubframesPerPacket(cfg.evs_fps) == 0) return Status::ErrInvalidParam;
+            const Status s = probeEvs();
+            if (s != Status::Ok) return s;
+            if (!openEvs()) return Status::ErrDeviceNotFound;
+        }
+        if (aps_on_) {
+            if (!openAps()) return Status::ErrDeviceNotFound;
+            aps_bytes_ = size_t(aps_.width()) * aps_.height() * 3 / 2;
+            aps_period_ns_ = int64_t(1e9 / (aps_.apsFps() > 0 ? aps_.apsFps() : 30.0));
+        }
+        return Status::Ok;
+    }
+
+    /// 预读两路首条目并以其中较早者为媒体时间原点（两路共用墙钟，保持录制时的相对时序）。
+    Status start() override {
+        clock_.reset(cfg_.replay_speed);
+        evs_ended_ = !evs_on_;
+        aps_ended_ = !aps_on_;
+        if (evs_on_ && !evs_pending_) evs_pending_ = nextEvs();
+        if (aps_on_ && !aps_pending_) aps_pending_ = nextAps();
+        if (evs_on_ && !evs_pending_) evs_ended_ = true;
+        if (aps_on_ && !aps_pending_) aps_ended_ = true;
+        if (evs_ended_ && aps_ended_) return Status::ErrDeviceNotFound;
+        int64_t origin = INT64_MAX;
+        if (evs_pending_) origin = evs_pace_ns_;
+        if (aps_pending_ && aps_ts_.valid) origin = std::min(origin, aps_pace_ns_);
+        clock_.anchor(origin == INT64_MAX ? 0 : origin);
+        return Status::Ok;
+    }
+
+    void stop() override { clock_.stop(); }
+
+    bool readEventPacket(EventPacket& pkt, int timeout_ms) override {
+        if (!evs_on_ || evs_ended_) return false;
+        if (!evs_pending_ && !(evs_pending_ = nextEvs())) {
+            evs_ended_ = true;
+            return false;
+        }
+        if (!clock_.waitUntil(evs_pace_ns_, timeout_ms)) return false;
+        pkt = evs_pkt_;
+        evs_pending_ = false;
+        return true;
+    }
+
+    bool readImageFrame(ImageData& img, EvsTimestamp& evs_ts, int timeout_ms) override {
+        if (!aps_on_ || aps_ended_) return false;
+        if (!aps_pending_ && !(aps_pending_ = nextAps())) {
+            aps_ended_ = true;
+            return false;
+        }
+        // 无 tsmp 时间戳的录像按 AVI 帧率从原点起等间隔释放。
+        const int64_t pace = aps_ts_.valid ? aps_pace_ns_ : clock_.origin() + int64_t(aps_index_) * aps_period_ns_;
+        if (!clock_.waitUntil(pace, timeout_ms)) return false;
+        img.pixels = aps_frame_.aps;
+        img.width = aps_frame_.width;
+        img.height = aps_frame_.height;
+        img.format = aps_frame_.format;
+        img.ts = aps_frame_.ts;
+        img.ts.evs_ts_ns = aps_frame_.ts.aps_ts_ns;
+        evs_ts = aps_ts_;
+        aps_pending_ = false;
+        ++aps_index_;
+        return true;
+    }
+
+    bool       hasEvents() const override { return evs_on_; }
+    bool       hasImages() const override { return aps_on_; }
+    bool       eventsEnded() const override { return evs_ended_; }
+    bool       imagesEnded() const override { return aps_ended_; }
+    EvsPayload evsPayload() const override { return payload_; }
+    size_t     maxEventPacketBytes() const override { return evs_chunk_; }
+    size_t     maxImageBytes() const override { return aps_bytes_; }
+
+    /// RAW8 录像返回帧率档；EVT 录像无档位，返回 APS 帧率（取整）。
+    bool getFrameRate(unsigned& fps) const override {
+        if (evs_on_ && payload_ == EvsPayload::MipiRaw8) {
+            fps = cfg_.evs_fps ? cfg_.evs_fps : 240;
+            return true;
+        }
+        if (aps_on_) {
+            fps = unsigned(aps_.apsFps() + 0.5);
+            return true;
+        }
+        fps = 0;
+        return false;
+    }
+
+private:
+    /// 读首块判定 EVS 载荷：连续子帧头有效即 RAW8。
+    Status probeEvs() {
+        io::HybridReader probe;
+        if (!probe.open(cfg_.replay_evs_path, "")) return Status::ErrDeviceNotFound;
+        Frame f;
+        const size_t sub = codec::MipiRaw8Layout::kSubframeBytes;
+        codec::detail::Raw8SubHeader h;
+        if (probe.readEvsPacket(f, 2 * sub) && f.evs.size >= sub && codec::detail::raw8ParseHeader(f.evs.data, h) &&
+            (f.evs.size < 2 * sub || codec::detail::raw8ParseHeader(f.evs.data + sub, h))) {
+            payload_ = EvsPayload::MipiRaw8;
+            evs_chunk_ = size_t(evsSubframesPerPacket(cfg_.evs_fps)) * sub;
+            return Status::Ok;
+        }
+        io::EventReader reader;
+        if (!reader.open(cfg_.replay_evs_path)) return Status::ErrDeviceNotFound;
+        switch (reader.format()) {
+        case io::RawFormat::Evt2: payload_ = EvsPayload::Evt2; break;
+        case io::RawFormat::Evt3: payload_ = EvsPayload::Evt3; break;
+        default: return Status::ErrUnsupportedFormat;
+        }
+        evs_chunk_ = kEvtChunkBytes;
+        return Status::Ok;
+    }
+
+    bool openEvs() {
+        evs_.close();
+        evt2_.Reset();
+        evt3_.Reset();
+        evs_pending_ = false;
+        return evs_.open(cfg_.replay_evs_path, "");
+    }
+    bool openAps() {
+        aps_.close();
+        aps_pending_ = false;
+        return aps_.open("", cfg_.replay_aps_path);
+    }
+
+    /// 读下一包（到尾按需循环），求包内首末事件时间戳。
+    bool nextEvs() {
+        for (int pass = 0; pass < 2; ++pass) {
+            if (evs_.readEvsPacket(evs_frame_, evs_chunk_) &&
+                (payload_ != EvsPayload::MipiRaw8 || evs_frame_.evs.size >= codec::MipiRaw8Layout::kSubframeBytes)) {
+                stampEvs();
+                evs_pace_ns_ = evs_line_.pace(evs_pkt_.t_end_ns);
+                return true;
+            }
+            if (!cfg_.replay_loop || evs_line_.items == 0 || !openEvs()) return false;
+            evs_line_.rewind();
+        }
+        return false;
+    }
+
+    void stampEvs() {
+        const uint8_t* d = evs_frame_.evs.data;
+        const size_t   n = evs_frame_.evs.size;
+        int64_t t0 = evs_last_us_, t1 = evs_last_us_;
+        if (payload_ == EvsPayload::MipiRaw8) {
+            bool any = false;
+            const size_t sub = codec::MipiRaw8Layout::kSubframeBytes;
+            for (size_t off = 0; off + sub <= n; off += sub) {
+                codec::detail::Raw8SubHeader h;
+                if (!codec::detail::raw8ParseHeader(d + off, h)) continue;
+                if (!any) t0 = h.t;
+                t1 = h.t;
+                any = true;
+            }
+        } else {
+            batch_.clear();
+            if (payload_ == EvsPayload::Evt2) evt2_.Decode(d, n, batch_);
+            else evt3_.Decode(d, n, batch_);
+            if (!batch_.empty()) {
+                t0 = batch_.t()[0];
+                t1 = batch_.t()[batch_.size() - 1];
+            }
+        }
+        evs_last_us_ = t1;
+        evs_pkt_.data = evs_frame_.evs;
+        evs_pkt_.t_begin_ns = t0 * 1000;
+        evs_pkt_.t_end_ns = t1 * 1000;
+    }
+
+    bool nextAps() {
+        for (int pass = 0; pass < 2; ++pass) {
+            if (aps_.readApsFrame(aps_frame_, &aps_ts_)) {
+                if (aps_ts_.valid) aps_pace_ns_ = aps_line_.pace(aps_frame_.ts.aps_ts_ns);
+                else ++aps_line_.items;
+                return true;
+            }
+            if (!cfg_.replay_loop || aps_line_.items == 0 || !openAps()) return false;
+            aps_line_.rewind();
+        }
+        return false;
+    }
+
+    DeviceConfig        cfg_;
+    detail::MediaClock  clock_;
+    bool                evs_on_ = false, aps_on_ = false;
+    std::atomic<bool>   evs_ended_{true}, aps_ended_{true};
+
+    // EVS
+    io::HybridReader       evs_;
+    EvsPayload             payload_ = EvsPayload::Evt3;
+    size_t                 evs_chunk_ = kEvtChunkBytes;
+    Frame                  evs_frame_;
+    EventPacket            evs_pkt_;
+    bool                   evs_pending_ = false;
+    int64_t                evs_pace_ns_ = 0, evs_last_us_ = 0;
+    detail::ReplayTimeline evs_line_;
+    codec::Evt2Decoder     evt2_;
+    codec::Evt3Decoder     evt3_;
+    EventBatch             batch_;
+
+    // APS
+    io::HybridReader       aps_;
+    Frame                  aps_frame_;
+    EvsTimestamp           aps_ts_;
+    bool                   aps_pending_ = false;
+    int64_t                aps_pace_ns_ = 0, aps_period_ns_ = 0;
+    uint64_t               aps_index_ = 0;
+    size_t                 aps_bytes_ = 0;
+    detail::ReplayTimeline aps_line_;
+};
+
+} // namespace Shimeta::hv
+#endif // SHIMETA_HV_REPLAY_DEVICE_H
@@ -0,0 +1,138 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// 取帧管线的分阶段统计：无锁延迟直方图（对数-线性分桶，记录一次为两次 relaxed 原子加 + 偶发
+// 的 max CAS）与 VirtualCamera::GetStats 返回的快照结构。常开开销为每阶段一次 steady_clock
+// 读数 + 一次 record。header-only。
+#ifndef SHIMETA_HV_STREAM_STATS_H
+#define SHIMETA_HV_STREAM_STATS_H
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <shimetapi/core/size_class_pool.h>
+#include <shimetapi/core/slab_pool.h>
+namespace Shimeta::hv {
+
+/// 一个线程实际生效的放置与调度（线程启动后自线程内读回）。
+struct ThreadReport {
+    bool        running  = false;   ///< 本次取流是否启动了该线程
+    std::string name;               ///< 实际线程名
+    uint64_t    cpu_mask = 0;       ///< 实际 CPU 亲和位图（前 64 个 CPU）
+    int         policy   = 0;       ///< SCHED_OTHER / SCHED_FIFO / ...
+    int         priority = 0;       ///< 调度优先级（SCHED_OTHER 为 0）
+    int         affinity_errno = 0; ///< 设置亲和失败的 errno（0 = 成功或未请求）
+    int         sched_errno    = 0; ///< 设置 SCHED_FIFO 失败的 errno（如 EPERM：缺 CAP_SYS_NICE）
+};
+
+/// 一个阶段的延迟摘要（微秒）。分位数取所在桶的上界，相对误差 <= 1/8。
+struct LatencySummary {
+    uint64_t count   = 0;
+    double   mean_us = 0;
+    double   p50_us  = 0;
+    double   p99_us  = 0;
+    double   max_us  = 0;
+};
+
+/// 无锁延迟直方图（纳秒）。桶 = 最高位位置 × 8 + 其后 3 位，即每个 2 的幂区间 8 个桶；
+/// 0..7 ns 各占一桶。多线程 record 与 summary 可并发（summary 为近似快照）。
+class LatencyHistogram {
+public:
+    void record(uint64_t ns) {
+        buckets_[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+        sum_ns_.fetch_add(ns, std::memory_order_relaxed);
+        uint64_t cur = max_ns_.load(std::memory_order_relaxed);
+        while (ns > cur && !max_ns_.compare_exchange_weak(cur, ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    LatencySummary summary() const {
+        std::array<uint64_t, kBuckets> snap{};
+        uint64_t total = 0;
+        for (size_t i = 0; i < kBuckets; ++i) total += snap[i] = buckets_[i].load(std::memory_order_relaxed);
+        LatencySummary s;
+        s.count = total;
+        if (!total) return s;
+        s.mean_us = double(sum_ns_.load(std::memory_order_relaxed)) / double(total) / 1e3;
+        s.max_us = double(max_ns_.load(std::memory_order_relaxed)) / 1e3;
+        s.p50_us = std::min(percentile(snap, total, 0.50), s.max_us);
+        s.p99_us = std::min(percentile(snap, total, 0.99), s.max_us);
+        return s;
+    }
+
+    void reset() {
+        for (auto& b : buckets_) b.store(0, std::memory_order_relaxed);
+        sum_ns_.store(0, std::memory_order_relaxed);
+        max_ns_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t kSubBits = 3;
+    static constexpr size_t kBuckets = (64 - kSubBits + 1) << kSubBits;
+
+    static size_t bucketOf(uint64_t ns) {
+        if (ns < (1u << kSubBits)) return size_t(ns);
+        const unsigned msb = 63u - unsigned(__builtin_clzll(ns));
+        const size_t sub = size_t(ns >> (msb - kSubBits)) & ((1u << kSubBits) - 1);
+        return (size_t(msb - kSubBits + 1) << kSubBits) + sub;
+    }
+    /// 桶 i 的上界（含），单位纳秒。
+    static double upperBound(size_t i) {
+        if (i < (1u << kSubBits)) return double(i);
+        const unsigned msb = unsigned(i >> kSubBits) + kSubBits - 1;
+        const double step = double(uint64_t(1) << (msb - kSubBits));
+        return double(uint64_t(1) << msb) + step * double((i & ((1u << kSubBits) - 1)) + 1) - 1;
+    }
+    static double percentile(const std::array<uint64_t, kBuckets>& snap, uint64_t total, double p) {
+        const uint64_t rank = uint64_t(p * double(total - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBuckets; ++i)
+            if ((seen += snap[i]) >= rank) return upperBound(i) / 1e3;
+        return 0;
+    }
+
+    std::array<std::atomic<uint64_t>, kBuckets> buckets_{};
+    std::atomic<uint64_t>                        sum_ns_{0}, max_ns_{0};
+};
+
+/// VirtualCamera::GetStats 的快照（自 StartStream / ResetStats 起累计）。
+struct StreamStats {
+    // 阶段延迟
+    LatencySummary read;       ///< 设备 readEventPacket / readImageFrame 调用（含等待数据）
+    LatencySummary ingest;     ///< 读出 → 入队（取 slab、拷贝、Block 策略下的等待）
+    LatencySummary queue;      ///< 入队 → 出队（GetFrame / 分发线程）
+    LatencySummary callback;   ///< 用户回调（帧 + 事件 / 图像回调合计；合并交付时每批记一次）
+    LatencySummary delivery;   ///< 读出 → 交给用户（GetFrame 返回 / 回调开始）
+
+    // 计数
+    uint64_t evs_packets = 0, evs_bytes = 0;
+    uint64_t aps_frames  = 0, aps_bytes = 0;
+    uint64_t delivered   = 0;   ///< 已交给用户的帧
+    uint64_t batches     = 0;   ///< 交付次数（分发线程唤醒 / GetFrame(s) 返回）；delivered / batches 为平均批大小
+
+    // 丢帧（按原因）
+    uint64_t drop_evs_pool   = 0;   ///< EVS 池耗尽
+    uint64_t drop_aps_pool   = 0;   ///< APS 池耗尽
+    uint64_t drop_queue_full = 0;   ///< 队满（DropOldest）
+    uint64_t drop_oversize   = 0;   ///< 包 / 帧超出设备报告的上限（池 max_request），或设备报 0 却未给出自有缓冲
+
+    // 占用
+    size_t evs_pool_in_use = 0, evs_pool_capacity = 0;   ///< 各尺寸档合计；设备自有缓冲（零拷贝）时为 0
+    size_t aps_pool_in_use = 0, aps_pool_capacity = 0;
+    size_t evs_pool_bytes = 0, aps_pool_bytes = 0;       ///< 已分配 slab 字节（随实际包长 / 帧尺寸增长）
+    std::vector<SizeClassStats> evs_pool_classes, aps_pool_classes;   ///< 各尺寸档统计
+    /// 池压力（各尺寸档合计；设备自有缓冲时 EVS 为设备接收池的）：high_water 为实测所需 slab 数，
+    /// 可据此定 buffer_count / pool_class_slabs；exhausted 为取用时池已空的次数，waits / wait_ns
+    /// 为 Block 策略下等归还的次数与时长（DropOldest 下耗尽即计入 drop_*_pool）
+    SlabPoolStats evs_pool_usage, aps_pool_usage;
+    size_t queue_depth = 0, queue_peak = 0, queue_capacity = 0;
+    /// DeviceConfig::pool_memory 的实际生效情况（设备自有缓冲时 evs_pool_memory 为设备接收池的）
+    SlabMemoryReport evs_pool_memory, aps_pool_memory;
+
+    // 线程放置（DeviceConfig::evs_thread / aps_thread / dispatch_thread 的实际生效值）
+    ThreadReport evs_thread, aps_thread, dispatch_thread;
+};
+
+} // namespace Shimeta::hv
+#endif // SHIMETA_HV_STREAM_STATS_H
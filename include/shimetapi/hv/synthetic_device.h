@@ -0,0 +1,365 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// 合成事件传感器（Backend::Synthetic）：按可控事件率生成移动边缘 / 闪烁 / 均匀噪声 / 突发场景，
+// 以 EVT2 / EVT3 / apx003 RAW8 包输出（可选 NV12 APS），用于压测录像达不到的事件率。
+#ifndef SHIMETA_HV_SYNTHETIC_DEVICE_H
+#define SHIMETA_HV_SYNTHETIC_DEVICE_H
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <shimetapi/codec/detail/evt3_encode.h>
+#include <shimetapi/codec/mipi_raw8_codec.h>
+#include <shimetapi/core/event_cd.h>
+#include <shimetapi/hv/detail/media_clock.h>
+#include <shimetapi/hv/virtual_device.h>
+namespace Shimeta::hv {
+
+namespace detail {
+
+/// xorshift64*：场景生成的热路径随机源（可复现，按 synth_seed 播种）。
+struct SynthRng {
+    uint64_t s;
+    explicit SynthRng(uint64_t seed = 1) : s(seed ? seed * 0x9E3779B97F4A7C15ull : 1) {}
+    uint64_t next() {
+        s ^= s >> 12;
+        s ^= s << 25;
+        s ^= s >> 27;
+        return s * 0x2545F4914F6CDD1Dull;
+    }
+    uint32_t below(uint32_t n) { return uint32_t((uint64_t(uint32_t(next() >> 32)) * n) >> 32); }
+};
+
+/// 场景生成器：在 [t0, t1)（微秒）内生成 n 个时间戳非降序的事件。
+class SynthScene {
+public:
+    static constexpr int     kWidth  = codec::MipiRaw8Layout::kEvsWidth;
+    static constexpr int     kHeight = codec::MipiRaw8Layout::kEvsHeight;
+    static constexpr int     kBars = 4, kBarWidth = 48;     ///< MovingEdges：4 条竖条，每秒横扫一屏
+    static constexpr int64_t kFlickerHalfUs = 5000;         ///< Flicker：100 Hz 亮暗翻转
+    static constexpr int64_t kBurstPeriodUs = 100000;       ///< Burst：每 100 ms 一次 10 ms 突发
+    static constexpr int64_t kBurstUs = 10000;
+    static constexpr double  kBurstLow = 0.1;               ///< 突发外的相对事件率（平均仍为 1）
+
+    SynthScene(DeviceConfig::SynthScene scene, uint64_t seed) : scene_(scene), rng_(seed) {}
+
+    /// [t0, t1) 内相对平均事件率的积分（Burst 以外恒为 t1 - t0）。
+    double weight(int64_t t0, int64_t t1) const {
+        const double span = double(t1 - t0);
+        if (scene_ != DeviceConfig::SynthScene::Burst) return span;
+        const double hi = (1.0 - kBurstLow * double(kBurstPeriodUs - kBurstUs) / double(kBurstPeriodUs)) *
+                          double(kBurstPeriodUs) / double(kBurstUs);
+        return kBurstLow * span + (hi - kBurstLow) * double(burstCovered(t1) - burstCovered(t0));
+    }
+    /// 单位时间相对事件率的峰值（包容量上界用）。
+    double peakWeight() const {
+        return scene_ == DeviceConfig::SynthScene::Burst
+                   ? (1.0 - kBurstLow * double(kBurstPeriodUs - kBurstUs) / double(kBurstPeriodUs)) *
+                         double(kBurstPeriodUs) / double(kBurstUs)
+                   : 1.0;
+    }
+
+    void generate(int64_t t0, int64_t t1, size_t n, std::vector<EventCD>& out) {
+        out.resize(n);
+        const uint64_t span = uint64_t(std::max<int64_t>(t1 - t0, 1));
+        for (size_t i = 0; i < n; ++i) {
+            // t_i = t0 + (i + u) * span / n，u ∈ [0, 1)：单调且区间内近似均匀。
+            const uint64_t u = uint64_t(rng_.below(uint32_t(std::min<uint64_t>(span, 0xFFFFFFFFu))));
+            const int64_t  t = t0 + int64_t((uint64_t(i) * span + u) / n);
+            EventCD& e = out[i];
+            e.t = t;
+            switch (scene_) {
+            case DeviceConfig::SynthScene::MovingEdges: edge(t, e); break;
+            case DeviceConfig::SynthScene::Flicker:     flicker(t, e); break;
+            default:                                    noise(e); break;
+            }
+        }
+    }
+
+private:
+    static int64_t burstCovered(int64_t t) {
+        return (t / kBurstPeriodUs) * kBurstUs + std::min(t % kBurstPeriodUs, kBurstUs);
+    }
+
+    /// 竖条前沿 ON、后沿 OFF，±1 像素抖动。
+    void edge(int64_t t, EventCD& e) {
+        const uint32_t r = uint32_t(rng_.next() >> 32);
+        const int bar = int(r & 3u);
+        const bool lead = (r >> 2) & 1u;
+        const int jitter = int((r >> 3) % 3u) - 1;
+        const int64_t x0 = (int64_t(bar) * kWidth / kBars + t * kWidth / 1000000) % kWidth;
+        int x = int(x0) + (lead ? 0 : -kBarWidth) + jitter;
+        x = ((x % kWidth) + kWidth) % kWidth;
+        e.x = uint16_t(x);
+        e.y = uint16_t(rng_.below(kHeight));
+        e.polarity = lead;
+    }
+    /// 画面中央 1/4 面积的区域，亮半周 ON、暗半周 OFF。
+    void flicker(int64_t t, EventCD& e) {
+        e.x = uint16_t(kWidth / 4 + int(rng_.below(kWidth / 2)));
+        e.y = uint16_t(kHeight / 4 + int(rng_.below(kHeight / 2)));
+        e.polarity = ((t / kFlickerHalfUs) & 1) == 0;
+    }
+    void noise(EventCD& e) {
+        const uint64_t r = rng_.next();
+        e.x = uint16_t((uint64_t(uint32_t(r)) * kWidth) >> 32);
+        e.y = uint16_t(((r >> 32) * kHeight) >> 32);
+        e.polarity = (r >> 31) & 1u;
+    }
+
+    DeviceConfig::SynthScene scene_;
+    SynthRng                 rng_;
+};
+
+/// 有序事件 → EVT2 字（每包先写一个 TIME_HIGH，包可独立解码；时间高位变化时补写）。
+inline void synthEncodeEvt2(const EventCD* e, size_t n, int64_t t0, std::vector<uint8_t>& out) {
+    out.resize((2 * n + 1) * 4);
+    uint32_t* w = reinterpret_cast<uint32_t*>(out.data());
+    size_t k = 0;
+    int64_t th = t0 >> 6;
+    w[k++] = 0x80000000u | uint32_t(th & 0x0FFFFFFF);
+    for (size_t i = 0; i < n; ++i) {
+        if ((e[i].t >> 6) != th) {
+            th = e[i].t >> 6;
+            w[k++] = 0x80000000u | uint32_t(th & 0x0FFFFFFF);
+        }
+        w[k++] = (e[i].polarity ? 0x10000000u : 0u) | (uint32_t(e[i].t & 0x3F) << 22) |
+                 (uint32_t(e[i].x & 0x7FF) << 11) | uint32_t(e[i].y & 0x7FF);
+    }
+    out.resize(k * 4);
+}
+
+/// 有序事件 → EVT3 字：按生成顺序逐事件发 AddrY（行变化时）+ AddrX，不做段内排序与向量合并
+/// （随机场景几乎凑不出连续行程，排序只会拖慢生成）；时间字规则同 Evt3Encoder。
+inline void synthEncodeEvt3(const EventCD* e, size_t n, codec::detail::Evt3EncState& st,
+                            std::vector<uint8_t>& out) {
+    out.clear();
+    codec::detail::Evt3WordWriter w(out);
+    for (size_t i = 0; i < n; ++i) {
+        codec::detail::evt3EmitTime(e[i].t, st, w);
+        w.ensure(2);
+        const uint16_t y = uint16_t(e[i].y & 0x7FF);
+        if (y != st.last_y) {
+            w.put(y);
+            st.last_y = y;
+        }
+        w.put(uint16_t((e[i].polarity ? 0x1800 : 0x1000) | (e[i].x & 0x7FF)));
+    }
+    w.finish();
+}
+
+/// 事件写入一帧的 4 个 RAW8 空间子帧（同像素后到覆盖；子帧头由调用方写）。
+inline void synthRaw8Put(uint8_t* frame, const EventCD& e) {
+    const uint32_t id = uint32_t(((e.y & 1) << 1) | (e.x & 1));
+    const uint32_t xs = e.x >> 1, ys = e.y >> 1;
+    uint8_t* word = frame + id * codec::MipiRaw8Layout::kSubframeBytes + codec::detail::kRaw8HeaderBytes +
+                    (size_t(ys) * codec::detail::kRaw8WordsPerRow + xs / 32) * 8;
+    uint64_t v;
+    std::memcpy(&v, word, 8);
+    const int b = int(2 * (xs % 32));
+    v = (v & ~(3ull << b)) | (uint64_t(e.polarity ? 2 : 1) << b);
+    std::memcpy(word, &v, 8);
+}
+
+inline void synthRaw8Header(uint8_t* sub, int64_t t_us, uint32_t id) {
+    const uint64_t head = (uint64_t(t_us) * 100u << 25) | 0xFFFFu;
+    const uint64_t meta = uint64_t(id) << 44;
+    std::memcpy(sub, &head, 8);
+    std::memcpy(sub + 8, &meta, 8);
+}
+
+} // namespace detail
+
+/// Backend::Synthetic 设备。传感器时间从 0 起；EVT 每 synth_packet_us 一包，RAW8 每包
+/// evs_fps 档整包子帧数（4 子帧 / 帧，帧内事件共享帧时间戳，同像素事件合并）。
+/// 事件流在 synth_duration_ms 处截止：末包只覆盖剩余时长（RAW8 只含时长内的帧）。
+/// 包在其时间区间结束时刻按 synth_speed 节拍释放；<= 0 时以生成速度尽快输出。
+class SyntheticDevice : public VirtualDevice {
+public:
+    static constexpr int kWidth  = detail::SynthScene::kWidth;
+    static constexpr int kHeight = detail::SynthScene::kHeight;
+
+    Status init(const DeviceConfig& cfg) override {
+        stop();
+        cfg_ = cfg;
+        if (!(cfg.synth_mev_per_s >= 0) || cfg.synth_aps_fps < 0) return Status::ErrInvalidParam;
+        scene_ = detail::SynthScene(cfg.synth_scene, cfg.synth_seed);
+        if (cfg.synth_mipi_raw8) {
+            subframes_ = evsSubframesPerPacket(cfg.evs_fps);
+            if (subframes_ == 0) return Status::ErrInvalidParam;
+            payload_ = EvsPayload::MipiRaw8;
+            evs_fps_ = cfg.evs_fps ? cfg.evs_fps : 240;
+            max_evs_bytes_ = size_t(subframes_) * codec::MipiRaw8Layout::kSubframeBytes;
+        } else {
+            if (cfg.synth_packet_us == 0) return Status::ErrInvalidParam;
+            payload_ = cfg.event_fmt == EventFormat::Evt2 ? EvsPayload::Evt2 : EvsPayload::Evt3;
+            const double peak = cfg.synth_mev_per_s * double(cfg.synth_packet_us) * scene_.peakWeight();
+            max_evs_bytes_ = (size_t(std::ceil(peak)) + 2) * 8 + cfg.synth_packet_us / 16 + 64;
+        }
+        max_aps_bytes_ = cfg.synth_aps_fps > 0 ? size_t(kWidth) * kHeight * 3 / 2 : 0;
+        end_us_ = cfg.synth_duration_ms ? int64_t(cfg.synth_duration_ms) * 1000 : INT64_MAX;
+        t_us_ = 0;
+        frame_index_ = aps_index_ = generated_ = 0;
+        carry_ = 0;
+        evs_pending_ = false;
+        enc3_ = codec::detail::Evt3EncState{0xFFFF, 0xFFFFFFFFu, 0};
+        return Status::Ok;
+    }
+
+    Status start() override {
+        clock_.reset(cfg_.synth_speed);
+        clock_.anchor(0);
+        evs_ended_ = t_us_ >= end_us_;
+        aps_ended_ = max_aps_bytes_ == 0;
+        return Status::Ok;
+    }
+
+    void stop() override { clock_.stop(); }
+
+    bool readEventPacket(EventPacket& pkt, int timeout_ms) override {
+        if (evs_ended_) return false;
+        if (!evs_pending_) {
+            if (t_us_ >= end_us_) {
+                evs_ended_ = true;
+                return false;
+            }
+            if (payload_ == EvsPayload::MipiRaw8) renderRaw8();
+            else renderEvt();
+            evs_pending_ = true;
+        }
+        if (!clock_.waitUntil(due_ns_, timeout_ms)) return false;
+        pkt = pkt_;
+        evs_pending_ = false;
+        return true;
+    }
+
+    bool readImageFrame(ImageData& img, EvsTimestamp& evs_ts, int timeout_ms) override {
+        if (aps_ended_) return false;
+        const int64_t t = int64_t(double(aps_index_) * 1e6 / cfg_.synth_aps_fps);
+        if (t >= end_us_) {
+            aps_ended_ = true;
+            return false;
+        }
+        if (!clock_.waitUntil(t * 1000, timeout_ms)) return false;
+        renderAps();
+        img.pixels = BufferView{aps_.data(), aps_.size()};
+        img.width = kWidth;
+        img.height = kHeight;
+        img.format = PixelFormat::NV12;
+        img.ts.aps_ts_ns = img.ts.evs_ts_ns = t * 1000;
+        evs_ts.processed_timestamp = uint64_t(t);
+        evs_ts.raw_timestamp = uint64_t(t) * 200;
+        evs_ts.valid = true;
+        ++aps_index_;
+        return true;
+    }
+
+    bool       hasEvents() const override { return true; }
+    bool       hasImages() const override { return max_aps_bytes_ != 0; }
+    bool       eventsEnded() const override { return evs_ended_; }
+    bool       imagesEnded() const override { return aps_ended_; }
+    EvsPayload evsPayload() const override { return payload_; }
+    size_t     maxEventPacketBytes() const override { return max_evs_bytes_; }
+    size_t     maxImageBytes() const override { return max_aps_bytes_; }
+
+    /// RAW8 返回帧率档，EVT 返回包率；包周期在 Init 时确定，不支持运行中修改。
+    bool getFrameRate(unsigned& fps) const override {
+        fps = payload_ == EvsPayload::MipiRaw8 ? evs_fps_ : unsigned(1000000 / cfg_.synth_packet_us);
+        return true;
+    }
+
+    /// 已生成（含 RAW8 同像素合并前）的事件总数。
+    uint64_t generatedEvents() const { return generated_; }
+
+private:
+    size_t nextCount(int64_t t0, int64_t t1) {
+        carry_ += cfg_.synth_mev_per_s * scene_.weight(t0, t1);   // 1 Mev/s = 1 事件 / 微秒
+        const double n = std::floor(carry_);
+        carry_ -= n;
+        generated_ += uint64_t(n);
+        return size_t(n);
+    }
+
+    void renderEvt() {
+        const int64_t t0 = t_us_, t1 = std::min(t_us_ + int64_t(cfg_.synth_packet_us), end_us_);   // 末包截至时长
+        scene_.generate(t0, t1, nextCount(t0, t1), events_);
+        if (payload_ == EvsPayload::Evt2) {
+            detail::synthEncodeEvt2(events_.data(), events_.size(), t0, buf_);
+        } else {
+            detail::synthEncodeEvt3(events_.data(), events_.size(), enc3_, buf_);
+        }
+        pkt_.data = BufferView{buf_.data(), buf_.size()};
+        pkt_.t_begin_ns = (events_.empty() ? t0 : events_.front().t) * 1000;
+        pkt_.t_end_ns = (events_.empty() ? t0 : events_.back().t) * 1000;
+        due_ns_ = t1 * 1000;
+        t_us_ = t1;
+    }
+
+    int64_t frameTime(uint64_t k) const { return int64_t(double(k) * 1e6 / double(evs_fps_)); }
+
+    void renderRaw8() {
+        const size_t sub = codec::MipiRaw8Layout::kSubframeBytes;
+        int frames = subframes_ / codec::MipiRaw8Layout::kSubFrameNum;
+        while (frames > 1 && frameTime(frame_index_ + uint64_t(frames - 1)) >= end_us_) --frames;   // 末包只含时长内的帧
+        buf_.assign(size_t(frames) * codec::MipiRaw8Layout::kSubFrameNum * sub, 0);
+        int64_t first = 0, last = 0;
+        for (int f = 0; f < frames; ++f) {
+            const int64_t tf = frameTime(frame_index_ + uint64_t(f));
+            const int64_t tn = std::min(frameTime(frame_index_ + uint64_t(f) + 1), end_us_);
+            uint8_t* frame = buf_.data() + size_t(f) * codec::MipiRaw8Layout::kSubFrameNum * sub;
+            for (uint32_t id = 0; id < uint32_t(codec::MipiRaw8Layout::kSubFrameNum); ++id)
+                detail::synthRaw8Header(frame + id * sub, tf, id);
+            scene_.generate(tf, tn, nextCount(tf, tn), events_);
+            for (const EventCD& e : events_) detail::synthRaw8Put(frame, e);
+            if (f == 0) first = tf;
+            last = tf;
+        }
+        frame_index_ += uint64_t(frames);
+        pkt_.data = BufferView{buf_.data(), buf_.size()};
+        pkt_.t_begin_ns = first * 1000;
+        pkt_.t_end_ns = last * 1000;
+        t_us_ = std::min(frameTime(frame_index_), end_us_);
+        due_ns_ = t_us_ * 1000;
+    }
+
+    /// NV12：亮度为随帧横移的斜纹，MovingEdges 的竖条位置叠加为亮条；色度恒 128。
+    void renderAps() {
+        aps_.resize(max_aps_bytes_);
+        const int64_t t = int64_t(double(aps_index_) * 1e6 / cfg_.synth_aps_fps);
+        const int shift = int(aps_index_ * 4);
+        for (int y = 0; y < kHeight; ++y) {
+            uint8_t* row = aps_.data() + size_t(y) * kWidth;
+            for (int x = 0; x < kWidth; ++x) row[x] = uint8_t(((x + y + shift) & 0x7F) + 32);
+        }
+        for (int b = 0; b < detail::SynthScene::kBars; ++b) {
+            const int x0 = int((int64_t(b) * kWidth / detail::SynthScene::kBars + t * kWidth / 1000000) % kWidth);
+            for (int y = 0; y < kHeight; ++y) {
+                uint8_t* row = aps_.data() + size_t(y) * kWidth;
+                for (int i = 0; i < detail::SynthScene::kBarWidth; ++i) row[(x0 - i + kWidth) % kWidth] = 235;
+            }
+        }
+        std::memset(aps_.data() + size_t(kWidth) * kHeight, 128, size_t(kWidth) * kHeight / 2);
+    }
+
+    DeviceConfig         cfg_;
+    detail::MediaClock   clock_;
+    detail::SynthScene   scene_{DeviceConfig::SynthScene::Noise, 1};
+    EvsPayload           payload_ = EvsPayload::Evt3;
+    int                  subframes_ = 0;
+    unsigned             evs_fps_ = 0;
+    size_t               max_evs_bytes_ = 0, max_aps_bytes_ = 0;
+    int64_t              t_us_ = 0, end_us_ = INT64_MAX, due_ns_ = 0;
+    uint64_t             frame_index_ = 0, aps_index_ = 0, generated_ = 0;
+    double               carry_ = 0;
+    bool                 evs_pending_ = false;
+    std::atomic<bool>    evs_ended_{true}, aps_ended_{true};
+    std::vector<EventCD> events_;
+    std::vector<uint8_t> buf_, aps_;
+    EventPacket          pkt_;
+    codec::detail::Evt3EncState enc3_{0xFFFF, 0xFFFFFFFFu, 0};
+};
+
+} // namespace Shimeta::hv
+#endif // SHIMETA_HV_SYNTHETIC_DEVICE_H
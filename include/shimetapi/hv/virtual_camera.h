@@ -0,0 +1,512 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// 宿主侧虚拟相机：与 Camera 同形的 API，数据来自 VirtualDevice（回放 / 合成），无需硬件与驱动。
+// 预编译 Camera 的后端选择在 .so 内，虚拟后端因此由本类承载；应用可把 Camera / VirtualCamera
+// 作为模板参数或各自实例化，取帧 / 回调语义一致。header-only，需链接 shimetapi_io。
+#ifndef SHIMETA_HV_VIRTUAL_CAMERA_H
+#define SHIMETA_HV_VIRTUAL_CAMERA_H
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <shimetapi/core/frame.h>
+#include <shimetapi/core/size_class_pool.h>
+#include <shimetapi/hv/camera.h>
+#include <shimetapi/hv/detail/frame_queue.h>
+#include <shimetapi/hv/detail/thread_placement.h>
+#include <shimetapi/hv/ethernet_device.h>
+#include <shimetapi/hv/event_decoder_pool.h>
+#include <shimetapi/hv/replay_device.h>
+#include <shimetapi/hv/stream_stats.h>
+#include <shimetapi/hv/synthetic_device.h>
+#include <shimetapi/hv/virtual_device.h>
+namespace Shimeta::hv {
+
+/// 按 cfg.backend 构造虚拟设备；Ethernet 为宿主侧批量接收设备，其余实机后端返回 nullptr。
+inline std::unique_ptr<VirtualDevice> createVirtualDevice(const DeviceConfig& cfg) {
+    switch (cfg.backend) {
+    case Backend::Replay:    return std::make_unique<ReplayDevice>();
+    case Backend::Synthetic: return std::make_unique<SyntheticDevice>();
+    case Backend::Ethernet:  return std::make_unique<EthernetDevice>();
+    default:                 return nullptr;
+    }
+}
+
+/// 虚拟相机。EVS 包与 APS 帧各由一个采集线程读出并按实际长度拷入 SizeClassPool slab（每档
+/// 至多 buffer_count + 2 个，全池不超过单一尺寸池的占用；设备经 eventPacketOwner 给出自有缓冲时直接引用、不拷贝），以独立 Frame 交付（不做 APS↔EVS 配对，APS 帧的 aps_evs_ts 取录制值）。
+/// 未设回调时帧进入 GetFrame 队列（容量 buffer_count，满时按 queue_policy）；设了回调
+/// （StartStream 前）则由分发线程按到达顺序调用，GetFrame 不再出帧。各阶段延迟、计数、
+/// 按原因的丢帧与池 / 队列占用常开统计，经 GetStats 读取。三个线程按 DeviceConfig::evs_thread /
+/// aps_thread / dispatch_thread 设置线程名、CPU 亲和与 SCHED_FIFO，实际生效值同样经 GetStats 回报。
+/// SetDecodedEventCallback 按设备的载荷格式（device()->evsPayload()）在内部 EventDecoderPool 上
+/// 并行解码 EVS 包，按包序交付解码好的事件批。DeviceConfig::coalesce_packets > 1 时合并交付：
+/// 分发线程每次唤醒取一批连续帧（SetFrameBatchCallback 一次收到整批），拉取方用 GetFrames。
+class VirtualCamera {
+public:
+    using FrameCallback = Camera::FrameCallback;
+    using EventCallback = Camera::EventCallback;
+    using ImageCallback = Camera::ImageCallback;
+    /// 一批连续帧（frames[0 .. count)，按到达顺序；视图与 slab 引用在回调期间有效）。
+    using FrameBatchCallback = std::function<void(const Frame* frames, size_t count)>;
+    /// 池低水位（evs 区分 EVS / APS 池；slab_size 为触发的尺寸档，available 为该档可取 slab 数）。
+    using PoolLowWatermarkCallback = std::function<void(bool evs, size_t slab_size, size_t available)>;
+
+    VirtualCamera() = default;
+    ~VirtualCamera() { Destroy(); }
+    VirtualCamera(const VirtualCamera&) = delete;
+    VirtualCamera& operator=(const VirtualCamera&) = delete;
+
+    bool Init(const DeviceConfig& cfg) { return Init(cfg, createVirtualDevice(cfg)); }
+
+    /// 使用外部构造的设备（自定义数据源）。
+    bool Init(const DeviceConfig& cfg, std::unique_ptr<VirtualDevice> dev) {
+        Destroy();
+        if (!dev) return false;
+        last_status_ = dev->init(cfg);
+        if (last_status_ != Status::Ok) return false;
+        cfg_ = cfg;
+        dev_ = std::move(dev);
+        if (dev_->hasEvents() && dev_->maxEventPacketBytes() > 0) evs_pool_ = makePool(dev_->maxEventPacketBytes());
+        if (dev_->hasImages()) aps_pool_ = makePool(dev_->maxImageBytes());
+        return true;
+    }
+
+    bool StartStream() {
+        if (!dev_ || running_) return false;
+        queue_.configure(size_t(std::max(cfg_.buffer_count, 1)), cfg_.queue_policy);
+        last_status_ = dev_->start();
+        if (last_status_ != Status::Ok) return false;
+        running_ = true;
+        disp_done_ = false;
+        seq_ = 0;
+        if (evs_pool_) evs_pool_->setLowWatermark(low_mark_, poolLowCallback(true));
+        if (aps_pool_) aps_pool_->setLowWatermark(low_mark_, poolLowCallback(false));
+        evs_pool_drops_ = 0;
+        aps_pool_drops_ = 0;
+        oversize_drops_ = 0;
+        ResetStats();
+        {
+            std::lock_guard<std::mutex> lk(report_mutex_);
+            evs_report_ = aps_report_ = disp_report_ = ThreadReport{};
+        }
+        decoder_.reset();
+        if (decoded_cb_ && dev_->hasEvents()) {
+            decoder_ = std::make_unique<EventDecoderPool>(dev_->evsPayload(), decoder_opts_);
+            decoder_->SetDecodedEventCallback(decoded_cb_);
+        }
+        const bool has_cb = frame_cb_ || event_cb_ || image_cb_ || batch_cb_ || decoder_;
+        producers_ = (dev_->hasEvents() ? 1 : 0) + (dev_->hasImages() ? 1 : 0);
+        dispatching_ = has_cb;
+        if (dev_->hasEvents()) ev_thread_ = std::thread([this] { evLoop(); });
+        if (dev_->hasImages()) img_thread_ = std::thread([this] { imgLoop(); });
+        if (has_cb) disp_thread_ = std::thread([this] { dispLoop(); });
+        return true;
+    }
+
+    void StopStream() {
+        if (!running_) return;
+        running_ = false;
+        dev_->stop();
+        queue_.close();
+        for (std::thread* t : {&ev_thread_, &img_thread_, &disp_thread_})
+            if (t->joinable()) t->join();
+        if (decoder_) decoder_->Close();   // 交付完在途包；保留以供 GetDecoderStats
+        dispatching_ = false;
+        producers_ = 0;
+    }
+
+    void Destroy() {
+        StopStream();
+        decoder_.reset();
+        dev_.reset();
+        evs_pool_.reset();
+        aps_pool_.reset();
+    }
+
+    /// 取下一帧；超时、已停止或回调模式下返回 false。
+    bool GetFrame(Frame& frame, int timeout_ms = 1000) {
+        if (!running_ || dispatching_) return false;
+        Item it;
+        if (!queue_.pop(it, timeout_ms)) return false;
+        noteDequeued(it);
+        batches_.fetch_add(1, std::memory_order_relaxed);
+        frame = std::move(it.frame);
+        return true;
+    }
+
+    /// 取一批连续帧追加到 frames（至多 max(coalesce_packets, 1) 帧，凑批至多等 coalesce_us）；
+    /// 返回帧数，超时、已停止或回调模式下为 0。逐帧唤醒的开销按批摊薄。
+    size_t GetFrames(std::vector<Frame>& frames, int timeout_ms = 1000) {
+        if (!running_ || dispatching_) return 0;
+        std::vector<Item> items;
+        const size_t n = queue_.popBatch(items, batchSize(), batchWait(), timeout_ms);
+        if (!n) return 0;
+        batches_.fetch_add(1, std::memory_order_relaxed);
+        frames.reserve(frames.size() + n);
+        for (Item& it : items) {
+            noteDequeued(it);
+            frames.push_back(std::move(it.frame));
+        }
+        return n;
+    }
+
+    /// 边沿触发取帧（与 FrameSequencer::WaitForNext 同形）。队列本身逐帧出队，即 GetFrame；
+    /// skipped 非空时写入 frame.seq - last_seq - 1（其间队列溢出 / 池耗尽 / 超长丢弃的帧数）。
+    bool WaitForNext(Frame& frame, uint64_t last_seq, int timeout_ms = 1000, uint64_t* skipped = nullptr) {
+        if (!GetFrame(frame, timeout_ms)) return false;
+        if (skipped) *skipped = frame.seq > last_seq ? frame.seq - last_seq - 1 : 0;
+        return true;
+    }
+
+    void SetFrameCallback(FrameCallback cb) { frame_cb_ = std::move(cb); }
+    void SetEventCallback(EventCallback cb) { event_cb_ = std::move(cb); }
+    void SetImageCallback(ImageCallback cb) { image_cb_ = std::move(cb); }
+    /// 批回调（StartStream 前设置）：每批调用一次，先于该批各帧的帧 / 事件 / 图像回调。
+    /// 未开合并时每批一帧。
+    void SetFrameBatchCallback(FrameBatchCallback cb) { batch_cb_ = std::move(cb); }
+    /// 解码事件回调（StartStream 前设置）：在 opts.threads 个解码线程上串行、按包序调用，
+    /// 可与事件 / 帧回调同时使用。StopStream 返回前交付完全部在途包。
+    void SetDecodedEventCallback(DecodedEventCallback cb, DecoderPoolOptions opts = {}) {
+        decoded_cb_ = std::move(cb);
+        decoder_opts_ = opts;
+    }
+
+    /// 池低水位回调（StartStream 前设置）：EVS / APS 池某尺寸档可不等待取到的 slab 数降到 slabs
+    /// 及以下时，在采集线程上调用 cb（各档边沿触发，见 SizeClassPool::setLowWatermark）；可据此
+    /// 在丢帧前调大 buffer_count / pool_class_slabs 或降低数据率。cb 推迟该包 / 帧的入队，不应阻塞。
+    /// 触发次数计入 GetStats 的 evs/aps_pool_usage.low_watermark 与各档 low_watermark。
+    void SetPoolLowWatermark(size_t slabs, PoolLowWatermarkCallback cb) {
+        low_mark_ = slabs;
+        low_cb_ = std::move(cb);
+    }
+
+    bool SetExposure(int) { return false; }   ///< 虚拟设备无曝光控制
+    bool SetFrameRate(unsigned fps) { return dev_ && dev_->setFrameRate(fps); }
+    bool GetFrameRate(unsigned& fps) { return dev_ && dev_->getFrameRate(fps); }
+    bool SyncClock() { return dev_ != nullptr; }   ///< 时间戳来自数据源本身，无需同步
+
+    /// 数据源已读完且已出帧全部被取走（回放非循环模式的结束条件）。
+    bool Ended() const {
+        return running_ && producers_ == 0 && queue_.size() == 0 && (!dispatching_ || disp_done_);
+    }
+    /// 池耗尽、超长与队列溢出丢弃的帧数。
+    uint64_t DroppedFrames() const {
+        return evs_pool_drops_ + aps_pool_drops_ + oversize_drops_ + queue_.dropped();
+    }
+
+    /// 自 StartStream（或 ResetStats）起的统计快照；任意线程、取流期间可调用。
+    StreamStats GetStats() const {
+        StreamStats s;
+        s.read = hist_read_.summary();
+        s.ingest = hist_ingest_.summary();
+        s.queue = hist_queue_.summary();
+        s.callback = hist_callback_.summary();
+        s.delivery = hist_delivery_.summary();
+        s.evs_packets = evs_packets_.load(std::memory_order_relaxed);
+        s.evs_bytes = evs_bytes_.load(std::memory_order_relaxed);
+        s.aps_frames = aps_frames_.load(std::memory_order_relaxed);
+        s.aps_bytes = aps_bytes_.load(std::memory_order_relaxed);
+        s.delivered = delivered_.load(std::memory_order_relaxed);
+        s.batches = batches_.load(std::memory_order_relaxed);
+        s.drop_evs_pool = evs_pool_drops_;
+        s.drop_aps_pool = aps_pool_drops_;
+        s.drop_queue_full = queue_.dropped();
+        s.drop_oversize = oversize_drops_;
+        if (evs_pool_) {
+            s.evs_pool_classes = evs_pool_->stats();
+            s.evs_pool_usage = sumPool(s.evs_pool_classes);
+            s.evs_pool_in_use = s.evs_pool_usage.in_use;
+            s.evs_pool_capacity = s.evs_pool_usage.capacity;
+            s.evs_pool_bytes = evs_pool_->reserved_bytes();
+            s.evs_pool_memory = evs_pool_->memory();
+        } else if (dev_) {
+            s.evs_pool_usage = dev_->eventPoolStats();
+            s.evs_pool_memory = dev_->eventPoolMemory();
+        }
+        if (aps_pool_) {
+            s.aps_pool_classes = aps_pool_->stats();
+            s.aps_pool_usage = sumPool(s.aps_pool_classes);
+            s.aps_pool_in_use = s.aps_pool_usage.in_use;
+            s.aps_pool_capacity = s.aps_pool_usage.capacity;
+            s.aps_pool_bytes = aps_pool_->reserved_bytes();
+            s.aps_pool_memory = aps_pool_->memory();
+        }
+        s.queue_depth = queue_.size();
+        s.queue_peak = queue_.peak();
+        s.queue_capacity = queue_.capacity();
+        std::lock_guard<std::mutex> lk(report_mutex_);
+        s.evs_thread = evs_report_;
+        s.aps_thread = aps_report_;
+        s.dispatch_thread = disp_report_;
+        return s;
+    }
+
+    /// 解码池统计（自最近一次 StartStream 起；未设解码事件回调时为空）。
+    DecoderPoolStats GetDecoderStats() const { return decoder_ ? decoder_->Stats() : DecoderPoolStats{}; }
+
+    /// 清零延迟直方图、计数与池的耗尽 / 等待计数（池占用峰值回到当前占用；丢帧计数与队列峰值
+    /// 随 StartStream 清零）。
+    void ResetStats() {
+        for (LatencyHistogram* h : {&hist_read_, &hist_ingest_, &hist_queue_, &hist_callback_, &hist_delivery_})
+            h->reset();
+        for (std::atomic<uint64_t>* c : {&evs_packets_, &evs_bytes_, &aps_frames_, &aps_bytes_, &delivered_, &batches_})
+            c->store(0, std::memory_order_relaxed);
+        if (evs_pool_) evs_pool_->resetStats();
+        if (aps_pool_) aps_pool_->resetStats();
+        if (dev_) dev_->resetEventPoolStats();
+    }
+    /// 最近一次 Init / StartStream 的设备状态（失败原因）。
+    Status LastStatus() const { return last_status_; }
+    VirtualDevice* device() { return dev_.get(); }
+
+private:
+    struct Item {
+        Frame   frame;
+        bool    is_evs = false;
+        int64_t t_end_ns = 0;
+        int64_t t_read_ns = 0;   ///< 设备读出时刻（steady_clock），统计用
+        int64_t t_enq_ns = 0;    ///< 入队时刻
+    };
+
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /// 线程入口调用：应用放置并记下实际生效值。
+    void placeThread(const DeviceConfig::ThreadPlacement& p, const char* default_name, ThreadReport& out) {
+        ThreadReport r = detail::applyThreadPlacement(p, default_name);
+        std::lock_guard<std::mutex> lk(report_mutex_);
+        out = std::move(r);
+    }
+
+    void noteDequeued(const Item& it) {
+        const int64_t now = nowNs();
+        hist_queue_.record(uint64_t(now - it.t_enq_ns));
+        hist_delivery_.record(uint64_t(now - it.t_read_ns));
+        delivered_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// 各尺寸档合计（max_wait_ns 取最大）。
+    static SlabPoolStats sumPool(const std::vector<SizeClassStats>& classes) {
+        SlabPoolStats p;
+        for (const SizeClassStats& c : classes) {
+            p.in_use += c.in_use;
+            p.capacity += c.capacity;
+            p.high_water += c.high_water;
+            p.exhausted += c.exhausted;
+            p.failed += c.failed;
+            p.waits += c.waits;
+            p.wait_ns += c.wait_ns;
+            p.max_wait_ns = std::max(p.max_wait_ns, c.max_wait_ns);
+            p.low_watermark += c.low_watermark;
+        }
+        return p;
+    }
+
+    /// 按尺寸档取池：每档至多 pool_class_slabs 个（默认 buffer_count + 2），全池不超过 pool_max_bytes
+    /// （默认 pool_class_slabs × 单包 / 帧上限，即单一尺寸池的占用）。各档在耗尽时于采集线程上增长；
+    /// pool_memory 要求预触 / mlock / 大页（要占实际内存）时，Init 即为最高档一次映射满额，
+    /// 这些选项在此生效、StartStream 后不再缺页，较小档借用最高档。
+    std::unique_ptr<SizeClassPool> makePool(size_t max_bytes) const {
+        SizeClassPoolOptions o;
+        o.max_slab = max_bytes;
+        o.class_slabs = cfg_.pool_class_slabs ? size_t(cfg_.pool_class_slabs) : size_t(std::max(cfg_.buffer_count, 1)) + 2;
+        o.grow_slabs = std::max<size_t>(o.class_slabs / 4, 1);
+        o.max_bytes = cfg_.pool_max_bytes ? size_t(cfg_.pool_max_bytes) : o.class_slabs * max_bytes;
+        const SlabPoolOptions& m = cfg_.pool_memory;
+        o.reserve = m.prefault || m.lock || m.hugepages != HugePages::Off;
+        o.memory = m;
+        return std::make_unique<SizeClassPool>(o);
+    }
+
+    std::function<void(size_t, size_t)> poolLowCallback(bool evs) const {
+        if (!low_cb_) return nullptr;
+        return [cb = low_cb_, evs](size_t slab_size, size_t available) { cb(evs, slab_size, available); };
+    }
+
+    /// 池耗尽：Block 策略睡到消费方归还 slab（每 kPollMs 复查 running_），DropOldest 丢弃本条
+    /// （计入 DroppedFrames）。
+    std::shared_ptr<uint8_t[]> acquireSlab(SizeClassPool& pool, size_t bytes, std::atomic<uint64_t>& drops) {
+        const bool block = cfg_.queue_policy == DeviceConfig::QueuePolicy::Block;
+        const auto wait = block ? std::chrono::microseconds(std::chrono::milliseconds(kPollMs))
+                                : std::chrono::microseconds::zero();
+        std::shared_ptr<uint8_t[]> slab = pool.acquire(bytes, wait);
+        while (!slab && block && running_) slab = pool.acquire(bytes, wait);
+        if (!slab) {
+            ++drops;
+            ++seq_;   // 丢弃的帧也占序号，WaitForNext 据此报告 skipped
+        }
+        return slab;
+    }
+
+    /// 包 / 帧超出池的单包 / 帧上限（设备报告的上限偏小）：整条丢弃，不交付截断的载荷。
+    void dropOversize() {
+        ++oversize_drops_;
+        ++seq_;
+    }
+
+    /// 编号与入队在同一把锁内完成，EVS / APS 两路的 seq 与出队顺序一致。
+    void enqueue(Item&& it) {
+        std::lock_guard<std::mutex> lk(enqueue_mutex_);
+        it.frame.frame_id = frame_id_++;
+        it.frame.seq = ++seq_;
+        it.t_enq_ns = nowNs();
+        const int64_t t_read = it.t_read_ns;
+        if (queue_.push(std::move(it))) hist_ingest_.record(uint64_t(nowNs() - t_read));
+    }
+
+    void evLoop() {
+        placeThread(cfg_.evs_thread, "hv-evs", evs_report_);
+        EventPacket pkt;
+        while (running_) {
+            const int64_t t0 = nowNs();
+            if (!dev_->readEventPacket(pkt, kPollMs)) {
+                if (dev_->eventsEnded()) break;
+                continue;
+            }
+            Item it;
+            it.t_read_ns = nowNs();
+            hist_read_.record(uint64_t(it.t_read_ns - t0));
+            evs_packets_.fetch_add(1, std::memory_order_relaxed);
+            evs_bytes_.fetch_add(pkt.data.size, std::memory_order_relaxed);
+            std::shared_ptr<uint8_t[]> slab = dev_->eventPacketOwner();
+            if (slab) {
+                it.frame.evs = pkt.data;   // 视图直接指向设备缓冲（零拷贝）
+            } else {
+                if (!evs_pool_ || pkt.data.size > evs_pool_->max_request()) {
+                    dropOversize();
+                    continue;
+                }
+                if (!(slab = acquireSlab(*evs_pool_, pkt.data.size, evs_pool_drops_))) continue;
+                std::memcpy(slab.get(), pkt.data.data, pkt.data.size);
+                it.frame.evs = BufferView{slab.get(), pkt.data.size};
+            }
+            it.is_evs = true;
+            it.t_end_ns = pkt.t_end_ns;
+            it.frame.evs_owner = std::move(slab);
+            it.frame.ts.evs_ts_ns = pkt.t_begin_ns;
+            enqueue(std::move(it));
+        }
+        --producers_;
+    }
+
+    void imgLoop() {
+        placeThread(cfg_.aps_thread, "hv-aps", aps_report_);
+        ImageData img;
+        EvsTimestamp evs_ts;
+        while (running_) {
+            const int64_t t0 = nowNs();
+            if (!dev_->readImageFrame(img, evs_ts, kPollMs)) {
+                if (dev_->imagesEnded()) break;
+                continue;
+            }
+            Item it;
+            it.t_read_ns = nowNs();
+            hist_read_.record(uint64_t(it.t_read_ns - t0));
+            aps_frames_.fetch_add(1, std::memory_order_relaxed);
+            aps_bytes_.fetch_add(img.pixels.size, std::memory_order_relaxed);
+            if (img.pixels.size > aps_pool_->max_request()) {
+                dropOversize();
+                continue;
+            }
+            std::shared_ptr<uint8_t[]> slab = acquireSlab(*aps_pool_, img.pixels.size, aps_pool_drops_);
+            if (!slab) continue;
+            std::memcpy(slab.get(), img.pixels.data, img.pixels.size);
+            it.frame.aps = BufferView{slab.get(), img.pixels.size};
+            it.frame.aps_owner = std::move(slab);
+            it.frame.ts = img.ts;
+            it.frame.width = img.width;
+            it.frame.height = img.height;
+            it.frame.format = img.format;
+            it.frame.aps_evs_ts = evs_ts;
+            enqueue(std::move(it));
+        }
+        --producers_;
+    }
+
+    void dispLoop() {
+        placeThread(cfg_.dispatch_thread, "hv-disp", disp_report_);
+        std::vector<Item>  items;
+        std::vector<Frame> frames;   // 批回调要连续的 Frame 数组
+        while (running_) {
+            if (!queue_.popBatch(items, batchSize(), batchWait(), kPollMs)) {
+                if (producers_ == 0 && queue_.size() == 0) break;   // 数据源已读完且已分发完
+                continue;
+            }
+            batches_.fetch_add(1, std::memory_order_relaxed);
+            for (Item& it : items) {
+                noteDequeued(it);
+                frames.push_back(std::move(it.frame));
+            }
+            const int64_t t_cb = nowNs();
+            if (batch_cb_) batch_cb_(frames.data(), frames.size());
+            for (size_t i = 0; i < items.size(); ++i) {
+                const Item& it = items[i];
+                const Frame& f = frames[i];
+                if (frame_cb_) frame_cb_(f);
+                if (it.is_evs && decoder_) decoder_->Publish(f);
+                if (it.is_evs && event_cb_) {
+                    EventPacket pkt;
+                    pkt.data = f.evs;
+                    pkt.t_begin_ns = f.ts.evs_ts_ns;
+                    pkt.t_end_ns = it.t_end_ns;
+                    event_cb_(pkt);
+                } else if (!it.is_evs && image_cb_) {
+                    ImageData img;
+                    img.pixels = f.aps;
+                    img.width = f.width;
+                    img.height = f.height;
+                    img.format = f.format;
+                    img.ts = f.ts;
+                    image_cb_(img);
+                }
+            }
+            hist_callback_.record(uint64_t(nowNs() - t_cb));
+            items.clear();
+            frames.clear();   // 回调返回即归还 slab
+        }
+        disp_done_ = true;
+    }
+
+    size_t batchSize() const { return std::max<size_t>(cfg_.coalesce_packets, 1); }
+    std::chrono::microseconds batchWait() const { return std::chrono::microseconds(cfg_.coalesce_us); }
+
+    static constexpr int kPollMs = 100;   ///< 采集 / 分发线程的轮询粒度（StopStream 响应上限）
+
+    DeviceConfig                   cfg_;
+    std::unique_ptr<VirtualDevice> dev_;
+    std::unique_ptr<SizeClassPool> evs_pool_, aps_pool_;
+    detail::BoundedQueue<Item>     queue_;
+    FrameCallback                  frame_cb_;
+    EventCallback                  event_cb_;
+    ImageCallback                  image_cb_;
+    FrameBatchCallback             batch_cb_;
+    DecodedEventCallback           decoded_cb_;
+    DecoderPoolOptions             decoder_opts_;
+    PoolLowWatermarkCallback       low_cb_;
+    size_t                         low_mark_ = 0;
+    std::unique_ptr<EventDecoderPool> decoder_;
+    std::thread                    ev_thread_, img_thread_, disp_thread_;
+    std::atomic<bool>              running_{false}, dispatching_{false}, disp_done_{false};
+    std::atomic<int>               producers_{0}, frame_id_{0};
+    std::atomic<uint64_t>          seq_{0};
+    std::mutex                     enqueue_mutex_;
+    std::atomic<uint64_t>          evs_pool_drops_{0}, aps_pool_drops_{0}, oversize_drops_{0};
+    std::atomic<uint64_t>          evs_packets_{0}, evs_bytes_{0}, aps_frames_{0}, aps_bytes_{0}, delivered_{0};
+    std::atomic<uint64_t>          batches_{0};
+    mutable std::mutex             report_mutex_;
+    ThreadReport                   evs_report_, aps_report_, disp_report_;
+    LatencyHistogram               hist_read_, hist_ingest_, hist_queue_, hist_callback_, hist_delivery_;
+    Status                         last_status_ = Status::Ok;
+};
+
+} // namespace Shimeta::hv
+#endif // SHIMETA_HV_VIRTUAL_CAMERA_H
@@ -0,0 +1,74 @@
+// Copyright 2026 ShiMetaPi. Licensed under the Apache License, Version 2.0.
+// 宿主侧虚拟设备接口：无硬件时（回放 / 合成数据）为 VirtualCamera 供数。
+// 读取语义与 HAL 设备一致：EVS 为原始包字节（同 Backend 的 Frame.evs），APS 为原始像素字节。
+#ifndef SHIMETA_HV_VIRTUAL_DEVICE_H
+#define SHIMETA_HV_VIRTUAL_DEVICE_H
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shimetapi/core/evs_timestamp.h>
+#include <shimetapi/core/slab_pool.h>
+#include <shimetapi/core/status.h>
+#include <shimetapi/hv/device_config.h>
+#include <shimetapi/hv/event_format.h>
+#include <shimetapi/hv/event_packet.h>
+#include <shimetapi/hv/image_data.h>
+namespace Shimeta::hv {
+
+/// MIPI 帧率档 → EVS 整包子帧数（0 = 默认 240 档）；非档位值返回 0。
+inline int evsSubframesPerPacket(unsigned evs_fps) {
+    switch (evs_fps) {
+    case 0:
+    case 240:  return 32;
+    case 120:  return 16;
+    case 300:  return 40;
+    case 500:  return 64;
+    case 750:  return 100;
+    case 1000: return 128;
+    default:   return 0;
+    }
+}
+
+/// EVS 包的载荷格式（决定下游用哪个解码器）。
+enum class EvsPayload { Evt2, Evt3, MipiRaw8 };
+
+/// 虚拟设备。EVS / APS 两路各由一个线程读取（readEventPacket / readImageFrame 可并发调用，
+/// 同一路不可并发）；stop() 可从任意线程调用，令阻塞中的读取尽快返回。
+class VirtualDevice {
+public:
+    virtual ~VirtualDevice() = default;
+
+    virtual Status init(const DeviceConfig& cfg) = 0;
+    virtual Status start() = 0;
+    virtual void   stop() = 0;
+
+    /// 读下一包 EVS。pkt.data 指向设备内部缓冲，有效至本路下一次读取。
+    /// 至多等待 timeout_ms；超时或数据已读完返回 false（用 eventsEnded() 区分）。
+    virtual bool readEventPacket(EventPacket& pkt, int timeout_ms) = 0;
+    /// 读下一帧 APS，语义同 readEventPacket；evs_ts 为该帧的 EVS 传感器时间戳（无则 valid=false）。
+    virtual bool readImageFrame(ImageData& img, EvsTimestamp& evs_ts, int timeout_ms) = 0;
+
+    virtual bool       hasEvents() const = 0;
+    virtual bool       hasImages() const = 0;
+    virtual bool       eventsEnded() const = 0;
+    virtual bool       imagesEnded() const = 0;
+    virtual EvsPayload evsPayload() const = 0;
+    virtual size_t     maxEventPacketBytes() const = 0;  ///< 单包上限（VirtualCamera 按此分配池 slab；
+                                                         ///< 0 = 缓冲由设备自管，见 eventPacketOwner）
+    virtual size_t     maxImageBytes() const = 0;
+
+    /// 最近一次 readEventPacket 交付包所在缓冲的 owner。设备把包读进自有的引用计数缓冲时
+    /// 返回非空，VirtualCamera 直接引用该缓冲出帧而不拷贝；默认 nullptr（拷入 VirtualCamera 的池）。
+    virtual std::shared_ptr<uint8_t[]> eventPacketOwner() { return nullptr; }
+    /// 设备自有 EVS 缓冲池的内存选项生效情况（DeviceConfig::pool_memory）；无自有池返回空报告。
+    virtual SlabMemoryReport eventPoolMemory() const { return {}; }
+    /// 设备自有 EVS 缓冲池的取用统计（耗尽 / 等待 / 占用峰值）；无自有池返回空统计。
+    virtual SlabPoolStats eventPoolStats() const { return {}; }
+    virtual void resetEventPoolStats() {}
+
+    virtual bool setFrameRate(unsigned) { return false; }
+    virtual bool getFrameRate(unsigned& fps) const { fps = 0; return false; }
+};
+
+} // namespace Shimeta::hv
+#endif // SHIMETA_HV_VIRTUAL_DEVICE_H
@@ -0,0 +1,234 @@
+// bench_ethernet: 以太网接收路径基准（Backend::Ethernet + 相机替身，回环，无需相机）。
+//   ./hv_sample_bench_ethernet [--mbps N] [--packet-bytes N] [--seconds S] [--port P]
+//                              [--aps-fps N] [--fps N] [--batched] [--external]
+//                              [--evs-cpu N] [--fifo P] [--load N]
+//   (默认: 尽快, 64 KiB/包, 5 s, 端口 8888)
+//   --mbps N     : 替身事件包带宽 MB/s（0 = 尽快）
+//   --aps-fps N  : 替身另发 NV12 Image 包（主机端跳过，只占带宽）
+//   --fps N      : 第 1 秒后调用 Camera::SetFrameRate(N)，替身改按 N 包/秒发送（验证命令通路）
+//   --batched    : 改用 VirtualCamera + EthernetDevice（大块 recv、零拷贝切包），另打印每包系统调用
+//                  数、搬移字节与各阶段延迟（GetStats）；默认为预编译 Camera 的逐包接收
+//   --external   : 不起进程内替身，等待外部 hv_sample_eth_standin 连入（可跨机）
+//   --evs-cpu N  : （--batched）EVS 采集线程绑定到 CPU N
+//   --fifo P     : （--batched）EVS 采集线程以 SCHED_FIFO 优先级 P 运行（需 CAP_SYS_NICE）
+//   --load N     : 另起 N 个忙等线程模拟满载（对比放置前后的 read / delivery 延迟）
+// Camera 在 127.0.0.1:port（--external 时 INADDR_ANY）监听，替身连入推送带 CRC 的事件包；主线程以
+// WaitForNext 边沿触发取包（Camera 经 FrameSequencer，VirtualCamera 直接出队），其间未取到的包计为 skipped。
+// 每秒打印 pkt/s、MB/s 与单包延迟（取到时刻 - 替身发送时刻，同机系统时钟），结束时打印
+// 延迟 p50 / p99 / max 与替身侧统计。
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <shimetapi/hv/camera.h>
+#include <shimetapi/hv/ethernet_standin.h>
+#include <shimetapi/hv/frame_sequencer.h>
+#include <shimetapi/hv/virtual_camera.h>
+
+using Clock = std::chrono::steady_clock;
+using namespace Shimeta;
+
+namespace {
+
+int64_t wallNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+double percentile(std::vector<double>& v, double p) {
+    if (v.empty()) return 0;
+    const size_t k = std::min(v.size() - 1, size_t(p * double(v.size())));
+    std::nth_element(v.begin(), v.begin() + std::ptrdiff_t(k), v.end());
+    return v[k];
+}
+
+struct Totals {
+    uint64_t packets = 0, bytes = 0, skipped = 0;
+};
+
+struct Options {
+    double   seconds = 5;
+    unsigned fps = 0;
+    bool     external = false;
+};
+
+// 取帧到时长结束（或进程内替身退出），每秒打印一行；返回总计与全部延迟样本。
+// src 提供 WaitForNext（FrameSequencer 或 VirtualCamera），cam 用于 SetFrameRate。
+template <class Cam, class Source>
+Totals pollFrames(Cam& cam, Source& src, const hv::EthernetStandIn& standin, const Options& o,
+                  std::vector<double>& lat_all, double& elapsed) {
+    Totals win, all;
+    std::vector<double> lat_win;
+    uint64_t last_seq = 0;
+    bool fps_sent = o.fps == 0;
+    const auto start = Clock::now();
+    auto tick = start;
+    Frame f;
+    while (true) {
+        const auto now = Clock::now();
+        const double el_total = std::chrono::duration<double>(now - start).count();
+        if (el_total >= o.seconds || (!o.external && standin.finished())) break;
+        if (!fps_sent && el_total >= 1.0) {
+            fps_sent = true;
+            std::printf("  SetFrameRate(%u): %s\n", o.fps, cam.SetFrameRate(o.fps) ? "ok" : "failed");
+        }
+        uint64_t skipped = 0;
+        if (src.WaitForNext(f, last_seq, 100, &skipped)) {
+            last_seq = f.seq;
+            win.skipped += skipped;
+        }
+        if (f.evs.size) {
+            const double lat_ms = double(wallNs() - f.ts.evs_ts_ns) / 1e6;
+            ++win.packets;
+            win.bytes += f.evs.size;
+            lat_win.push_back(lat_ms);
+        }
+        f = Frame{};   // 归还 slab
+        const double el = std::chrono::duration<double>(now - tick).count();
+        if (el >= 1.0) {
+            std::printf("  %8.1f pkt/s %9.2f MB/s | latency p50 %.3f ms p99 %.3f ms%s\n", double(win.packets) / el,
+                        double(win.bytes) / el / 1e6, percentile(lat_win, 0.50), percentile(lat_win, 0.99),
+                        win.packets ? "" : " (no packets)");
+            all.packets += win.packets;
+            all.bytes += win.bytes;
+            all.skipped += win.skipped;
+            lat_all.insert(lat_all.end(), lat_win.begin(), lat_win.end());
+            win = Totals{};
+            lat_win.clear();
+            tick = now;
+        }
+    }
+    all.packets += win.packets;
+    all.bytes += win.bytes;
+    all.skipped += win.skipped;
+    lat_all.insert(lat_all.end(), lat_win.begin(), lat_win.end());
+    elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    return all;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    hv::EthernetStandInConfig sc;
+    Options o;
+    bool batched = false;
+    int evs_cpu = -1, fifo = 0;
+    unsigned load = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--mbps") == 0 && i + 1 < argc) sc.mb_per_s = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--packet-bytes") == 0 && i + 1 < argc) sc.packet_bytes = size_t(std::atol(argv[++i]));
+        else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) o.seconds = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--port") == 0 && i + 1 < argc) sc.port = uint16_t(std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--aps-fps") == 0 && i + 1 < argc) sc.aps_fps = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc) o.fps = unsigned(std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--batched") == 0) batched = true;
+        else if (std::strcmp(argv[i], "--external") == 0) o.external = true;
+        else if (std::strcmp(argv[i], "--evs-cpu") == 0 && i + 1 < argc) evs_cpu = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--fifo") == 0 && i + 1 < argc) fifo = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--load") == 0 && i + 1 < argc) load = unsigned(std::atoi(argv[++i]));
+        else {
+            std::printf("usage: %s [--mbps N] [--packet-bytes N] [--seconds S] [--port P] [--aps-fps N] [--fps N] "
+                        "[--batched] [--external] [--evs-cpu N] [--fifo P] [--load N]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (o.seconds <= 0) o.seconds = 5;
+
+    hv::DeviceConfig cfg;
+    cfg.backend = hv::Backend::Ethernet;
+    cfg.bind_ip = o.external ? "" : sc.host;
+    cfg.listen_port = sc.port;
+    if (evs_cpu >= 0 && evs_cpu < 64) cfg.evs_thread.cpu_mask = uint64_t(1) << evs_cpu;
+    cfg.evs_thread.priority = fifo;
+    hv::FrameSequencer seq;   // 先于 Camera 构造、后于其析构（帧回调引用 seq）
+    hv::Camera cam;
+    hv::VirtualCamera vcam;
+    if (!(batched ? vcam.Init(cfg) : cam.Init(cfg))) {
+        std::fprintf(stderr, "bench_ethernet: Init failed.\n");
+        return 1;
+    }
+    hv::EthernetStandIn standin;
+    if (!o.external && !standin.start(sc)) {
+        std::fprintf(stderr, "bench_ethernet: invalid stand-in config.\n");
+        return 1;
+    }
+    char source[128] = "external stand-in";
+    if (!o.external) {
+        char rate[32] = "max";
+        if (sc.mb_per_s > 0) std::snprintf(rate, sizeof(rate), "%g MB/s", sc.mb_per_s);
+        std::snprintf(source, sizeof(source), "in-process stand-in, %s, %zu B/packet", rate, sc.packet_bytes);
+    }
+    std::printf("bench_ethernet: %s, port %u, %s, %.1f s\n", batched ? "batched zero-copy receive" : "Camera",
+                unsigned(sc.port), source, o.seconds);
+    if (!batched) seq.Attach(cam);
+    if (!(batched ? vcam.StartStream() : cam.StartStream())) {   // 等待替身连入（上限 30 s）
+        std::fprintf(stderr, "bench_ethernet: StartStream failed (no stand-in connected).\n");
+        return 1;
+    }
+
+    std::atomic<bool> loading(true);
+    std::vector<std::thread> burners;
+    for (unsigned i = 0; i < load; ++i)
+        burners.emplace_back([&] {
+            volatile uint64_t x = 0;
+            while (loading.load(std::memory_order_relaxed)) x = x + 1;
+        });
+    std::vector<double> lat_all;
+    lat_all.reserve(1 << 20);
+    double el = 0;
+    const Totals all = batched ? pollFrames(vcam, vcam, standin, o, lat_all, el)
+                               : pollFrames(cam, seq, standin, o, lat_all, el);
+    loading = false;
+    for (std::thread& t : burners) t.join();
+    if (batched) vcam.StopStream();
+    else cam.StopStream();
+    standin.stop();
+
+    const double lat_max = lat_all.empty() ? 0 : *std::max_element(lat_all.begin(), lat_all.end());
+    std::printf("bench_ethernet: %llu packets, %.2f MB in %.2f s (%.1f pkt/s, %.2f MB/s), skipped %llu\n",
+                (unsigned long long)all.packets, double(all.bytes) / 1e6, el, double(all.packets) / el,
+                double(all.bytes) / el / 1e6, (unsigned long long)all.skipped);
+    std::printf("bench_ethernet: latency p50 %.3f ms, p99 %.3f ms, max %.3f ms\n", percentile(lat_all, 0.50),
+                percentile(lat_all, 0.99), lat_max);
+    if (batched) {
+        const auto* dev = static_cast<const hv::EthernetDevice*>(vcam.device());
+        const double pkts = double(std::max<uint64_t>(dev->packetsReceived(), 1));
+        std::printf("bench_ethernet: received %llu packets, %.3f syscalls/packet, %.1f copied B/packet, "
+                    "dropped %llu, crc errors %llu, seq gaps %llu\n",
+                    (unsigned long long)dev->packetsReceived(), double(dev->recvSyscalls()) / pkts,
+                    double(dev->copiedBytes()) / pkts, (unsigned long long)vcam.DroppedFrames(),
+                    (unsigned long long)dev->crcErrors(), (unsigned long long)dev->seqGaps());
+        const hv::StreamStats st = vcam.GetStats();
+        const std::pair<const char*, const hv::LatencySummary*> stages[] = {
+            {"read", &st.read}, {"ingest", &st.ingest}, {"queue", &st.queue}, {"delivery", &st.delivery}};
+        for (const auto& [name, s] : stages)
+            std::printf("bench_ethernet:   stage %-8s p50 %9.1f us  p99 %9.1f us  max %9.1f us  (%llu)\n", name,
+                        s->p50_us, s->p99_us, s->max_us, (unsigned long long)s->count);
+        std::printf("bench_ethernet:   queue peak %zu / %zu, drops: pool %llu, queue full %llu\n", st.queue_peak,
+                    st.queue_capacity, (unsigned long long)st.drop_evs_pool, (unsigned long long)st.drop_queue_full);
+        const hv::ThreadReport& t = st.evs_thread;
+        std::printf("bench_ethernet:   thread %s: cpus 0x%llx, %s prio %d%s%s\n", t.name.c_str(),
+                    (unsigned long long)t.cpu_mask, t.policy == SCHED_FIFO ? "SCHED_FIFO" : "SCHED_OTHER", t.priority,
+                    t.affinity_errno ? " (affinity failed)" : "", t.sched_errno ? " (SCHED_FIFO failed)" : "");
+    }
+    if (!o.external) {
+        const uint64_t sent = standin.packetsSent();
+        std::printf("bench_ethernet: stand-in sent %llu event + %llu image packets (%.2f MB/s), "
+                    "not delivered %llu, commands %llu (bad %llu), fps %u\n",
+                    (unsigned long long)sent, (unsigned long long)standin.imagesSent(),
+                    double(standin.bytesSent()) / el / 1e6,
+                    (unsigned long long)(sent > all.packets ? sent - all.packets : 0),
+                    (unsigned long long)standin.commandsReceived(), (unsigned long long)standin.badCommands(),
+                    standin.frameRate());
+    }
+    if (batched) vcam.Destroy();
+    else cam.Destroy();
+    return 0;
+}
@@ -0,0 +1,162 @@
+// bench_evt3_encode: offline EVT3 encode bench (no camera needed).
+//   ./hv_sample_bench_evt3_encode [frames] [density]
+//   (default: 500, 0.01)
+// Synthesizes three event streams at the 1000 fps tier (one timestamp per 1 ms frame):
+//   edges     : moving horizontal edge segments (same-row runs of neighbouring pixels)
+//   subframes : the same kind of edges in MipiRaw8Decoder output order (4 interleaved
+//               spatial subframes per frame) -- the RAW8 -> EVT3 transcode case
+//   noise     : scattered background activity, no spatial structure
+// and times Evt3Encoder::Encode (one AddrX per event) against
+// Evt3Encoder::EncodeVector (VectBaseX + Vect12/Vect8 for same-row runs).
+// Prints bytes/event and encode Mev/s; every output is decoded with Evt3Decoder and
+// checked to reproduce the input events (order within one timestamp may differ).
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <shimetapi/core/event_cd.h>
+#include <shimetapi/codec/evt3_codec.h>
+
+using Clock = std::chrono::steady_clock;
+using Shimeta::EventCD;
+
+namespace {
+
+constexpr int kWidth = 768;
+constexpr int kHeight = 608;
+
+EventCD makeEvent(int x, int y, int64_t t, bool p) {
+    EventCD e;
+    e.x = uint16_t(x);
+    e.y = uint16_t(y);
+    e.t = t;
+    e.polarity = p;
+    return e;
+}
+
+std::vector<EventCD> makeEdges(int frames, double density, std::mt19937& rng) {
+    std::vector<EventCD> ev;
+    const int segments = std::max(1, int(density * kWidth * kHeight / 24));
+    for (int f = 0; f < frames; ++f) {
+        const int64_t t = 1000 + int64_t(f) * 1000;
+        for (int s = 0; s < segments; ++s) {
+            const int y = int(rng() % kHeight);
+            const int x = int(rng() % kWidth);
+            const int len = 4 + int(rng() % 40);
+            const bool p = rng() & 1;
+            for (int i = 0; i < len && x + i < kWidth; ++i) ev.push_back(makeEvent(x + i, y, t, p));
+        }
+    }
+    return ev;
+}
+
+// 同一批边缘按 MipiRaw8Decoder 的输出顺序重排：帧内先按空间子帧 id = (y & 1) << 1 | (x & 1)，
+// 子帧内按行、行内按 x。
+std::vector<EventCD> makeSubframes(int frames, double density, std::mt19937& rng) {
+    std::vector<EventCD> ev = makeEdges(frames, density, rng);
+    auto order = [](const EventCD& e) {
+        const uint32_t id = uint32_t(((e.y & 1) << 1) | (e.x & 1));
+        return (id << 24) | (uint32_t(e.y) << 12) | e.x;
+    };
+    for (size_t i = 0; i < ev.size();) {
+        size_t j = i;
+        while (j < ev.size() && ev[j].t == ev[i].t) ++j;
+        std::sort(ev.begin() + std::ptrdiff_t(i), ev.begin() + std::ptrdiff_t(j),
+                  [&](const EventCD& l, const EventCD& r) { return order(l) < order(r); });
+        i = j;
+    }
+    return ev;
+}
+
+std::vector<EventCD> makeNoise(int frames, double density, std::mt19937& rng) {
+    std::vector<EventCD> ev;
+    const int per_frame = std::max(1, int(density * kWidth * kHeight));
+    for (int f = 0; f < frames; ++f) {
+        const int64_t t = 1000 + int64_t(f) * 1000;
+        for (int i = 0; i < per_frame; ++i)
+            ev.push_back(makeEvent(int(rng() % kWidth), int(rng() % kHeight), t, rng() & 1));
+    }
+    return ev;
+}
+
+// 同一时间戳内顺序无关：按 (t, y, x, polarity) 排序后比较。
+bool sameEvents(std::vector<EventCD> a, std::vector<EventCD> b) {
+    if (a.size() != b.size()) return false;
+    auto less = [](const EventCD& l, const EventCD& r) {
+        if (l.t != r.t) return l.t < r.t;
+        if (l.y != r.y) return l.y < r.y;
+        if (l.x != r.x) return l.x < r.x;
+        return l.polarity < r.polarity;
+    };
+    std::sort(a.begin(), a.end(), less);
+    std::sort(b.begin(), b.end(), less);
+    for (size_t i = 0; i < a.size(); ++i)
+        if (a[i].x != b[i].x || a[i].y != b[i].y || a[i].t != b[i].t || a[i].polarity != b[i].polarity)
+            return false;
+    return true;
+}
+
+// 按 1 帧一批编码（与录制路径一致），返回 Mev/s。
+template <class EncodeFn>
+double encodeMevs(const std::vector<EventCD>& ev, std::vector<uint8_t>& out, EncodeFn&& encode) {
+    Shimeta::codec::Evt3Encoder enc;
+    out.clear();
+    auto t0 = Clock::now();
+    size_t i = 0;
+    while (i < ev.size()) {
+        size_t j = i;
+        while (j < ev.size() && ev[j].t == ev[i].t) ++j;
+        encode(enc, ev.data() + i, j - i, out);
+        i = j;
+    }
+    const double el = std::chrono::duration<double>(Clock::now() - t0).count();
+    return el > 0 ? double(ev.size()) / el / 1e6 : 0.0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int frames = 500;
+    double density = 0.01;
+    if (argc > 1) frames = std::atoi(argv[1]);
+    if (argc > 2) density = std::atof(argv[2]);
+    if (frames <= 0) frames = 500;
+    std::printf("bench_evt3_encode: %d frames @1000fps, density %.3f\n", frames, density);
+
+    std::mt19937 rng(1000);
+    struct Workload { const char* name; std::vector<EventCD> events; };
+    Workload workloads[] = {
+        {"edges", makeEdges(frames, density, rng)},
+        {"subframes", makeSubframes(frames, density, rng)},
+        {"noise", makeNoise(frames, density, rng)},
+    };
+
+    bool ok = true;
+    std::vector<uint8_t> scalar_out, vector_out;
+    std::printf("\n%-10s %10s | %-22s | %-22s | %s\n", "stream", "events", "Encode  B/ev   Mev/s",
+                "EncodeVector B/ev Mev/s", "size");
+    for (const Workload& w : workloads) {
+        if (w.events.empty()) continue;
+        const double n = double(w.events.size());
+        const double scalar_mevs = encodeMevs(w.events, scalar_out,
+            [](auto& enc, const EventCD* e, size_t c, std::vector<uint8_t>& o) { enc.Encode(e, c, o); });
+        const double vector_mevs = encodeMevs(w.events, vector_out,
+            [](auto& enc, const EventCD* e, size_t c, std::vector<uint8_t>& o) { enc.EncodeVector(e, c, o); });
+
+        std::vector<EventCD> decoded;
+        Shimeta::codec::Evt3Decoder dec;
+        dec.Decode(vector_out.data(), vector_out.size(), decoded);
+        const bool match = sameEvents(w.events, decoded);
+        ok = ok && match;
+        std::printf("%-10s %10zu | %6.3f %14.1f | %6.3f %14.1f | %5.1f%%%s\n", w.name, w.events.size(),
+                    double(scalar_out.size()) / n, scalar_mevs, double(vector_out.size()) / n, vector_mevs,
+                    100.0 * double(vector_out.size()) / double(scalar_out.size()),
+                    match ? "" : "  MISMATCH");
+    }
+    std::printf("\nbench_evt3_encode: %s\n", ok ? "all EncodeVector outputs decode to the input" : "MISMATCH");
+    return ok ? 0 : 1;
+}
@@ -45,7 +45,7 @@ int main(int argc, char** argv) {
     uint64_t total_ev = 0;
     int frames = 0, aps_frames = 0;
     codec::Evt2Decoder dec;
-    std::vector<EventCD> out;
+    std::vector<EventCD> out;   // 按 MaxEventsForBytes 只增不缩，稳态解码无堆分配
     auto t0 = Clock::now();
     while (true) {
         if (std::chrono::duration_cast<std::chrono::seconds>(Clock::now() - t0).count() >= dur) break;
@@ -53,8 +53,9 @@ int main(int argc, char** argv) {
         if (!cam.GetFrame(f, 1000)) continue;
         ++frames;
         if (f.evs.size > 0) {
-            out.clear();
-            total_ev += dec.Decode(f.evs.data, f.evs.size, out);
+            const size_t need = codec::Evt2Decoder::MaxEventsForBytes(f.evs.size);
+            if (out.size() < need) out.resize(need);
+            total_ev += dec.Decode(f.evs.data, f.evs.size, out.data(), out.size()).events;
         }
         if (f.aps.size > 0) ++aps_frames;
     }
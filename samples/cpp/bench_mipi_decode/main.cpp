@@ -0,0 +1,123 @@
+// bench_mipi_decode: offline apx003 RAW8 decode bench (no camera needed).
+//   ./hv_sample_bench_mipi_decode [max_workers] [density] [packets]
+//   (default: hardware threads, 0.05, 200)
+// Synthesizes full MIPI packets for every evs_fps tier (16..128 subframes/packet)
+// with <density> of pixels firing, then times MipiRaw8Decoder (sequential) and
+// MipiRaw8Decoder::DecodeBatch (single-core bitmap scan) and
+// MipiRaw8ParallelDecoder with 1..max_workers workers. Prints packets/s, Mev/s,
+// speedup vs. sequential and headroom vs. the tier's real-time packet rate.
+// Every parallel result is checked against the sequential output.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <shimetapi/core/event_cd.h>
+#include <shimetapi/codec/mipi_raw8_codec.h>
+#include <shimetapi/codec/mipi_raw8_parallel.h>
+
+using Clock = std::chrono::steady_clock;
+using Shimeta::codec::MipiRaw8Layout;
+
+namespace {
+
+struct Tier { int fps; int subframes; };
+const Tier kTiers[] = {{120, 16}, {240, 32}, {300, 40}, {500, 64}, {750, 100}, {1000, 128}};
+
+// 一个整包：每子帧 16 字节头（0xFFFF 标记 + 时间戳 + 子帧 id）+ 304×12 个 64-bit 像素字。
+std::vector<uint8_t> makePacket(int subframes, double density, uint32_t seed) {
+    std::vector<uint8_t> pkt(size_t(subframes) * MipiRaw8Layout::kSubframeBytes, 0);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    for (int s = 0; s < subframes; ++s) {
+        uint8_t* p = pkt.data() + size_t(s) * MipiRaw8Layout::kSubframeBytes;
+        const uint64_t ts = uint64_t(1000000 + s * 250) * 100;   // 微秒 × 100
+        const uint64_t head = (ts << 25) | 0xFFFFu;
+        const uint64_t id = uint64_t(s % MipiRaw8Layout::kSubFrameNum) << 44;
+        std::memcpy(p, &head, 8);
+        std::memcpy(p + 8, &id, 8);
+        uint8_t* px = p + 16;
+        for (int i = 0; i < 304 * 12; ++i) {
+            uint64_t word = 0;
+            for (int k = 0; k < 32; ++k)
+                if (u(rng) < density) word |= uint64_t(1 + (rng() % 3)) << (2 * k);
+            std::memcpy(px + 8 * i, &word, 8);
+        }
+    }
+    return pkt;
+}
+
+bool same(const std::vector<Shimeta::EventCD>& a, const std::vector<Shimeta::EventCD>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i)
+        if (a[i].x != b[i].x || a[i].y != b[i].y || a[i].t != b[i].t || a[i].polarity != b[i].polarity)
+            return false;
+    return true;
+}
+
+template <class Dec>
+double packetsPerSec(Dec& dec, const std::vector<uint8_t>& pkt, int packets,
+                     std::vector<Shimeta::EventCD>& out) {
+    dec.Decode(pkt.data(), pkt.size(), out);   // 预热（输出区扩容）
+    auto t0 = Clock::now();
+    for (int i = 0; i < packets; ++i) dec.Decode(pkt.data(), pkt.size(), out);
+    double el = std::chrono::duration<double>(Clock::now() - t0).count();
+    return el > 0 ? packets / el : 0.0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int max_workers = int(std::thread::hardware_concurrency());
+    double density = 0.05;
+    int packets = 200;
+    if (argc > 1) max_workers = std::atoi(argv[1]);
+    if (argc > 2) density = std::atof(argv[2]);
+    if (argc > 3) packets = std::atoi(argv[3]);
+    if (max_workers <= 0) max_workers = 1;
+    if (packets <= 0) packets = 200;
+    std::printf("bench_mipi_decode: density %.3f, %d packets/run, 1..%d workers\n",
+                density, packets, max_workers);
+
+    bool ok = true;
+    for (const Tier& tier : kTiers) {
+        auto pkt = makePacket(tier.subframes, density, uint32_t(tier.fps));
+        std::vector<Shimeta::EventCD> ref, out;
+        Shimeta::codec::MipiRaw8Decoder seq;
+        const double seq_pps = packetsPerSec(seq, pkt, packets, ref);
+        const double ev = double(ref.size());
+        // 实时包率：每包 subframes/4 帧
+        const double need = double(tier.fps) * MipiRaw8Layout::kSubFrameNum / tier.subframes;
+        std::printf("\n%4d fps (%3d subframes/pkt, %.0f ev/pkt, need %.1f pkt/s)\n",
+                    tier.fps, tier.subframes, ev, need);
+        std::printf("  sequential : %8.1f pkt/s %8.2f Mev/s  headroom %5.2fx\n",
+                    seq_pps, seq_pps * ev / 1e6, seq_pps / need);
+        struct BitmapScan {   // 单核位图扫描（DecodeBatch）
+            Shimeta::codec::MipiRaw8Decoder dec;
+            size_t Decode(const uint8_t* d, size_t n, std::vector<Shimeta::EventCD>& o) {
+                return dec.DecodeBatch(d, n, o);
+            }
+        } scan;
+        const double scan_pps = packetsPerSec(scan, pkt, packets, out);
+        const bool scan_match = same(ref, out);
+        ok = ok && scan_match;
+        std::printf("  bitmap scan: %8.1f pkt/s %8.2f Mev/s  x%5.2f  headroom %5.2fx%s\n",
+                    scan_pps, scan_pps * ev / 1e6, scan_pps / seq_pps, scan_pps / need,
+                    scan_match ? "" : "  MISMATCH");
+        for (int w = 1; w <= max_workers; ++w) {
+            Shimeta::codec::MipiRaw8ParallelDecoder par(w);
+            const double pps = packetsPerSec(par, pkt, packets, out);
+            const bool match = same(ref, out);
+            ok = ok && match;
+            std::printf("  %2d worker%s : %8.1f pkt/s %8.2f Mev/s  x%5.2f  headroom %5.2fx%s\n",
+                        w, w == 1 ? " " : "s", pps, pps * ev / 1e6, pps / seq_pps, pps / need,
+                        match ? "" : "  MISMATCH");
+        }
+    }
+    std::printf("\nbench_mipi_decode: %s\n", ok ? "all parallel outputs match sequential" : "MISMATCH");
+    return ok ? 0 : 1;
+}
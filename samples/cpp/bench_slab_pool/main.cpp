@@ -0,0 +1,230 @@
+// bench_slab_pool: 多线程下 BufferPool（预编译，空闲表加锁）与 SlabPool（无锁 Treiber 栈 + 每线程缓存）
+// 的取还吞吐（无需硬件）。
+//   ./hv_sample_bench_slab_pool [--ms N] [--threads N] [--slabs N] [--slab-bytes N] [--hold N]
+//   (默认: 每轮 500 ms, 线程数 1 / 2 / 4 / 8 / 16, 1024 个 4 KiB slab, 每线程同时持有 4 个)
+// 两种取还模式：
+//   local   — 每个线程取 hold 个 slab、各写首字节、再全部释放（同线程取还）；
+//   handoff — 线程两两配对，生产方取 slab 经 SPSC 环交给消费方释放（采集线程取、分发线程还）。
+// 打印每秒取还对数（百万）与 SlabPool / BufferPool 之比；local 模式另测 SlabPool::acquireRef
+// （侵入式 SlabRef，独占释放无原子读改写）。
+// 最后按 SlabPoolOptions 各建一个 --touch-slabs × --touch-bytes 的池（默认 16 × 4 MiB，即 1000 fps 档
+// 单包上限），打印构造耗时、首遍写满全池的耗时（缺页开销）与各选项的实际生效情况。
+//   ./hv_sample_bench_slab_pool [--touch-slabs N] [--touch-bytes N]
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <shimetapi/core/buffer_pool.h>
+#include <shimetapi/core/slab_pool.h>
+
+using namespace Shimeta;
+
+namespace {
+
+struct Options {
+    int    ms = 500;
+    int    max_threads = 16;
+    size_t slabs = 1024;
+    size_t slab_bytes = 4096;
+    int    hold = 4;
+    size_t touch_slabs = 16;
+    size_t touch_bytes = size_t(4) << 20;
+};
+
+using Slab = std::shared_ptr<uint8_t[]>;
+
+/// 以 SlabRef 取还的 SlabPool（runLocal 的第三列）。
+struct RefPool : SlabPool {
+    using SlabPool::SlabPool;
+    SlabRef acquire() { return acquireRef(); }
+};
+
+/// 单生产者单消费者环（handoff 模式的交接通道）。
+class SpscRing {
+public:
+    bool push(Slab& s) {
+        const size_t t = tail_.load(std::memory_order_relaxed);
+        if (t - head_.load(std::memory_order_acquire) == kSize) return false;
+        slots_[t % kSize] = std::move(s);
+        tail_.store(t + 1, std::memory_order_release);
+        return true;
+    }
+    bool pop(Slab& s) {
+        const size_t h = head_.load(std::memory_order_relaxed);
+        if (h == tail_.load(std::memory_order_acquire)) return false;
+        s = std::move(slots_[h % kSize]);
+        head_.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static constexpr size_t kSize = 64;
+    Slab                     slots_[kSize];
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+};
+
+template <class Pool, class Handle = Slab>
+double runLocal(const Options& o, int threads) {
+    Pool pool(o.slab_bytes, o.slabs);
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> ops{0};
+    std::vector<std::thread> th;
+    for (int t = 0; t < threads; ++t) {
+        th.emplace_back([&] {
+            std::vector<Handle> held(size_t(o.hold));
+            uint64_t n = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                for (Handle& s : held)
+                    if ((s = pool.acquire())) s[0] = uint8_t(n);
+                for (Handle& s : held)
+                    if (s) {
+                        s.reset();
+                        ++n;
+                    }
+            }
+            ops += n;
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(o.ms));
+    stop = true;
+    for (std::thread& t : th) t.join();
+    return double(ops) / (o.ms / 1e3);
+}
+
+template <class Pool>
+double runHandoff(const Options& o, int threads) {
+    Pool pool(o.slab_bytes, o.slabs);
+    const int pairs = std::max(threads / 2, 1);
+    std::vector<std::unique_ptr<SpscRing>> rings;
+    for (int p = 0; p < pairs; ++p) rings.push_back(std::make_unique<SpscRing>());
+    std::atomic<bool> stop{false};
+    std::atomic<int> producers{pairs};
+    std::atomic<uint64_t> ops{0};
+    std::vector<std::thread> th;
+    for (int p = 0; p < pairs; ++p) {
+        SpscRing& ring = *rings[size_t(p)];
+        th.emplace_back([&] {
+            uint64_t n = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                Slab s = pool.acquire();
+                if (!s) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                s[0] = uint8_t(n++);
+                while (!ring.push(s) && !stop.load(std::memory_order_relaxed)) std::this_thread::yield();
+            }
+            --producers;
+        });
+        th.emplace_back([&] {
+            uint64_t n = 0;
+            Slab s;
+            for (;;) {
+                if (ring.pop(s)) {
+                    s.reset();
+                    ++n;
+                } else if (producers.load() == 0) {
+                    break;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            ops += n;
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(o.ms));
+    stop = true;
+    for (std::thread& t : th) t.join();
+    return double(ops) / (o.ms / 1e3);
+}
+
+void report(const char* mode, int threads, double locked, double lockfree, double ref = 0) {
+    std::printf("  %-7s %2d threads | BufferPool %8.2f Mops/s | SlabPool %8.2f Mops/s | x%.2f", mode, threads,
+                locked / 1e6, lockfree / 1e6, locked > 0 ? lockfree / locked : 0.0);
+    if (ref > 0) std::printf(" | SlabRef %8.2f Mops/s | x%.2f", ref / 1e6, locked > 0 ? ref / locked : 0.0);
+    std::printf("\n");
+}
+
+/// 取空整池并逐页写一遍（StartStream 后的首轮取用），返回毫秒。
+double firstTouch(SlabPool& pool) {
+    std::vector<Slab> held;
+    held.reserve(pool.capacity());
+    const auto t0 = std::chrono::steady_clock::now();
+    while (Slab s = pool.acquire()) {
+        for (size_t off = 0; off < pool.slab_size(); off += 4096) s[off] = 1;
+        held.push_back(std::move(s));
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+void runTouch(const Options& o) {
+    struct Case {
+        const char*     name;
+        SlabPoolOptions opts;
+    };
+    SlabPoolOptions prefault, thp, hugetlb, locked;
+    prefault.prefault = true;
+    thp.hugepages = HugePages::Transparent;
+    thp.prefault = true;
+    hugetlb.hugepages = HugePages::Explicit;
+    hugetlb.prefault = true;
+    locked.lock = true;
+    const Case cases[] = {{"default", {}}, {"prefault", prefault}, {"thp", thp}, {"hugetlb", hugetlb}, {"mlock", locked}};
+    std::printf("first touch: %zu x %zu B slabs\n", o.touch_slabs, o.touch_bytes);
+    for (const Case& c : cases) {
+        const auto t0 = std::chrono::steady_clock::now();
+        SlabPool pool(o.touch_bytes, o.touch_slabs, c.opts);
+        const double build_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        const double touch_ms = firstTouch(pool);
+        const SlabMemoryReport& m = pool.memory();
+        std::printf("  %-8s | construct %8.2f ms | first touch %8.2f ms | page %7zu KiB, hugetlb %d (errno %d), "
+                    "thp %d (%zu MiB), prefaulted %d, locked %d (errno %d)\n",
+                    c.name, build_ms, touch_ms, m.page_size >> 10, m.hugetlb, m.hugetlb_errno, m.thp_advised,
+                    m.thp_bytes >> 20, m.prefaulted, m.locked, m.lock_errno);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options o;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--ms") == 0 && i + 1 < argc) o.ms = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) o.max_threads = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--slabs") == 0 && i + 1 < argc) o.slabs = size_t(std::atoll(argv[++i]));
+        else if (std::strcmp(argv[i], "--slab-bytes") == 0 && i + 1 < argc) o.slab_bytes = size_t(std::atoll(argv[++i]));
+        else if (std::strcmp(argv[i], "--hold") == 0 && i + 1 < argc) o.hold = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--touch-slabs") == 0 && i + 1 < argc) o.touch_slabs = size_t(std::atoll(argv[++i]));
+        else if (std::strcmp(argv[i], "--touch-bytes") == 0 && i + 1 < argc) o.touch_bytes = size_t(std::atoll(argv[++i]));
+        else {
+            std::printf("usage: %s [--ms N] [--threads N] [--slabs N] [--slab-bytes N] [--hold N] "
+                        "[--touch-slabs N] [--touch-bytes N]\n",
+                        argv[0]);
+            return 1;
+        }
+    }
+    o.ms = std::max(o.ms, 10);
+    o.max_threads = std::max(o.max_threads, 1);
+    o.slabs = std::max<size_t>(o.slabs, 1);
+    o.slab_bytes = std::max<size_t>(o.slab_bytes, 1);
+    o.hold = std::max(o.hold, 1);
+    o.touch_bytes = std::max<size_t>(o.touch_bytes, 1);
+    std::printf("bench_slab_pool: %zu x %zu B slabs, hold %d, %d ms per round, %u hardware threads, "
+                "SlabPool thread cache %zu\n",
+                o.slabs, o.slab_bytes, o.hold, o.ms, std::thread::hardware_concurrency(),
+                SlabPool(o.slab_bytes, o.slabs).thread_cache_size());
+    for (int t = 1; t <= o.max_threads; t *= 2)
+        report("local", t, runLocal<BufferPool>(o, t), runLocal<SlabPool>(o, t), runLocal<RefPool, SlabRef>(o, t));
+    for (int t = 2; t <= o.max_threads; t *= 2)
+        report("handoff", t, runHandoff<BufferPool>(o, t), runHandoff<SlabPool>(o, t));
+    runTouch(o);
+    return 0;
+}
@@ -0,0 +1,182 @@
+// bench_synthetic: 合成事件源压测取帧管线（Backend::Synthetic + VirtualCamera，无需硬件）。
+//   ./hv_sample_bench_synthetic [--evt2|--evt3|--raw8] [--scene edges|flicker|noise|burst] [--seconds S]
+//   (默认: EVT3, noise, 每点 0.5 s)
+// 1) 生成上限：SyntheticDevice 单独尽快出包，测场景生成 + 编码的 Mev/s（压测读数的天花板）。
+// 2) 饱和扫描：事件率从 1 Mev/s 起按 2 倍递增，按实时节拍经 VirtualCamera 出帧，主线程
+//    GetFrame 并用对应解码器解出事件计数；两种 QueuePolicy × 若干 buffer_count 各扫一遍。
+//    按墙钟计的生成吞吐低于目标 95%（Block 下采集被反压）或出现丢帧即判定饱和，
+//    打印该组合可持续的最高事件率。
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <shimetapi/codec/evt2_codec.h>
+#include <shimetapi/codec/evt3_codec.h>
+#include <shimetapi/codec/mipi_raw8_codec.h>
+#include <shimetapi/core/event_batch.h>
+#include <shimetapi/hv/virtual_camera.h>
+
+using Clock = std::chrono::steady_clock;
+using namespace Shimeta;
+using Policy = hv::DeviceConfig::QueuePolicy;
+
+namespace {
+
+constexpr double kStartMev = 1.0;
+constexpr int    kMaxSteps = 12;          // 1 → 2048 Mev/s
+constexpr double kSustained = 0.95;       // 交付率 / 目标率低于此即饱和
+constexpr int    kBufferCounts[] = {2, 4, 8};
+
+// 按载荷格式解码一包，返回事件数（EVT 解码器跨包保持时间基）。
+struct EventCounter {
+    hv::EvsPayload         payload;
+    codec::Evt2Decoder     evt2;
+    codec::Evt3Decoder     evt3;
+    codec::MipiRaw8Decoder raw8;
+    EventBatch             batch;
+
+    size_t count(const BufferView& v) {
+        batch.clear();
+        switch (payload) {
+        case hv::EvsPayload::Evt2:     evt2.Decode(v.data, v.size, batch); break;
+        case hv::EvsPayload::Evt3:     evt3.Decode(v.data, v.size, batch); break;
+        case hv::EvsPayload::MipiRaw8: raw8.Decode(v.data, v.size, batch); break;
+        }
+        return batch.size();
+    }
+};
+
+struct Point {
+    double   generated_mev = 0, delivered_mev = 0, mb_s = 0;
+    uint64_t drops = 0;
+    double   late_mean_ms = 0, late_max_ms = 0;
+};
+
+const char* payloadName(hv::EvsPayload p) {
+    switch (p) {
+    case hv::EvsPayload::Evt2:     return "EVT2";
+    case hv::EvsPayload::Evt3:     return "EVT3";
+    case hv::EvsPayload::MipiRaw8: return "apx003 RAW8";
+    }
+    return "?";
+}
+
+// 设备单独尽快出包：生成 + 编码的上限。
+double generatorCeiling(hv::DeviceConfig cfg, double seconds) {
+    cfg.synth_mev_per_s = 100.0;
+    cfg.synth_speed = 0;
+    cfg.synth_duration_ms = uint32_t(seconds * 1000);
+    hv::SyntheticDevice dev;
+    if (dev.init(cfg) != Status::Ok || dev.start() != Status::Ok) return 0;
+    hv::EventPacket pkt;
+    const auto t0 = Clock::now();
+    while (dev.readEventPacket(pkt, 100)) {
+    }
+    const double el = std::chrono::duration<double>(Clock::now() - t0).count();
+    return el > 0 ? double(dev.generatedEvents()) / el / 1e6 : 0;
+}
+
+// 实时节拍下跑一个 (事件率, 策略, buffer_count) 点。RAW8 的交付按合并后的解码事件计，
+// 故以生成计数（合并前）作目标对照。
+bool runPoint(hv::DeviceConfig cfg, double mev, double seconds, Point& p) {
+    cfg.synth_mev_per_s = mev;
+    cfg.synth_speed = 1.0;
+    cfg.synth_duration_ms = uint32_t(seconds * 1000);
+    hv::VirtualCamera cam;
+    if (!cam.Init(cfg) || !cam.StartStream()) return false;
+    auto* dev = static_cast<hv::SyntheticDevice*>(cam.device());
+    EventCounter counter{dev->evsPayload(), {}, {}, {}, {}};
+    uint64_t events = 0, bytes = 0, late_n = 0;
+    double late_sum = 0, last_ms = 0;   // last_ms：末包到达时刻（GetFrame 的尾部超时不计入）
+    const auto wall0 = Clock::now();
+    Frame f;
+    while (!cam.Ended()) {
+        if (!cam.GetFrame(f, 100)) continue;
+        if (f.evs.size) {
+            events += counter.count(f.evs);
+            bytes += f.evs.size;
+            // 包在其时间区间结束时应到；以包首时间戳近似，滞后含一个包周期。
+            const double due_ms = double(f.ts.evs_ts_ns) / 1e6;
+            last_ms = std::chrono::duration<double, std::milli>(Clock::now() - wall0).count();
+            const double late = last_ms - due_ms;
+            p.late_max_ms = std::max(p.late_max_ms, late);
+            late_sum += late;
+            ++late_n;
+        }
+        f = Frame{};   // 归还 slab
+    }
+    p.drops = cam.DroppedFrames();
+    cam.StopStream();
+    const double span = std::max(last_ms / 1e3, seconds);
+    p.generated_mev = double(dev->generatedEvents()) / span / 1e6;
+    p.delivered_mev = double(events) / span / 1e6;
+    p.mb_s = double(bytes) / span / 1e6;
+    p.late_mean_ms = late_n ? late_sum / double(late_n) : 0;
+    cam.Destroy();
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    hv::DeviceConfig cfg;
+    cfg.backend = hv::Backend::Synthetic;
+    cfg.synth_scene = hv::DeviceConfig::SynthScene::Noise;
+    double seconds = 0.5;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--evt2") == 0) cfg.event_fmt = hv::EventFormat::Evt2;
+        else if (std::strcmp(argv[i], "--evt3") == 0) cfg.event_fmt = hv::EventFormat::Evt3;
+        else if (std::strcmp(argv[i], "--raw8") == 0) cfg.synth_mipi_raw8 = true;
+        else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) seconds = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--scene") == 0 && i + 1 < argc) {
+            const char* s = argv[++i];
+            if (std::strcmp(s, "edges") == 0) cfg.synth_scene = hv::DeviceConfig::SynthScene::MovingEdges;
+            else if (std::strcmp(s, "flicker") == 0) cfg.synth_scene = hv::DeviceConfig::SynthScene::Flicker;
+            else if (std::strcmp(s, "burst") == 0) cfg.synth_scene = hv::DeviceConfig::SynthScene::Burst;
+            else cfg.synth_scene = hv::DeviceConfig::SynthScene::Noise;
+        } else {
+            std::printf("usage: %s [--evt2|--evt3|--raw8] [--scene edges|flicker|noise|burst] [--seconds S]\n",
+                        argv[0]);
+            return 1;
+        }
+    }
+    if (seconds <= 0) seconds = 0.5;
+
+    hv::SyntheticDevice probe;
+    if (probe.init(cfg) != Status::Ok) {
+        std::printf("bench_synthetic: invalid config\n");
+        return 1;
+    }
+    std::printf("bench_synthetic: %s, %.2f s per point\n", payloadName(probe.evsPayload()), seconds);
+    std::printf("generator ceiling (device only, ASAP): %.1f Mev/s\n\n", generatorCeiling(cfg, seconds));
+
+    std::printf("%-11s %4s %9s %9s %9s %9s %7s %9s %9s\n", "policy", "bufs", "target", "gen", "delivered",
+                "MB/s", "drops", "late_avg", "late_max");
+    for (Policy policy : {Policy::DropOldest, Policy::Block}) {
+        for (int bufs : kBufferCounts) {
+            cfg.queue_policy = policy;
+            cfg.buffer_count = bufs;
+            double sustained = 0;
+            double mev = kStartMev;
+            for (int step = 0; step < kMaxSteps; ++step, mev *= 2) {
+                Point p;
+                if (!runPoint(cfg, mev, seconds, p)) {
+                    std::printf("bench_synthetic: start failed at %.0f Mev/s\n", mev);
+                    return 1;
+                }
+                const bool ok = p.drops == 0 && p.generated_mev >= kSustained * mev;
+                std::printf("%-11s %4d %9.1f %9.1f %9.1f %9.1f %7llu %7.2fms %7.2fms%s\n",
+                            policy == Policy::Block ? "Block" : "DropOldest", bufs, mev, p.generated_mev,
+                            p.delivered_mev, p.mb_s, (unsigned long long)p.drops, p.late_mean_ms, p.late_max_ms,
+                            ok ? "" : "  <- saturated");
+                if (!ok) break;
+                sustained = mev;
+            }
+            std::printf("  => sustained %.0f Mev/s\n", sustained);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,206 @@
+// decoded_events: 解码事件回调（SetDecodedEventCallback）与回调线程上顺序解码的对比
+// （Backend::Synthetic + VirtualCamera，无需硬件）。
+//   ./hv_sample_decoded_events [--fmt evt2|evt3|raw8] [--mev N] [--ms N] [--threads N]
+//   (默认: EVT3, 40 Mev/s, 传感器时间 2000 ms, 4 线程)
+// 合成源按尽快模式出包（queue_policy = Block，不丢包），三轮解同一段数据：
+//   serial : 事件回调里按载荷格式选解码器、逐包顺序解码（应用原本的写法）
+//   pool   : SetDecodedEventCallback，按 device()->evsPayload() 选内核，在 N 个线程上并行解码，
+//            按包序交付（EVT2 / EVT3 跨包状态由分发线程顺序扫描给出）
+//   verify : 同 pool，每批在回调里与预编译库的顺序解码器（Decode，逐包、跨包保持状态）逐事件
+//            比对 x / y / 极性 / 时间戳
+// 打印前两轮的事件数（应相等）、墙钟 Mev/s 与 pool 轮的扫描 / 解码 / 交付延迟；事件数不等或
+// 任一事件不一致时退出码 1。
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <shimetapi/codec/evt2_codec.h>
+#include <shimetapi/codec/evt3_codec.h>
+#include <shimetapi/codec/mipi_raw8_codec.h>
+#include <shimetapi/hv/virtual_camera.h>
+
+using Clock = std::chrono::steady_clock;
+using namespace Shimeta;
+
+namespace {
+
+struct Options {
+    hv::EventFormat fmt = hv::EventFormat::Evt3;
+    bool            raw8 = false;
+    double          mev = 40;
+    uint32_t        ms = 2000;
+    size_t          threads = 4;
+};
+
+hv::DeviceConfig makeConfig(const Options& o) {
+    hv::DeviceConfig cfg;
+    cfg.backend = hv::Backend::Synthetic;
+    cfg.event_fmt = o.fmt;
+    cfg.synth_mipi_raw8 = o.raw8;
+    cfg.synth_mev_per_s = o.mev;
+    cfg.synth_speed = 0;
+    cfg.synth_duration_ms = o.ms;
+    cfg.queue_policy = hv::DeviceConfig::QueuePolicy::Block;
+    return cfg;
+}
+
+/// 预编译库里的顺序解码器（非内联 Decode），作比对基准。各包须按序送入（EVT2 / EVT3 跨包有状态）。
+struct RefDecoder {
+    explicit RefDecoder(hv::EvsPayload p) : payload(p) {}
+
+    const std::vector<EventCD>& decode(const uint8_t* data, size_t size) {
+        out.clear();
+        switch (payload) {
+        case hv::EvsPayload::Evt2:     evt2.Decode(data, size, out); break;
+        case hv::EvsPayload::Evt3:     evt3.Decode(data, size, out); break;
+        case hv::EvsPayload::MipiRaw8: raw8.Decode(data, size, out); break;
+        }
+        return out;
+    }
+
+    hv::EvsPayload         payload;
+    codec::Evt2Decoder     evt2;
+    codec::Evt3Decoder     evt3;
+    codec::MipiRaw8Decoder raw8;
+    std::vector<EventCD>   out;
+};
+
+bool sameEvent(const EventCD& a, const EventCD& b) {
+    return a.x == b.x && a.y == b.y && a.polarity == b.polarity && a.t == b.t;
+}
+
+void waitEnded(hv::VirtualCamera& cam) {
+    while (!cam.Ended()) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+}
+
+void printLatency(const char* name, const hv::LatencySummary& s) {
+    std::printf("    %-8s mean %8.1f us  p50 %8.1f us  p99 %8.1f us  max %8.1f us\n", name, s.mean_us, s.p50_us,
+                s.p99_us, s.max_us);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options o;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--fmt") == 0 && i + 1 < argc) {
+            const char* f = argv[++i];
+            o.raw8 = std::strcmp(f, "raw8") == 0;
+            o.fmt = std::strcmp(f, "evt2") == 0 ? hv::EventFormat::Evt2 : hv::EventFormat::Evt3;
+        } else if (std::strcmp(argv[i], "--mev") == 0 && i + 1 < argc) o.mev = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--ms") == 0 && i + 1 < argc) o.ms = uint32_t(std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) o.threads = size_t(std::atoi(argv[++i]));
+        else {
+            std::printf("usage: %s [--fmt evt2|evt3|raw8] [--mev N] [--ms N] [--threads N]\n", argv[0]);
+            return 1;
+        }
+    }
+    std::printf("decoded_events: %s, %.0f Mev/s, %u ms of sensor time, %zu decode threads\n",
+                o.raw8 ? "apx003 RAW8" : o.fmt == hv::EventFormat::Evt2 ? "EVT2" : "EVT3", o.mev, o.ms, o.threads);
+
+    uint64_t serial_events = 0;
+    {
+        hv::VirtualCamera cam;
+        if (!cam.Init(makeConfig(o))) {
+            std::fprintf(stderr, "decoded_events: Init failed.\n");
+            return 1;
+        }
+        const hv::EvsPayload payload = cam.device()->evsPayload();
+        codec::Evt2Decoder     evt2;
+        codec::Evt3Decoder     evt3;
+        codec::MipiRaw8Decoder raw8;
+        std::vector<EventCD>   out;
+        cam.SetEventCallback([&](const hv::EventPacket& p) {
+            out.clear();
+            switch (payload) {
+            case hv::EvsPayload::Evt2:     evt2.DecodeBatch(p.data.data, p.data.size, out); break;
+            case hv::EvsPayload::Evt3:     evt3.DecodeBatch(p.data.data, p.data.size, out); break;
+            case hv::EvsPayload::MipiRaw8: raw8.DecodeBatch(p.data.data, p.data.size, out); break;
+            }
+            serial_events += out.size();
+        });
+        const auto t0 = Clock::now();
+        cam.StartStream();
+        waitEnded(cam);
+        const double el = std::chrono::duration<double>(Clock::now() - t0).count();
+        cam.StopStream();
+        std::printf("  serial   %11llu events in %6.3f s  %7.2f Mev/s\n", (unsigned long long)serial_events, el,
+                    double(serial_events) / el / 1e6);
+    }
+
+    std::atomic<uint64_t> pool_events{0}, skipped{0};
+    {
+        hv::VirtualCamera cam;
+        if (!cam.Init(makeConfig(o))) {
+            std::fprintf(stderr, "decoded_events: Init failed.\n");
+            return 1;
+        }
+        hv::DecoderPoolOptions po;
+        po.threads = o.threads;
+        cam.SetDecodedEventCallback([&](const hv::DecodedEvents& b) {
+            pool_events += b.count;
+            skipped += b.skipped;
+        }, po);
+        const auto t0 = Clock::now();
+        cam.StartStream();
+        waitEnded(cam);
+        cam.StopStream();   // 交付完在途包
+        const double el = std::chrono::duration<double>(Clock::now() - t0).count();
+        const hv::DecoderPoolStats s = cam.GetDecoderStats();
+        std::printf("  pool     %11llu events in %6.3f s  %7.2f Mev/s | packets %llu, skipped %llu, max in flight %zu\n",
+                    (unsigned long long)pool_events.load(), el, double(pool_events) / el / 1e6,
+                    (unsigned long long)s.delivered, (unsigned long long)skipped.load(), s.max_in_flight);
+        printLatency("scan", s.scan);
+        printLatency("decode", s.decode);
+        printLatency("delivery", s.delivery);
+    }
+
+    uint64_t verified = 0, bad = 0;
+    {
+        hv::VirtualCamera cam;
+        if (!cam.Init(makeConfig(o))) {
+            std::fprintf(stderr, "decoded_events: Init failed.\n");
+            return 1;
+        }
+        RefDecoder ref(cam.device()->evsPayload());
+        hv::DecoderPoolOptions po;
+        po.threads = o.threads;
+        // 回调按包序、在单一分发线程上调用，基准解码器无需加锁
+        cam.SetDecodedEventCallback([&](const hv::DecodedEvents& b) {
+            const std::vector<EventCD>& want = ref.decode(b.raw.data, b.raw.size);
+            if (want.size() != b.count) {
+                if (bad++ < 8)
+                    std::printf("    packet %llu: %zu events, reference %zu\n", (unsigned long long)b.packet, b.count,
+                                want.size());
+                return;
+            }
+            for (size_t i = 0; i < b.count; ++i) {
+                if (sameEvent(b.events[i], want[i])) continue;
+                if (bad++ < 8) {
+                    const EventCD& g = b.events[i];
+                    const EventCD& w = want[i];
+                    std::printf("    packet %llu event %zu: (%u, %u, %d, %lld) != reference (%u, %u, %d, %lld)\n",
+                                (unsigned long long)b.packet, i, g.x, g.y, int(g.polarity), (long long)g.t, w.x, w.y,
+                                int(w.polarity), (long long)w.t);
+                }
+            }
+            verified += b.count;
+        }, po);
+        cam.StartStream();
+        waitEnded(cam);
+        cam.StopStream();
+        std::printf("  verify   %11llu events vs prebuilt sequential Decode: %s\n", (unsigned long long)verified,
+                    bad ? "MISMATCH" : "identical");
+    }
+    if (pool_events != serial_events) {
+        std::printf("decoded_events: MISMATCH (%llu vs %llu events)\n", (unsigned long long)pool_events.load(),
+                    (unsigned long long)serial_events);
+        return 1;
+    }
+    return bad || verified != serial_events ? 1 : 0;
+}
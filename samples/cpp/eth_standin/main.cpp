@@ -0,0 +1,89 @@
+// eth_standin: 以太网相机替身（无需相机）。连入运行 Backend::Ethernet 的主机（Camera 在
+// bind_ip:listen_port 监听），按线协议推送带 CRC 的事件包，并响应 SetFrameRate 命令。
+//   ./hv_sample_eth_standin [host] [--port P] [--mbps N] [--packet-bytes N] [--aps-fps N]
+//                           [--evt2] [--seconds S]
+//   (默认: 127.0.0.1:8888, 尽快, 64 KiB/包, EVT3, 直到主机断开 / Ctrl-C)
+// 每秒打印发送 pkt/s、MB/s、Image 包数与收到的命令。配合 hv_sample_bench_ethernet --external。
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include <shimetapi/hv/ethernet_standin.h>
+
+using Clock = std::chrono::steady_clock;
+using namespace Shimeta;
+
+namespace {
+
+std::atomic<bool> g_running(true);
+void onSignal(int) { g_running = false; }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    hv::EthernetStandInConfig sc;
+    sc.connect_timeout_ms = 30000;
+    double seconds = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--port") == 0 && i + 1 < argc) sc.port = uint16_t(std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--mbps") == 0 && i + 1 < argc) sc.mb_per_s = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--packet-bytes") == 0 && i + 1 < argc) sc.packet_bytes = size_t(std::atol(argv[++i]));
+        else if (std::strcmp(argv[i], "--aps-fps") == 0 && i + 1 < argc) sc.aps_fps = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--evt2") == 0) sc.event_fmt = hv::EventFormat::Evt2;
+        else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) seconds = std::atof(argv[++i]);
+        else if (argv[i][0] != '-') sc.host = argv[i];
+        else {
+            std::printf("usage: %s [host] [--port P] [--mbps N] [--packet-bytes N] [--aps-fps N] [--evt2] "
+                        "[--seconds S]\n", argv[0]);
+            return 1;
+        }
+    }
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    hv::EthernetStandIn standin;
+    if (!standin.start(sc)) {
+        std::fprintf(stderr, "eth_standin: invalid config (host must be an IPv4 address).\n");
+        return 1;
+    }
+    std::printf("eth_standin: connecting to %s:%u ...\n", sc.host.c_str(), unsigned(sc.port));
+    while (g_running && !standin.connected() && !standin.finished())
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    if (!standin.connected()) {
+        std::fprintf(stderr, "eth_standin: host not listening.\n");
+        return 1;
+    }
+    std::printf("eth_standin: connected, streaming %s\n", sc.event_fmt == hv::EventFormat::Evt2 ? "EVT2" : "EVT3");
+
+    const auto start = Clock::now();
+    auto tick = start;
+    uint64_t last_pkts = 0, last_bytes = 0, last_cmds = 0;
+    while (g_running && !standin.finished()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        const auto now = Clock::now();
+        if (seconds > 0 && std::chrono::duration<double>(now - start).count() >= seconds) break;
+        const double el = std::chrono::duration<double>(now - tick).count();
+        if (el < 1.0) continue;
+        const uint64_t pkts = standin.packetsSent(), bytes = standin.bytesSent(), cmds = standin.commandsReceived();
+        std::printf("  %8.1f pkt/s %9.2f MB/s | images %llu | commands +%llu (fps %u)\n",
+                    double(pkts - last_pkts) / el, double(bytes - last_bytes) / el / 1e6,
+                    (unsigned long long)standin.imagesSent(), (unsigned long long)(cmds - last_cmds),
+                    standin.frameRate());
+        last_pkts = pkts;
+        last_bytes = bytes;
+        last_cmds = cmds;
+        tick = now;
+    }
+    const double el = std::chrono::duration<double>(Clock::now() - start).count();
+    standin.stop();
+    std::printf("eth_standin: %llu packets, %.2f MB in %.2f s (%.2f MB/s), %llu commands (bad %llu)\n",
+                (unsigned long long)standin.packetsSent(), double(standin.bytesSent()) / 1e6, el,
+                el > 0 ? double(standin.bytesSent()) / el / 1e6 : 0.0,
+                (unsigned long long)standin.commandsReceived(), (unsigned long long)standin.badCommands());
+    return 0;
+}
@@ -0,0 +1,114 @@
+// fanout: 一台相机、三个订阅方各用自己的队列策略（Backend::Synthetic + VirtualCamera，无需硬件）。
+//   ./hv_sample_fanout [--seconds S] [--mev N] [--ml-ms N]
+//   (默认: 5 s, 20 Mev/s, 推理 5 ms/包)
+//   recorder : Block，深度 8，逐包累加字节并检查 seq 连续（无损）
+//   display  : DropOldest，深度 1，约 30 Hz 取最新包；第 1 秒后才订阅（运行中订阅）
+//   ml       : DropOldest，深度 2，每包模拟推理 --ml-ms 毫秒；最后 1 秒前退订
+// 三者共享同一批池 slab（零拷贝）。结束时打印各订阅方入队 / 取走 / 丢弃数与相机侧丢帧。
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#include <shimetapi/hv/frame_fanout.h>
+#include <shimetapi/hv/virtual_camera.h>
+
+using Clock = std::chrono::steady_clock;
+using namespace Shimeta;
+using Policy = hv::DeviceConfig::QueuePolicy;
+
+namespace {
+
+struct ConsumerResult {
+    uint64_t frames = 0, bytes = 0, gaps = 0;
+};
+
+// 取到退订为止；pace_ms > 0 时每包之后停顿（模拟慢消费方）。
+void consume(hv::Subscription& sub, int pace_ms, ConsumerResult& r) {
+    uint64_t last_seq = 0;
+    Frame f;
+    while (!sub.Closed() || sub.Pending()) {
+        if (!sub.Pop(f, 100)) continue;
+        if (last_seq && f.seq != last_seq + 1) ++r.gaps;
+        last_seq = f.seq;
+        ++r.frames;
+        r.bytes += f.evs.size;
+        f = Frame{};   // 归还 slab 引用
+        if (pace_ms > 0) std::this_thread::sleep_for(std::chrono::milliseconds(pace_ms));
+    }
+}
+
+void report(const hv::Subscription& sub, const ConsumerResult& r) {
+    std::printf("  %-8s %-10s depth %zu | delivered %6llu popped %6llu dropped %6llu | seq gaps %llu, %.2f MB\n",
+                sub.Options().name.c_str(), sub.Options().policy == Policy::Block ? "Block" : "DropOldest",
+                sub.Options().depth, (unsigned long long)sub.Delivered(), (unsigned long long)sub.Popped(),
+                (unsigned long long)sub.Dropped(), (unsigned long long)r.gaps, double(r.bytes) / 1e6);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    double seconds = 5, mev = 20;
+    int ml_ms = 5;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) seconds = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--mev") == 0 && i + 1 < argc) mev = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--ml-ms") == 0 && i + 1 < argc) ml_ms = std::atoi(argv[++i]);
+        else {
+            std::printf("usage: %s [--seconds S] [--mev N] [--ml-ms N]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (seconds < 2) seconds = 2;
+
+    hv::DeviceConfig cfg;
+    cfg.backend = hv::Backend::Synthetic;
+    cfg.synth_mev_per_s = mev;
+    cfg.buffer_count = 16;   // > 各订阅方深度之和（8 + 1 + 2）
+    cfg.queue_policy = Policy::Block;
+
+    hv::FrameFanout fanout;   // 先于相机构造、后于其析构（帧回调引用 fanout）
+    hv::VirtualCamera cam;
+    if (!cam.Init(cfg)) {
+        std::fprintf(stderr, "fanout: Init failed.\n");
+        return 1;
+    }
+    fanout.Attach(cam);
+
+    auto recorder = fanout.Subscribe({"recorder", 8, Policy::Block});
+    auto ml = fanout.Subscribe({"ml", 2, Policy::DropOldest});
+    std::shared_ptr<hv::Subscription> display;
+    ConsumerResult rec_r, ml_r, disp_r;
+    std::thread rec_t([&] { consume(*recorder, 0, rec_r); });
+    std::thread ml_t([&] { consume(*ml, ml_ms, ml_r); });
+    std::thread disp_t;
+
+    if (!cam.StartStream()) {
+        std::fprintf(stderr, "fanout: StartStream failed.\n");
+        return 1;
+    }
+    std::printf("fanout: synthetic %.1f Mev/s, %.1f s, ml %d ms/packet\n", mev, seconds, ml_ms);
+    const auto start = Clock::now();
+    const auto at = [&](double s) { std::this_thread::sleep_until(start + std::chrono::duration<double>(s)); };
+    at(1.0);
+    display = fanout.Subscribe({"display", 1, Policy::DropOldest});
+    disp_t = std::thread([&] { consume(*display, 33, disp_r); });
+    at(seconds - 1.0);
+    fanout.Unsubscribe(ml);
+    at(seconds);
+    cam.StopStream();
+    fanout.Close();
+    for (std::thread* t : {&rec_t, &ml_t, &disp_t}) t->join();
+
+    std::printf("fanout: %llu packets published, camera dropped %llu\n", (unsigned long long)fanout.Published(),
+                (unsigned long long)cam.DroppedFrames());
+    report(*recorder, rec_r);
+    report(*display, disp_r);
+    report(*ml, ml_r);
+    cam.Destroy();
+    return 0;
+}
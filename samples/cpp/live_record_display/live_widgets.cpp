@@ -4,6 +4,7 @@
  */
 #include "live_widgets.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <ctime>
 #include <iomanip>
@@ -45,16 +46,14 @@ std::string makeTimestampedPath(const std::string& prefix, const std::string& ex
 EvsVisualizer::EvsVisualizer()
     : frame_(kDefaultEvsHeight, kDefaultEvsWidth, CV_32FC3, cv::Scalar(0, 0, 0)) {}
 
-void EvsVisualizer::addEvents(const std::vector<Shimeta::EventCD>& events) {
+void EvsVisualizer::addFrame(const Shimeta::codec::EventFrame& ef) {
+    if (ef.events == 0 || ef.polarity.empty()) return;
+    const cv::Mat pol(ef.height, ef.width, CV_8UC1, const_cast<uint8_t*>(ef.polarity.data()));
     std::lock_guard<std::mutex> lock(mutex_);
-    for (const auto& e : events) {
-        if (e.x >= kDefaultEvsWidth || e.y >= kDefaultEvsHeight) continue;
-        cv::Vec3f& px = frame_.at<cv::Vec3f>(int(e.y), int(e.x));
-        if (e.polarity)
-            px = cv::Vec3f(1.0f, 1.0f, 1.0f);   // ON：白
-        else
-            px = cv::Vec3f(0.0f, 0.627f, 1.0f); // OFF：橙
-    }
+    cv::Mat roi = frame_(cv::Rect(0, 0, std::min(ef.width, frame_.cols), std::min(ef.height, frame_.rows)));
+    const cv::Mat p = pol(cv::Rect(0, 0, roi.cols, roi.rows));
+    roi.setTo(cv::Scalar(1.0f, 1.0f, 1.0f), p == 1);   // ON：白
+    roi.setTo(cv::Scalar(0.0f, 0.627f, 1.0f), p == 2); // OFF：橙
 }
 
 cv::Mat EvsVisualizer::getFrame() {
@@ -15,6 +15,7 @@
 
 #include <opencv2/opencv.hpp>
 
+#include <shimetapi/codec/mipi_raw8_frame.h>
 #include <shimetapi/core/event_cd.h>
 #include <shimetapi/core/evs_timestamp.h>
 #include <shimetapi/core/frame.h>
@@ -38,8 +39,8 @@ constexpr const char* kWindowName   = "EVS / APS Live";
 class EvsVisualizer {
 public:
     EvsVisualizer();
-    /** @brief 追加一批事件到可视化图（线程安全）。@param events 事件向量。 */
-    void addEvents(const std::vector<Shimeta::EventCD>& events);
+    /** @brief 把一帧极性图叠加到可视化图（线程安全）。@param frame 融合解码得到的事件帧。 */
+    void addFrame(const Shimeta::codec::EventFrame& frame);
     /** @brief 取当前可视化帧（BGR），并衰减内部图。 */
     cv::Mat getFrame();
 private:
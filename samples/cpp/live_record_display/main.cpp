@@ -2,7 +2,7 @@
 // 本文件只保留参数解析与采集/显示主循环；可视化/录制/解码辅助见 live_widgets.{h,cpp}。
 #include "live_widgets.h"
 
-#include <shimetapi/codec/mipi_raw8_codec.h>
+#include <shimetapi/codec/mipi_raw8_frame.h>
 #include <shimetapi/hv/camera.h>
 #include <shimetapi/hv/device_config.h>
 
@@ -56,7 +56,7 @@ int main(int argc, char** argv) {
     std::printf("MIPI-HVS 设备已启动\n");
 
     // ---- 组件 ----
-    Shimeta::codec::MipiRaw8Decoder decoder;
+    Shimeta::codec::EventFrame evsFrame;   // 整包极性图，跨包复用（解码直接落图，不物化事件表）
     EvsVisualizer visualizer;
     RecordManager recorder;
 
@@ -114,11 +114,9 @@ int main(int argc, char** argv) {
         Shimeta::EvsTimestamp evs_ts;
         if (newEvsPacket) {
             evs_ts = Shimeta::codec::extractEvsTimestamp(frame.evs.data, frame.evs.size);
-            std::vector<Shimeta::EventCD> events;
-            decoder.Decode(frame.evs.data, frame.evs.size, events);
-            if (!events.empty()) {
-                visualizer.addEvents(events);
-            }
+            evsFrame.clear();
+            if (Shimeta::codec::AccumulatePacket(frame.evs.data, frame.evs.size, evsFrame) > 0)
+                visualizer.addFrame(evsFrame);
         }
 
         // 录制（写入 RAW + AVI + tsmp chunk；重复快照跳过，防 RAW 重复包）
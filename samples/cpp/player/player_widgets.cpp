@@ -5,7 +5,7 @@
  */
 #include "player_widgets.h"
 
-#include <shimetapi/codec/mipi_raw8_codec.h>
+#include <shimetapi/codec/mipi_raw8_frame.h>
 
 #include <algorithm>
 #include <cctype>
@@ -104,59 +104,33 @@ bool EvsFrameSequence::open(const std::string& filename) {
     width_ = 768;
     height_ = 608;
 
-    Shimeta::codec::MipiRaw8Decoder decoder;
-    std::vector<Shimeta::EventCD> all_events;
+    // 解码与成帧融合：子帧直接扫描进极性图（4 个唯一时间戳 = 1 EVS 帧），不物化事件表
+    frames_.clear();
+    processed_timestamps_.clear();
+    Shimeta::codec::MipiRaw8FrameBuilder builder({}, int(kEvsSubframesPerFrame));
+    const auto on_frame = [this](const Shimeta::codec::EventFrame& ef) {
+        frames_.push_back(cv::Mat(height_, width_, CV_8UC1, const_cast<uint8_t*>(ef.polarity.data())).clone());
+        processed_timestamps_.push_back(uint64_t(ef.t_begin));
+    };
     int packet_count = 0;
     size_t total_bytes = 0;
+    size_t total_events = 0;
     Shimeta::Frame f;
     while (reader.readEvsPacket(f)) {
-        std::vector<Shimeta::EventCD> packet_events;
-        decoder.Decode(f.evs.data, f.evs.size, packet_events);
-        all_events.insert(all_events.end(), packet_events.begin(), packet_events.end());
+        total_events += builder.Feed(f.evs.data, f.evs.size, on_frame);
         total_bytes += f.evs.size;
         ++packet_count;
     }
+    builder.Flush(on_frame);
     std::cout << "RAW8 data size: " << total_bytes << " bytes" << std::endl;
     std::cout << "Decoded " << packet_count << " packets, "
-              << all_events.size() << " events total" << std::endl;
+              << total_events << " events total" << std::endl;
 
-    if (all_events.empty()) {
+    if (total_events == 0) {
         std::cerr << "事件文件解码后为空" << std::endl;
         return false;
     }
 
-    // 按时间窗口（4 个唯一时间戳 = 1 EVS 帧）累积为极性帧
-    frames_.clear();
-    processed_timestamps_.clear();
-    cv::Mat frame(height_, width_, CV_8UC1, cv::Scalar(0));
-    int64_t current_ts = all_events.front().t;
-    uint64_t unique_ts_in_frame = 1;
-    uint64_t frame_processed_timestamp = 0;
-    bool frame_has_timestamp = false;
-
-    for (const auto& e : all_events) {
-        if (e.t != current_ts) {
-            if (unique_ts_in_frame >= kEvsSubframesPerFrame) {
-                frames_.push_back(frame.clone());
-                processed_timestamps_.push_back(frame_has_timestamp ? frame_processed_timestamp : uint64_t(current_ts));
-                frame.setTo(cv::Scalar(0));
-                frame_processed_timestamp = 0;
-                frame_has_timestamp = false;
-                unique_ts_in_frame = 0;
-            }
-            ++unique_ts_in_frame;
-            current_ts = e.t;
-        }
-        if (!frame_has_timestamp) {
-            frame_processed_timestamp = uint64_t(e.t);
-            frame_has_timestamp = true;
-        }
-        if (uint32_t(e.x) < width_ && uint32_t(e.y) < height_)
-            frame.at<uint8_t>(int(e.y), int(e.x)) = e.polarity ? 1 : 2;
-    }
-    frames_.push_back(frame.clone());
-    processed_timestamps_.push_back(frame_has_timestamp ? frame_processed_timestamp : uint64_t(current_ts));
-
     std::cout << "EVS frames cached: " << frames_.size() << std::endl;
     return !frames_.empty();
 }
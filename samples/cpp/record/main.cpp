@@ -6,6 +6,7 @@
 // 回放端据此做 1 APS ↔ N EVS 对齐（同旧 Demo hv_camera_live_record_timestamps）。
 #include <shimetapi/hv/camera.h>
 #include <shimetapi/hv/device_config.h>
+#include <shimetapi/hv/frame_sequencer.h>
 #include <shimetapi/codec/mipi_raw8_codec.h>
 #include <shimetapi/io/hybrid_writer.h>
 #include <chrono>
@@ -13,9 +14,9 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
-#include <thread>
 
 int main(int argc, char** argv) {
+    Shimeta::hv::FrameSequencer seq;   // 先于 Camera 构造、后于其析构（帧回调引用 seq）
     Shimeta::hv::Camera cam;
     Shimeta::hv::DeviceConfig cfg;
     // 检查是否指定 MIPI / MIPI-HVS 后端
@@ -46,6 +47,7 @@ int main(int argc, char** argv) {
         std::printf("record: using USB backend\n");
     }
     cam.Init(cfg);
+    seq.Attach(cam);
     if (!cam.StartStream()) {
         std::printf("record: no device — start failed (expected on host w/o camera)\n");
         return 0;
@@ -53,23 +55,22 @@ int main(int argc, char** argv) {
     Shimeta::io::HybridWriter w;
     w.open("/tmp/hv_record.raw", "/tmp/hv_record.avi", 768, 608);
 
-    // 边沿触发消费：latest_frame_ 只在 dispLoop 弹出新事件包时刷新（HVS 下
-    // 包到达节奏 ~4ms）。GetFrame 是电平触发（谓词只看 evs.size>0），必须按
-    // EVS slab 指针自行去重，否则同一包会被重复落盘。
-    uint64_t evs_frames = 0;
-    const uint8_t* last_evs_ptr = nullptr;
+    // 边沿触发消费：GetFrame 是电平触发（返回最新快照，同一包会被重复取到）；
+    // FrameSequencer 挂在帧回调上逐包编号，WaitForNext 阻塞到出现新包才返回
+    // （HVS 下包到达节奏 ~4ms），无需按指针去重或 sleep 轮询；skipped 为其间
+    // 来不及落盘的包数。
+    uint64_t evs_frames = 0, last_seq = 0, skipped_total = 0;
     uint32_t aps_last_report = 0, tsmp_valid = 0;
     bool seen_aps = !use_mipi_hvs;
     const auto deadline = std::chrono::steady_clock::now() +
                           std::chrono::duration<double>(duration_s);
     while (std::chrono::steady_clock::now() < deadline) {
         Shimeta::Frame f;
-        if (!cam.GetFrame(f, 100)) continue;
-        if (f.evs.size == 0 || f.evs.data == last_evs_ptr) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
-            continue;                       // 同一事件包的重复快照，不重复落盘
-        }
-        last_evs_ptr = f.evs.data;
+        uint64_t skipped = 0;
+        if (!seq.WaitForNext(f, last_seq, 100, &skipped)) continue;
+        last_seq = f.seq;
+        skipped_total += skipped;
+        if (f.evs.size == 0) continue;
 
         if (use_mipi_hvs && !seen_aps) {
             const bool has_aps = f.aps.data != nullptr && f.aps.size > 0 &&
@@ -99,6 +100,9 @@ int main(int argc, char** argv) {
     w.close();
     cam.StopStream();
     cam.Destroy();
+    if (skipped_total > 0)
+        std::printf("record: %llu packets arrived faster than they were written (skipped)\n",
+                    (unsigned long long)skipped_total);
     if (w.apsFrameCount() > 0) {
         std::printf("record: wrote /tmp/hv_record.raw and /tmp/hv_record.avi "
                     "(APS frames=%u, EVS frames=%llu, ratio 1:%.1f, tsmp=%u)\n",
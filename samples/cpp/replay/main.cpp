@@ -0,0 +1,160 @@
+// replay: 用录像代替相机驱动整条取帧管线（Backend::Replay + VirtualCamera，无需硬件）。
+//   ./hv_sample_replay <events.raw> [video.avi] [--speed N] [--loop] [--fps N]
+//   --speed N : 回放倍速（默认 1 = 按录制时间戳实时；0 = 尽快，用于测管线吞吐）
+//   --loop    : 读完从头循环（Ctrl-C 结束）
+//   --fps N   : RAW8 录像的帧率档（决定整包子帧数，默认 240）
+// 每秒打印 EVS 包率 / MB/s / Mev/s（按载荷格式解码计数）、APS 帧率、节拍滞后与丢帧数。
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <shimetapi/codec/evt2_codec.h>
+#include <shimetapi/codec/evt3_codec.h>
+#include <shimetapi/codec/mipi_raw8_codec.h>
+#include <shimetapi/core/event_batch.h>
+#include <shimetapi/hv/virtual_camera.h>
+
+using Clock = std::chrono::steady_clock;
+using namespace Shimeta;
+
+namespace {
+
+std::atomic<bool> g_running(true);
+void onSignal(int) { g_running = false; }
+
+const char* payloadName(hv::EvsPayload p) {
+    switch (p) {
+    case hv::EvsPayload::Evt2:     return "EVT2";
+    case hv::EvsPayload::Evt3:     return "EVT3";
+    case hv::EvsPayload::MipiRaw8: return "apx003 RAW8";
+    }
+    return "?";
+}
+
+// 按载荷格式解码一包，返回事件数（EVT 解码器跨包保持时间基）。
+struct EventCounter {
+    hv::EvsPayload      payload;
+    codec::Evt2Decoder  evt2;
+    codec::Evt3Decoder  evt3;
+    codec::MipiRaw8Decoder raw8;
+    EventBatch          batch;
+
+    size_t count(const BufferView& v) {
+        batch.clear();
+        switch (payload) {
+        case hv::EvsPayload::Evt2:     evt2.Decode(v.data, v.size, batch); break;
+        case hv::EvsPayload::Evt3:     evt3.Decode(v.data, v.size, batch); break;
+        case hv::EvsPayload::MipiRaw8: raw8.Decode(v.data, v.size, batch); break;
+        }
+        return batch.size();
+    }
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argv[1][0] == '-') {
+        std::printf("usage: %s <events.raw> [video.avi] [--speed N] [--loop] [--fps N]\n", argv[0]);
+        return 1;
+    }
+    hv::DeviceConfig cfg;
+    cfg.backend = hv::Backend::Replay;
+    cfg.replay_evs_path = argv[1];
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--speed") == 0 && i + 1 < argc) cfg.replay_speed = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--loop") == 0) cfg.replay_loop = true;
+        else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc) cfg.evs_fps = uint16_t(std::atoi(argv[++i]));
+        else if (argv[i][0] != '-') cfg.replay_aps_path = argv[i];
+    }
+    // 尽快模式下让采集线程在队列满时等待消费，测的是无丢帧的管线吞吐。
+    if (cfg.replay_speed <= 0) cfg.queue_policy = hv::DeviceConfig::QueuePolicy::Block;
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    hv::VirtualCamera cam;
+    if (!cam.Init(cfg)) {
+        std::printf("replay: init failed (%s)\n", statusToString(cam.LastStatus()));
+        return 1;
+    }
+    hv::VirtualDevice* dev = cam.device();
+    char speed[32] = "max";
+    if (cfg.replay_speed > 0) std::snprintf(speed, sizeof(speed), "%gx", cfg.replay_speed);
+    std::printf("replay: %s (%s, %zu B/packet)%s%s, speed %s, %s\n", cfg.replay_evs_path.c_str(),
+                payloadName(dev->evsPayload()), dev->maxEventPacketBytes(),
+                cfg.replay_aps_path.empty() ? "" : " + ", cfg.replay_aps_path.c_str(), speed,
+                cfg.replay_loop ? "loop" : "once");
+    if (!cam.StartStream()) {
+        std::printf("replay: start failed (%s)\n", statusToString(cam.LastStatus()));
+        return 1;
+    }
+
+    EventCounter counter{dev->evsPayload(), {}, {}, {}, {}};
+    struct Totals { uint64_t packets = 0, bytes = 0, events = 0, images = 0; } win, all;
+    // 节拍滞后：包到达墙钟 - 首包起按录制时间戳 / speed 推算的应到时刻。
+    bool    have_t0 = false;
+    int64_t t0_ns = 0;
+    Clock::time_point wall0{};
+    double  late_max_ms = 0, late_sum_ms = 0;
+    uint64_t late_n = 0;
+
+    const auto start = Clock::now();
+    auto tick = start;
+    Frame f;
+    while (g_running && !cam.Ended()) {
+        if (cam.GetFrame(f, 100)) {
+            const auto now = Clock::now();
+            if (f.evs.size) {
+                ++win.packets;
+                win.bytes += f.evs.size;
+                win.events += counter.count(f.evs);
+                if (!have_t0) {
+                    have_t0 = true;
+                    t0_ns = f.ts.evs_ts_ns;
+                    wall0 = now;
+                } else if (cfg.replay_speed > 0 && !cfg.replay_loop) {
+                    const double due_ms = double(f.ts.evs_ts_ns - t0_ns) / 1e6 / cfg.replay_speed;
+                    const double late = std::chrono::duration<double, std::milli>(now - wall0).count() - due_ms;
+                    late_max_ms = std::max(late_max_ms, late);
+                    late_sum_ms += late;
+                    ++late_n;
+                }
+            }
+            if (f.aps.size) ++win.images;
+            f = Frame{};   // 归还 slab
+        }
+        const auto now = Clock::now();
+        const double el = std::chrono::duration<double>(now - tick).count();
+        if (el >= 1.0) {
+            std::printf("  %7.1f pkt/s %8.2f MB/s %8.2f Mev/s | APS %5.1f fps | drops %llu\n",
+                        double(win.packets) / el, double(win.bytes) / el / 1e6, double(win.events) / el / 1e6,
+                        double(win.images) / el, (unsigned long long)cam.DroppedFrames());
+            all.packets += win.packets;
+            all.bytes += win.bytes;
+            all.events += win.events;
+            all.images += win.images;
+            win = Totals{};
+            tick = now;
+        }
+    }
+    all.packets += win.packets;
+    all.bytes += win.bytes;
+    all.events += win.events;
+    all.images += win.images;
+    const double el = std::chrono::duration<double>(Clock::now() - start).count();
+    cam.StopStream();
+
+    std::printf("replay: %llu packets, %.2f MB, %llu events, %llu APS frames in %.2f s "
+                "(%.2f MB/s, %.2f Mev/s), drops %llu\n",
+                (unsigned long long)all.packets, double(all.bytes) / 1e6, (unsigned long long)all.events,
+                (unsigned long long)all.images, el, el > 0 ? double(all.bytes) / el / 1e6 : 0.0,
+                el > 0 ? double(all.events) / el / 1e6 : 0.0, (unsigned long long)cam.DroppedFrames());
+    if (late_n)
+        std::printf("replay: pacing lateness mean %.3f ms, max %.3f ms\n", late_sum_ms / double(late_n), late_max_ms);
+    cam.Destroy();
+    return 0;
+}
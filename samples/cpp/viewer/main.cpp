@@ -5,6 +5,7 @@
 #include <shimetapi/hv/device_config.h>
 #include <shimetapi/codec/evt2_codec.h>     // USB 相机发 EVT2
 #include <shimetapi/codec/mipi_raw8_codec.h> // MIPI s100 (apx003) 发 RAW8
+#include <algorithm>
 #include <vector>
 #include <cstdio>
 #include <cstdlib>
@@ -41,18 +42,26 @@ int main(int argc, char** argv) {
         return 0;
     }
     long total = 0;
+    // 解码器跨包复用；输出区定长、启动时分配一次（MIPI 至少容纳一个满子帧）。包产出多于输出区时
+    // 按 consumed 续调，热路径上无分配、无清零。
+    Shimeta::codec::MipiRaw8Decoder mipi_dec;
+    Shimeta::codec::Evt2Decoder evt2_dec;
+    constexpr size_t kOutEvents = size_t(1) << 16;
+    std::vector<Shimeta::EventCD> evs(std::max(
+        kOutEvents, Shimeta::codec::MipiRaw8Decoder::MaxEventsForBytes(Shimeta::codec::MipiRaw8Layout::kSubframeBytes)));
     for (int i = 0; i < 10; ++i) {
         Shimeta::Frame f;
         if (cam.GetFrame(f, 1000) && f.evs.size > 0) {
-            std::vector<Shimeta::EventCD> evs;
-            if (use_mipi) {
-                Shimeta::codec::MipiRaw8Decoder dec;
-                dec.Decode(f.evs.data, f.evs.size, evs);
-            } else {
-                Shimeta::codec::Evt2Decoder dec;
-                dec.Decode(f.evs.data, f.evs.size, evs);
+            const uint8_t* p = f.evs.data;
+            size_t left = f.evs.size;
+            for (;;) {
+                const auto r = use_mipi ? mipi_dec.Decode(p, left, evs.data(), evs.size())
+                                        : evt2_dec.Decode(p, left, evs.data(), evs.size());
+                total += long(r.events);
+                if (!r.needsMoreSpace() || r.consumed == 0) break;
+                p += r.consumed;
+                left -= r.consumed;
             }
-            total += long(evs.size());
         }
     }
     cam.StopStream();
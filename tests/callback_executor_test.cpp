@@ -0,0 +1,213 @@
+// callback_executor: CallbackExecutor 的分通道执行。同一通道按投递顺序依次执行、不重叠；通道之间
+// 并发（一条通道的回调阻塞时另一条照常前进）；深度与满时策略按通道生效（Event 通道 DropOldest 丢旧包、
+// Image 通道 Block 不丢）；Event / Image 载荷拷出后在回调里完整可读；Close(true) 执行完排队回调，
+// Close(false) 丢弃，之后包装出的回调直接返回。
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <shimetapi/hv/callback_executor.h>
+
+#include "check.h"
+
+using namespace Shimeta;
+using hv::CallbackLane;
+using Policy = hv::DeviceConfig::QueuePolicy;
+
+namespace {
+
+/// 回调里等待放行的闸门。
+class Gate {
+public:
+    void open() {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            open_ = true;
+        }
+        cv_.notify_all();
+    }
+    /// 至多等 timeout；返回是否已放行。
+    bool wait(std::chrono::milliseconds timeout = std::chrono::milliseconds(5000)) {
+        std::unique_lock<std::mutex> lk(m_);
+        return cv_.wait_for(lk, timeout, [&] { return open_; });
+    }
+
+private:
+    std::mutex              m_;
+    std::condition_variable cv_;
+    bool                    open_ = false;
+};
+
+/// 等 pred 成立，至多 5 s。
+template <class Pred>
+bool waitUntil(Pred pred) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() >= deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+hv::EventPacket packet(const std::vector<uint8_t>& bytes, int64_t id) {
+    hv::EventPacket p;
+    p.data = BufferView{bytes.data(), bytes.size()};
+    p.t_begin_ns = p.t_end_ns = id;
+    return p;
+}
+
+void laneOrdering() {
+    hv::ExecutorOptions eo;
+    eo.lane(CallbackLane::Frame).depth = 4;
+    eo.lane(CallbackLane::Event).depth = 4;
+    hv::CallbackExecutor exec(eo);
+    constexpr int kPosts = 300;
+    std::vector<uint64_t> frames;
+    std::vector<int64_t> events;
+    std::atomic<int> active{0};
+    std::atomic<bool> overlap{false}, corrupt{false};
+    auto on_frame = exec.WrapFrame([&](const Frame& f) {
+        if (active.fetch_add(1) != 0) overlap = true;   // 同一通道不重叠
+        frames.push_back(uint64_t(f.frame_id));
+        --active;
+    });
+    auto on_event = exec.WrapEvent([&](const hv::EventPacket& p) {
+        bool ok = p.data.size == size_t(p.t_begin_ns % 97) + 1;
+        for (size_t i = 0; i < p.data.size; ++i) ok &= p.data.data[i] == uint8_t(p.t_begin_ns);
+        if (!ok) corrupt = true;
+        events.push_back(p.t_begin_ns);
+    });
+    std::vector<uint8_t> buf;
+    for (int i = 0; i < kPosts; ++i) {
+        Frame f;
+        f.frame_id = i;
+        on_frame(f);
+        buf.assign(size_t(i % 97) + 1, uint8_t(i));   // 载荷拷出后派发方即可复用缓冲
+        on_event(packet(buf, i));
+    }
+    exec.Close(true);
+    CHECK(!overlap);
+    CHECK(!corrupt);
+    CHECK_EQ(frames.size(), size_t(kPosts));
+    CHECK_EQ(events.size(), size_t(kPosts));
+    bool ordered = true;
+    for (int i = 0; i < kPosts && size_t(i) < frames.size() && size_t(i) < events.size(); ++i)
+        ordered &= frames[size_t(i)] == uint64_t(i) && events[size_t(i)] == i;
+    CHECK(ordered);
+    const hv::CallbackStats s = exec.Stats(CallbackLane::Event);
+    CHECK_EQ(s.posted, uint64_t(kPosts));
+    CHECK_EQ(s.executed, uint64_t(kPosts));
+    CHECK_EQ(s.dropped, 0u);
+    CHECK(s.max_pending <= 4u);
+    CHECK(s.copied_bytes > 0);
+}
+
+void lanesConcurrent() {
+    hv::CallbackExecutor exec;   // 3 线程
+    Gate image_ran;
+    std::atomic<bool> event_saw_image{false};
+    auto on_event = exec.WrapEvent([&](const hv::EventPacket&) { event_saw_image = image_ran.wait(); });
+    auto on_image = exec.WrapImage([&](const hv::ImageData&) { image_ran.open(); });
+    const std::vector<uint8_t> bytes(64, 1);
+    on_event(packet(bytes, 0));   // 事件回调阻塞，直到图像回调在另一通道上执行
+    hv::ImageData img;
+    img.pixels = BufferView{bytes.data(), bytes.size()};
+    on_image(img);
+    exec.Close(true);
+    CHECK(event_saw_image);
+}
+
+void perLanePolicy() {
+    hv::ExecutorOptions eo;
+    eo.lane(CallbackLane::Event) = {2, Policy::DropOldest};
+    eo.lane(CallbackLane::Image) = {2, Policy::Block};
+    hv::CallbackExecutor exec(eo);
+    Gate gate;
+    std::vector<int64_t> events, images;
+    auto on_event = exec.WrapEvent([&](const hv::EventPacket& p) {
+        gate.wait();
+        events.push_back(p.t_begin_ns);
+    });
+    auto on_image = exec.WrapImage([&](const hv::ImageData& img) {
+        gate.wait();
+        images.push_back(img.ts.evs_ts_ns);
+    });
+    constexpr int kPosts = 10;
+    const std::vector<uint8_t> bytes(256, 7);
+    // Image 通道 Block：投递方在队满时等待，放到独立线程上
+    std::atomic<int> images_posted{0};
+    std::thread image_poster([&] {
+        for (int i = 0; i < kPosts; ++i) {
+            hv::ImageData img;
+            img.pixels = BufferView{bytes.data(), bytes.size()};
+            img.ts.evs_ts_ns = i;
+            on_image(img);
+            ++images_posted;
+        }
+    });
+    // Event 通道 DropOldest：回调卡住时投递不阻塞，只保留最新的 depth 个
+    for (int i = 0; i < kPosts; ++i) on_event(packet(bytes, i));
+    CHECK(waitUntil([&] { return images_posted.load() >= 3; }));   // 执行中 1 + 排队 2
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CHECK(images_posted.load() < kPosts);                           // 其余仍在等空位
+    gate.open();
+    image_poster.join();
+    exec.Close(true);
+
+    const hv::CallbackStats ev = exec.Stats(CallbackLane::Event);
+    const hv::CallbackStats im = exec.Stats(CallbackLane::Image);
+    CHECK_EQ(ev.posted, uint64_t(kPosts));
+    CHECK_EQ(ev.executed + ev.dropped, ev.posted);
+    CHECK(ev.dropped >= uint64_t(kPosts - 3));
+    CHECK(!events.empty() && events.back() == kPosts - 1);   // 丢的是旧包
+    bool increasing = true;
+    for (size_t i = 1; i < events.size(); ++i) increasing &= events[i] > events[i - 1];
+    CHECK(increasing);
+    CHECK(ev.max_pending <= 2u);
+    CHECK_EQ(im.dropped, 0u);
+    CHECK_EQ(im.executed, uint64_t(kPosts));
+    CHECK_EQ(images.size(), size_t(kPosts));
+    CHECK(im.max_pending <= 2u);
+}
+
+void closeDrainsOrDiscards() {
+    for (const bool drain : {true, false}) {
+        hv::CallbackExecutor exec;
+        Gate gate;
+        std::atomic<int> ran{0};
+        auto on_frame = exec.WrapFrame([&](const Frame&) {
+            gate.wait();
+            ++ran;
+        });
+        for (int i = 0; i < 5; ++i) on_frame(Frame{});
+        CHECK(waitUntil([&] { return exec.Stats(CallbackLane::Frame).pending == 4; }));   // 首个在执行
+        std::thread opener([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            gate.open();
+        });
+        exec.Close(drain);   // 等正在执行的回调返回
+        opener.join();
+        CHECK_EQ(ran.load(), drain ? 5 : 1);
+        const hv::CallbackStats s = exec.Stats(CallbackLane::Frame);
+        CHECK_EQ(s.pending, 0u);
+        CHECK_EQ(s.executed, uint64_t(drain ? 5 : 1));
+        on_frame(Frame{});   // 关闭后直接返回
+        CHECK_EQ(exec.Stats(CallbackLane::Frame).posted, 5u);
+    }
+}
+
+} // namespace
+
+int main() {
+    laneOrdering();
+    lanesConcurrent();
+    perLanePolicy();
+    closeDrainsOrDiscards();
+    return test::result("callback_executor");
+}
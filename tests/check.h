@@ -0,0 +1,39 @@
+// 测试断言：失败时打印位置与表达式并计数、不中断，一次运行报告全部失败；main 以 result() 返回。
+#ifndef SHIMETA_TESTS_CHECK_H
+#define SHIMETA_TESTS_CHECK_H
+
+#include <cstdio>
+
+namespace Shimeta::test {
+
+inline int& failures() {
+    static int n = 0;
+    return n;
+}
+
+inline bool check(bool ok, const char* expr, const char* file, int line) {
+    if (!ok && failures()++ < 64) std::printf("%s:%d: CHECK(%s) failed\n", file, line, expr);
+    return ok;
+}
+
+/// 整数比较，失败时打印两侧的值。
+template <class A, class B>
+bool checkEq(const A& a, const B& b, const char* ea, const char* eb, const char* file, int line) {
+    if (a == b) return true;
+    if (failures()++ < 64)
+        std::printf("%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", file, line, ea, eb, (long long)a, (long long)b);
+    return false;
+}
+
+/// 打印汇总，返回进程退出码。
+inline int result(const char* name) {
+    std::printf("%s: %s (%d failed checks)\n", name, failures() ? "FAILED" : "ok", failures());
+    return failures() ? 1 : 0;
+}
+
+} // namespace Shimeta::test
+
+#define CHECK(e) ::Shimeta::test::check(bool(e), #e, __FILE__, __LINE__)
+#define CHECK_EQ(a, b) ::Shimeta::test::checkEq((a), (b), #a, #b, __FILE__, __LINE__)
+
+#endif // SHIMETA_TESTS_CHECK_H
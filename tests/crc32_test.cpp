@@ -0,0 +1,85 @@
+// crc32: 以太网包 CRC-32 的各实现（crc32Impls：逐字节 / slicing / PCLMUL / ARMv8，按 CPU 可用者）
+// 与逐位参照实现比对：标准向量、空输入、0 ~ 64 B 全部长度 × 0 ~ 15 起始偏移、随机长度与偏移、
+// 分段续算；另验 ethernet::crc32 / packetChecksum 的约定。与 HAL calculateCrc32 的交叉校验见
+// bench_crc32 样例（需链接 libshimetapi_hv）。
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <shimetapi/hv/ethernet_protocol.h>
+
+#include "check.h"
+
+using namespace Shimeta;
+namespace det = hv::detail;
+
+namespace {
+
+/// 逐位参照：反射多项式 0xEDB88320，state 不取反（与 Crc32Impl::fn 同约定）。
+uint32_t referenceUpdate(uint32_t state, const uint8_t* p, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        state ^= p[i];
+        for (int b = 0; b < 8; ++b) state = (state >> 1) ^ (0xEDB88320u & (0u - (state & 1u)));
+    }
+    return state;
+}
+
+uint32_t reference(const uint8_t* p, size_t n) { return ~referenceUpdate(0xFFFFFFFFu, p, n); }
+
+uint64_t g_mismatches = 0;
+
+void compare(const uint8_t* p, size_t n, size_t off) {
+    const uint32_t want = reference(p, n);
+    for (const det::Crc32Impl& im : det::crc32Impls()) {
+        const uint32_t got = ~im.fn(0xFFFFFFFFu, p, n);
+        if (got != want && g_mismatches++ < 8)
+            std::printf("  %-8s len %zu offset %zu: %08x != %08x\n", im.name, n, off, got, want);
+    }
+}
+
+} // namespace
+
+int main() {
+    const uint8_t vec[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    CHECK_EQ(reference(vec, sizeof(vec)), 0xCBF43926u);
+    CHECK_EQ(hv::ethernet::crc32(vec, sizeof(vec)), 0xCBF43926u);
+    CHECK_EQ(hv::ethernet::crc32(nullptr, 0), 0u);   // 空输入返回 0（与主机侧一致）
+
+    std::vector<uint8_t> buf(1u << 20);
+    std::mt19937 rng(11);
+    for (uint8_t& b : buf) b = uint8_t(rng());
+
+    size_t cases = 0;
+    compare(vec, sizeof(vec), 0);
+    ++cases;
+    for (size_t off = 0; off < 16; ++off)   // 全部短长度 × 全部起始对齐：覆盖各尾部分支
+        for (size_t n = 0; n <= 64; ++n, ++cases) compare(buf.data() + off, n, off);
+    for (int i = 0; i < 400; ++i, ++cases) {
+        const size_t off = rng() % 16;
+        const size_t max_n = i < 300 ? 4096 : buf.size() - 16;
+        compare(buf.data() + off, (rng() % max_n) | size_t(i & 1), off);   // 一半为奇数长度
+    }
+    CHECK_EQ(g_mismatches, 0u);
+
+    // 分段续算（state 跨调用延续，切点非对齐）与一次算完一致
+    for (const det::Crc32Impl& im : det::crc32Impls()) {
+        const size_t n = 300001, cut = 12345;
+        const uint32_t whole = im.fn(0xFFFFFFFFu, buf.data() + 3, n);
+        CHECK_EQ(im.fn(im.fn(0xFFFFFFFFu, buf.data() + 3, cut), buf.data() + 3 + cut, n - cut), whole);
+    }
+    CHECK(det::crc32Fn() == det::crc32Impls().best().fn);
+
+    // 包校验和：aux 的 CRC 异或载荷 CRC；空载荷时只含 aux
+    hv::ethernet::PacketHeader h;
+    h.aux = 0x01020304u;
+    const uint8_t aux[] = {1, 2, 3, 4};
+    h.payload_len = 9;
+    CHECK_EQ(hv::ethernet::packetChecksum(h, reference(vec, sizeof(vec))), reference(aux, 4) ^ 0xCBF43926u);
+    h.payload_len = 0;
+    CHECK_EQ(hv::ethernet::packetChecksum(h, 0), reference(aux, 4));
+
+    std::printf("  %zu cases x %zu implementations (fastest: %s)\n", cases,
+                size_t(det::crc32Impls().end() - det::crc32Impls().begin()), det::crc32Impls().best().name);
+    return test::result("crc32");
+}
@@ -0,0 +1,202 @@
+// ethernet_scanner: EthernetDevice 的接收定界。进程内客户端经回环按线协议发送构造的包流，
+// 以随机大小分段写出（包头 / 载荷在任意字节处跨 recv、跨 slab 切开，超大包走独立缓冲），逐包比对交付的
+// seq 与载荷；另测 CRC 不符 / 非事件包 / seq 跳号的计数（跳号只按通过 CRC 的包计），以及
+// 失步（包头魔数不符）后按断连结束。
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <shimetapi/hv/ethernet_device.h>
+
+#include "check.h"
+
+using namespace Shimeta;
+namespace eth = hv::ethernet;
+
+namespace {
+
+constexpr uint16_t kPort = 18931;
+
+struct Sent {
+    uint32_t seq;
+    size_t   bytes;
+};
+
+/// 载荷内容由 seq 与偏移决定，接收端据此校验。
+uint8_t payloadByte(uint32_t seq, size_t i) { return uint8_t(seq * 131u + i * 7u + (i >> 8)); }
+
+void appendPacket(std::vector<uint8_t>& out, uint32_t seq, size_t bytes,
+                  eth::PacketType type = eth::PacketType::Event, bool corrupt = false) {
+    std::vector<uint8_t> payload(bytes);
+    for (size_t i = 0; i < bytes; ++i) payload[i] = payloadByte(seq, i);
+    eth::PacketHeader h;
+    h.type = uint8_t(type);
+    h.seq = seq;
+    h.payload_len = uint32_t(bytes);
+    h.aux = seq;
+    h.crc = eth::packetChecksum(h, eth::crc32(payload.data(), bytes));
+    if (corrupt) {
+        h.seq = 0x5EEDu;   // 损坏的包头字段：CRC 校验失败，seq 不可信
+        if (bytes) payload[bytes / 2] ^= 0x40;
+        else h.crc ^= 1;
+    }
+    const size_t at = out.size();
+    out.resize(at + eth::kHeaderBytes + bytes);
+    eth::encodeHeader(h, out.data() + at);
+    if (bytes) std::memcpy(out.data() + at + eth::kHeaderBytes, payload.data(), bytes);
+}
+
+/// 连入 EthernetDevice 的监听端口，以随机分段写出 stream 后关闭：一半分段为 1 ~ 7 B（包头 /
+/// 载荷在任意字节处切开），其余为 [1, max_piece]。
+void sendStream(const std::vector<uint8_t>& stream, size_t max_piece, unsigned seed) {
+    int fd = -1;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (std::chrono::steady_clock::now() < deadline) {
+        fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(kPort);
+        ::inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+        if (::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0) break;
+        ::close(fd);
+        fd = -1;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    if (fd < 0) return;
+    const int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    std::mt19937 rng(seed);
+    size_t off = 0, pieces = 0;
+    while (off < stream.size()) {
+        const size_t piece = (rng() & 1) ? rng() % 7 + 1 : rng() % max_piece + 1;
+        const size_t n = std::min(stream.size() - off, piece);
+        const ssize_t w = ::send(fd, stream.data() + off, n, MSG_NOSIGNAL);
+        if (w <= 0) break;
+        off += size_t(w);
+        if (++pieces % 16 == 0) std::this_thread::sleep_for(std::chrono::microseconds(200));   // 让接收端看到半包
+    }
+    ::close(fd);
+}
+
+struct Received {
+    uint64_t packets = 0, bad_payload = 0, no_owner = 0;
+    std::vector<uint32_t> seqs;
+};
+
+/// 接收整条流直到连接结束；每包按 aux（= 原 seq）校验载荷。
+Received receive(hv::EthernetDevice& dev, const std::vector<uint8_t>& stream, size_t max_piece, unsigned seed) {
+    std::thread client(sendStream, std::cref(stream), max_piece, seed);
+    Received r;
+    if (CHECK(dev.start() == Status::Ok)) {
+        hv::EventPacket pkt;
+        while (!dev.eventsEnded()) {
+            if (!dev.readEventPacket(pkt, 2000)) continue;
+            const uint8_t* p = pkt.data.data;
+            eth::PacketHeader h;
+            eth::decodeHeader(p - eth::kHeaderBytes, h);   // 载荷原地交付：包头就在其前
+            bool same = h.payload_len == pkt.data.size;
+            for (size_t i = 0; same && i < pkt.data.size; ++i) same = p[i] == payloadByte(h.aux, i);
+            r.bad_payload += !same;
+            r.no_owner += !dev.eventPacketOwner();
+            r.seqs.push_back(h.seq);
+            ++r.packets;
+        }
+    }
+    dev.stop();
+    client.join();
+    return r;
+}
+
+hv::DeviceConfig config() {
+    hv::DeviceConfig cfg;
+    cfg.backend = hv::Backend::Ethernet;
+    cfg.bind_ip = "127.0.0.1";
+    cfg.listen_port = kPort;
+    cfg.eth_recv_chunk_bytes = 64 * 1024;   // 最小 slab：多数包跨 slab，> 64 KiB 的走独立缓冲
+    cfg.eth_recv_slabs = 4;
+    return cfg;
+}
+
+/// 长度各异的包（含空包、跨 slab、超大包）以不同分段粒度送达，全部按序原样交付。
+void splitAcrossRecvAndSlabs() {
+    std::mt19937 rng(3);
+    std::vector<uint8_t> stream;
+    std::vector<Sent> sent;
+    const size_t fixed[] = {0, 1, 39, 40, 41, 4096, 65536 - 40, 65536 - 39, 65536, 200000, 3, 65000, 70000};
+    uint32_t seq = 1;
+    for (size_t n : fixed) sent.push_back({seq++, n});
+    for (int i = 0; i < 300; ++i) sent.push_back({seq++, i % 50 == 0 ? 100000 + rng() % 50000 : rng() % 20000});
+    for (const Sent& s : sent) appendPacket(stream, s.seq, s.bytes);
+
+    for (size_t max_piece : {size_t(1500), size_t(100000)}) {
+        hv::EthernetDevice dev;
+        CHECK(dev.init(config()) == Status::Ok);
+        const Received r = receive(dev, stream, max_piece, unsigned(max_piece));
+        CHECK_EQ(r.packets, sent.size());
+        CHECK_EQ(r.bad_payload, 0u);
+        CHECK_EQ(r.no_owner, 0u);
+        for (size_t i = 0; i < r.seqs.size() && i < sent.size(); ++i)
+            if (!CHECK_EQ(r.seqs[i], sent[i].seq)) break;
+        CHECK_EQ(dev.crcErrors(), 0u);
+        CHECK_EQ(dev.seqGaps(), 0u);
+        CHECK_EQ(dev.bytesReceived(), stream.size());
+        std::printf("  split (pieces <= %6zu): %llu packets, %llu recv/poll, %llu B moved\n", max_piece,
+                    (unsigned long long)r.packets, (unsigned long long)dev.recvSyscalls(),
+                    (unsigned long long)dev.copiedBytes());
+    }
+}
+
+/// CRC 不符的包丢弃且其 seq 不参与跳号；非事件包跳过但 seq 连续；真实丢包计入跳号。
+void crcAndSequence() {
+    std::vector<uint8_t> stream;
+    appendPacket(stream, 1, 100);
+    appendPacket(stream, 2, 0);
+    appendPacket(stream, 3, 100, eth::PacketType::Event, true);    // 损坏：计为 2 → 4 之间丢失的一包
+    appendPacket(stream, 4, 70000, eth::PacketType::Event, true);  // 损坏的超大包
+    appendPacket(stream, 5, 100);
+    appendPacket(stream, 6, 64, eth::PacketType::Image);           // 非事件包：跳过，seq 照常推进
+    appendPacket(stream, 7, 100);
+    appendPacket(stream, 10, 100);                                 // 丢 8、9
+    hv::EthernetDevice dev;
+    CHECK(dev.init(config()) == Status::Ok);
+    const Received r = receive(dev, stream, 512, 5);
+    CHECK_EQ(r.packets, 5u);
+    CHECK(r.seqs == std::vector<uint32_t>({1, 2, 5, 7, 10}));
+    CHECK_EQ(r.bad_payload, 0u);
+    CHECK_EQ(dev.crcErrors(), 2u);
+    CHECK_EQ(dev.skippedPackets(), 1u);
+    CHECK_EQ(dev.seqGaps(), 4u);   // 3、4（损坏）+ 8、9
+}
+
+/// 包头魔数不符时无法重新定界：之前的包照常交付，之后按断连结束。
+void desyncEndsStream() {
+    std::vector<uint8_t> stream;
+    appendPacket(stream, 1, 1000);
+    appendPacket(stream, 2, 1000);
+    stream.insert(stream.end(), 13, 0xA5);
+    appendPacket(stream, 3, 1000);
+    hv::EthernetDevice dev;
+    CHECK(dev.init(config()) == Status::Ok);
+    const Received r = receive(dev, stream, 300, 9);
+    CHECK(r.seqs == std::vector<uint32_t>({1, 2}));
+    CHECK(dev.eventsEnded());
+}
+
+} // namespace
+
+int main() {
+    splitAcrossRecvAndSlabs();
+    crcAndSequence();
+    desyncEndsStream();
+    return test::result("ethernet_scanner");
+}
@@ -0,0 +1,117 @@
+// 测试辅助：逐事件比对两串 EventCD（x / y / 极性 / 时间戳），不一致时打印前几处并计入 failures()；
+// 字流解码器（Evt2Decoder / Evt3Decoder）的切包续解与各批量路径比对。
+#ifndef SHIMETA_TESTS_EVENT_COMPARE_H
+#define SHIMETA_TESTS_EVENT_COMPARE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <shimetapi/core/event_batch.h>
+#include <shimetapi/core/event_cd.h>
+
+#include "check.h"
+
+namespace Shimeta::test {
+
+inline bool sameEvent(const EventCD& a, const EventCD& b) {
+    return a.x == b.x && a.y == b.y && a.polarity == b.polarity && a.t == b.t;
+}
+
+/// got 与 want 逐事件一致返回 true；否则打印 what、数量与前 4 处差异。
+inline bool checkEvents(const EventCD* got, size_t n_got, const std::vector<EventCD>& want, const char* what) {
+    size_t bad = n_got == want.size() ? 0 : 1;
+    if (bad) std::printf("  %s: %zu events != %zu\n", what, n_got, want.size());
+    for (size_t i = 0; i < n_got && i < want.size(); ++i) {
+        const EventCD& g = got[i];
+        const EventCD& w = want[i];
+        if (sameEvent(g, w)) continue;
+        if (bad++ < 4)
+            std::printf("  %s event %zu: (%u, %u, %d, %lld) != (%u, %u, %d, %lld)\n", what, i, g.x, g.y,
+                        int(g.polarity), (long long)g.t, w.x, w.y, int(w.polarity), (long long)w.t);
+    }
+    return check(bad == 0, what, __FILE__, __LINE__);
+}
+
+inline bool checkEvents(const std::vector<EventCD>& got, const std::vector<EventCD>& want, const char* what) {
+    return checkEvents(got.data(), got.size(), want, what);
+}
+
+inline bool checkEvents(const EventBatch& got, const std::vector<EventCD>& want, const char* what) {
+    const std::vector<EventCD> aos(got.begin(), got.end());
+    return checkEvents(aos, want, what);
+}
+
+/// 随机按字对齐切包（每包 1 ~ max_words 个 word 字节的字），返回包边界（首 0、末 bytes）。
+inline std::vector<size_t> cuts(size_t bytes, size_t word, size_t max_words, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<size_t> c{0};
+    while (c.back() < bytes) c.push_back(std::min(bytes, c.back() + word * (rng() % max_words + 1)));
+    return c;
+}
+
+/// 定长输出续解一包：写满即从 consumed 处续调，直到整包消耗。
+template <class Decoder>
+void decodeSpan(Decoder& d, const uint8_t* p, size_t len, size_t capacity, std::vector<EventCD>& out) {
+    std::vector<EventCD> buf(capacity);
+    for (;;) {
+        const auto r = d.Decode(p, len, buf.data(), buf.size());
+        out.insert(out.end(), buf.begin(), buf.begin() + r.events);
+        if (!r.needsMoreSpace()) break;
+        if (!CHECK(r.consumed > 0 || r.events > 0)) break;   // 容量不小于单字最多事件数时必有进展
+        p += r.consumed;
+        len -= r.consumed;
+    }
+}
+
+/// 字流解码器各批量路径与 want（预编译逐字解码器对整流的输出）逐事件比对。s 按 cuts(word, max_words,
+/// seed) 切包，每条路径一个解码器逐包续解：DecodeBatch、SoA Decode(EventBatch)、各 capacities 的定长
+/// 输出 Decode、容量 MaxEventsForBytes(len) + max_extra 的定长输出 Decode，以及同一解码器逐包轮换
+/// 上述路径（定长输出取 mixed_capacity；路径间共享跨包状态）。
+template <class Decoder>
+void checkDecodePaths(const std::vector<uint8_t>& s, const std::vector<EventCD>& want, size_t word,
+                      size_t max_words, unsigned seed, const std::vector<size_t>& capacities, size_t max_extra,
+                      size_t mixed_capacity) {
+    const std::vector<size_t> c = cuts(s.size(), word, max_words, seed);
+    std::vector<EventCD> batch, span_big, mixed;
+    std::vector<std::vector<EventCD>> spans(capacities.size());
+    EventBatch soa;
+    Decoder d_batch, d_soa, d_span_big, d_mixed;
+    std::vector<Decoder> d_spans(capacities.size());
+    for (size_t i = 0; i + 1 < c.size(); ++i) {
+        const uint8_t* p = s.data() + c[i];
+        const size_t len = c[i + 1] - c[i];
+        d_batch.DecodeBatch(p, len, batch);
+        d_soa.Decode(p, len, soa);
+        for (size_t k = 0; k < capacities.size(); ++k) decodeSpan(d_spans[k], p, len, capacities[k], spans[k]);
+        decodeSpan(d_span_big, p, len, Decoder::MaxEventsForBytes(len) + max_extra, span_big);
+        switch (i % 4) {   // 同一解码器逐包换路径
+        case 0: d_mixed.Decode(p, len, mixed); break;
+        case 1: d_mixed.DecodeBatch(p, len, mixed); break;
+        case 2: {
+            EventBatch b;
+            d_mixed.Decode(p, len, b);
+            mixed.insert(mixed.end(), b.begin(), b.end());
+            break;
+        }
+        default: decodeSpan(d_mixed, p, len, mixed_capacity, mixed); break;
+        }
+    }
+    checkEvents(batch, want, "DecodeBatch");
+    checkEvents(soa, want, "Decode(EventBatch)");
+    for (size_t k = 0; k < capacities.size(); ++k) {
+        char what[48];
+        std::snprintf(what, sizeof(what), "Decode(span, capacity %zu)", capacities[k]);
+        checkEvents(spans[k], want, what);
+    }
+    checkEvents(span_big, want, "Decode(span, MaxEventsForBytes)");
+    checkEvents(mixed, want, "alternating paths");
+    std::printf("  %zu words, packets <= %zu words: %zu events\n", s.size() / word, max_words, want.size());
+}
+
+} // namespace Shimeta::test
+
+#endif // SHIMETA_TESTS_EVENT_COMPARE_H
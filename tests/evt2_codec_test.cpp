@@ -0,0 +1,92 @@
+// evt2_codec: Evt2Decoder 的批量路径（DecodeBatch、SoA Decode(EventBatch)、定长输出 Decode）与预编译
+// 逐字解码器 Decode 逐事件一致。构造的字流含首个 TIME_HIGH 之前的字、冗余 / 跳变的 TIME_HIGH、
+// 外触发与未知类型字、长段连续 CD（整块 SIMD）与混排块，并跨越 2^34 µs 回绕；按随机字对齐切包
+// 续解，另测各路径逐包交替调用（共享 time-base 状态）。
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <shimetapi/codec/evt2_codec.h>
+
+#include "check.h"
+#include "event_compare.h"
+
+using namespace Shimeta;
+using codec::Evt2Decoder;
+
+namespace {
+
+uint32_t timeHigh(uint64_t t) { return (0x8u << 28) | uint32_t((t >> 6) & 0x0FFFFFFFu); }
+uint32_t cd(uint64_t t, uint16_t x, uint16_t y, bool on) {
+    return (uint32_t(on) << 28) | (uint32_t(t & 0x3F) << 22) | (uint32_t(x & 0x7FF) << 11) | uint32_t(y & 0x7FF);
+}
+
+/// 约 n 字的 EVT2 流（小端字节）。
+std::vector<uint8_t> makeStream(size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint32_t> w;
+    for (int i = 0; i < 3; ++i) w.push_back(cd(i, 1, 2, true));   // 首个 TIME_HIGH 之前：丢弃
+    uint64_t t = 1000;
+    bool jumped = false;
+    w.push_back(timeHigh(t));
+    while (w.size() < n) {
+        if (!jumped && w.size() > n * 2 / 3) {   // 跳到回绕前 5 ms
+            t = (1ull << 34) - 5000;
+            jumped = true;
+        }
+        const unsigned kind = rng() % 16;
+        if (kind < 10) {   // 一段 CD：长度跨越 8 字块边界
+            const size_t run = kind < 4 ? rng() % 40 + 8 : rng() % 6 + 1;
+            for (size_t i = 0; i < run; ++i) {
+                const uint64_t te = (t & ~uint64_t(0x3F)) + rng() % 64;
+                w.push_back(cd(te, uint16_t(rng() % 768), uint16_t(rng() % 608), rng() & 1));
+            }
+        } else if (kind < 13) {   // 时间推进：新的 TIME_HIGH，偶尔冗余重复
+            t += 64 * (rng() % 4 + 1);
+            w.push_back(timeHigh(t));
+            if (rng() % 3 == 0) w.push_back(timeHigh(t));
+        } else if (kind < 15) {   // 外触发
+            w.push_back((0xAu << 28) | (uint32_t(t & 0x3F) << 22) | (uint32_t(rng() % 32) << 8) | (rng() & 1));
+        } else {                  // 未知类型：跳过
+            w.push_back((uint32_t(rng() % 3 + 0xC) << 28) | (rng() & 0x0FFFFFFF));
+        }
+    }
+    std::vector<uint8_t> bytes(w.size() * 4);
+    for (size_t i = 0; i < w.size(); ++i) {
+        bytes[4 * i] = uint8_t(w[i]);
+        bytes[4 * i + 1] = uint8_t(w[i] >> 8);
+        bytes[4 * i + 2] = uint8_t(w[i] >> 16);
+        bytes[4 * i + 3] = uint8_t(w[i] >> 24);
+    }
+    return bytes;
+}
+
+void run(const std::vector<uint8_t>& s, size_t max_words, unsigned seed) {
+    std::vector<EventCD> want;
+    Evt2Decoder ref;
+    ref.Decode(s.data(), s.size(), want);
+    CHECK(want.size() > s.size() / 8);
+    CHECK(!want.empty() && want.back().t >= int64_t(1) << 34);   // 确实跨过了回绕
+
+    test::checkDecodePaths<Evt2Decoder>(s, want, 4, max_words, seed, {1, 7}, 1, 3);
+}
+
+} // namespace
+
+int main() {
+    const std::vector<uint8_t> s = makeStream(200000, 1);
+    run(s, 5, 2);       // 多数包短于一个 8 字块
+    run(s, 3000, 3);
+    run(s, 200000, 4);  // 整流一包
+
+    // 边界：空输入与不足一字的残余不产出事件、不改变状态
+    Evt2Decoder d;
+    std::vector<EventCD> out;
+    CHECK_EQ(d.DecodeBatch(nullptr, 0, out), 0u);
+    CHECK_EQ(d.DecodeBatch(s.data(), 3, out), 0u);
+    EventCD one;
+    const codec::DecodeResult r = d.Decode(s.data(), 3, &one, 1);
+    CHECK_EQ(r.events, 0u);
+    CHECK_EQ(r.consumed, 0u);
+    return test::result("evt2_codec");
+}
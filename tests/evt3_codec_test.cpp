@@ -0,0 +1,175 @@
+// evt3_codec: Evt3Decoder 的批量路径（DecodeBatch、SoA Decode(EventBatch)、定长输出 Decode）与预编译
+// 逐字解码器 Decode 逐事件一致。构造的字流含建立 y / base_x 之前的事件字、AddrX / Vect12 / Vect8
+// 混排（长段向量字走整块展开）、TimeLow / TimeHigh 推进、24 bit 时间翻转、小幅回退（流重启）、
+// 外触发与保留类型字；按随机字对齐切包续解，另测各路径逐包交替调用（共享状态）。
+// 编码往返：Encode 解回与输入逐事件一致；EncodeVector（分批、与 Encode 交替）解回的时间戳序列
+// 与输入一致、同一时间戳内事件多重集一致（段内已按 (y, x, polarity) 有序时顺序也一致），
+// 且稠密行上比 Encode 紧凑。
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <shimetapi/codec/evt3_codec.h>
+
+#include "check.h"
+#include "event_compare.h"
+
+using namespace Shimeta;
+using codec::Evt3Decoder;
+
+namespace {
+
+uint16_t word(unsigned type, unsigned payload) { return uint16_t((type << 12) | (payload & 0xFFF)); }
+
+/// 约 n 字的 EVT3 流（小端字节）。
+std::vector<uint8_t> makeStream(size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint16_t> w;
+    w.push_back(word(0x1, 5));        // AddrX：尚无 y，丢弃
+    w.push_back(word(0x3, 0xFFF));    // Vect12：尚无 base_x / y，丢弃
+    w.push_back(word(0x7, 0xFF0));    // TimeHigh 接近 12 bit 上限，很快翻转
+    uint32_t th = 0xFF0;
+    while (w.size() < n) {
+        const unsigned kind = rng() % 32;
+        if (kind < 4) {
+            w.push_back(word(0x0, rng() % 608));                                  // AddrY
+        } else if (kind < 10) {
+            for (unsigned i = rng() % 8 + 1; i-- > 0;)
+                w.push_back(word(0x1, (rng() % 768) | ((rng() & 1) << 11)));      // AddrX（bit 11 极性）
+        } else if (kind < 18) {
+            w.push_back(word(0x2, rng() % 740));                                  // VectBaseX
+            for (unsigned i = rng() % 24 + 1; i-- > 0;)                           // 长段向量字
+                w.push_back(rng() % 3 ? word(0x3, rng()) : word(0x4, rng() & 0xFF));
+        } else if (kind < 24) {
+            w.push_back(word(0x6, rng()));                                        // TimeLow
+        } else if (kind < 28) {
+            th = (th + rng() % 3) & 0xFFF;                                        // TimeHigh：推进，跨 0xFFF 翻转
+            w.push_back(word(0x7, th));
+        } else if (kind < 30) {
+            w.push_back(word(0x8 + rng() % 8, rng()));                            // 外触发与保留类型
+        } else if (kind == 30 && rng() % 64 == 0) {
+            th = (th + 0x1000 - 0x10) & 0xFFF;                                    // 小幅回退：流重启
+            w.push_back(word(0x7, th));
+        } else {
+            w.push_back(word(0x5, rng()));                                        // 保留类型 0x5
+        }
+    }
+    std::vector<uint8_t> bytes(w.size() * 2);
+    for (size_t i = 0; i < w.size(); ++i) {
+        bytes[2 * i] = uint8_t(w[i]);
+        bytes[2 * i + 1] = uint8_t(w[i] >> 8);
+    }
+    return bytes;
+}
+
+void run(const std::vector<uint8_t>& s, size_t max_words, unsigned seed) {
+    std::vector<EventCD> want;
+    Evt3Decoder ref;
+    ref.Decode(s.data(), s.size(), want);
+    CHECK(want.size() > s.size());
+    const auto later = [](const EventCD& a, const EventCD& b) { return a.t < b.t; };
+    CHECK(!want.empty() && std::max_element(want.begin(), want.end(), later)->t >= int64_t(1) << 24);   // 确有翻转
+
+    test::checkDecodePaths<Evt3Decoder>(s, want, 2, max_words, seed, {12, 50}, 0, 13);
+}
+
+/// 编码往返用事件：同一时间戳一段，段内有稠密行（同行连续像素）、散点与同像素重复，
+/// 时间跨 2^24 µs；sorted 为真时段内按 (y, x, polarity) 排好。
+std::vector<EventCD> makeEvents(size_t n, bool sorted, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<EventCD> ev;
+    int64_t t = (int64_t(1) << 24) - 200000;
+    while (ev.size() < n) {
+        t += 1 + (rng() % 5 ? rng() % 40 : rng() % 9000);   // 多数只变 TimeLow，偶尔跨 TimeHigh
+        const size_t seg = ev.size();
+        for (unsigned rows = rng() % 3; rows-- > 0;) {   // 稠密行：8 ~ 40 个连续像素
+            const uint16_t y = uint16_t(rng() % 608), x0 = uint16_t(rng() % 700);
+            for (unsigned i = 0, len = rng() % 33 + 8; i < len && x0 + i < 768; ++i)
+                ev.push_back(EventCD{uint16_t(x0 + i), y, t, bool(rng() & 1)});
+        }
+        for (unsigned k = rng() % 12; k-- > 0;)
+            ev.push_back(EventCD{uint16_t(rng() % 768), uint16_t(rng() % 608), t, bool(rng() & 1)});
+        if (ev.size() > seg && rng() % 4 == 0) ev.push_back(ev[seg]);   // 同像素重复
+        if (sorted) {
+            std::sort(ev.begin() + long(seg), ev.end(), [](const EventCD& a, const EventCD& b) {
+                return codec::detail::evt3Key(a) < codec::detail::evt3Key(b);
+            });
+        } else {
+            std::shuffle(ev.begin() + long(seg), ev.end(), rng);
+        }
+    }
+    return ev;
+}
+
+std::vector<EventCD> decodeAll(const std::vector<uint8_t>& bytes) {
+    std::vector<EventCD> out;
+    Evt3Decoder d;
+    d.DecodeBatch(bytes.data(), bytes.size(), out);
+    return out;
+}
+
+/// 时间戳序列逐个相等，且按 (t, y, x, polarity) 排序后逐事件一致（即同一时间戳内多重集相等）。
+void checkSameMultiset(std::vector<EventCD> got, std::vector<EventCD> want, const char* what) {
+    bool same_t = got.size() == want.size();
+    for (size_t i = 0; same_t && i < got.size(); ++i) same_t = got[i].t == want[i].t;
+    test::check(same_t, what, __FILE__, __LINE__);
+    const auto less = [](const EventCD& a, const EventCD& b) {
+        return a.t != b.t ? a.t < b.t : codec::detail::evt3Key(a) < codec::detail::evt3Key(b);
+    };
+    std::sort(got.begin(), got.end(), less);
+    std::sort(want.begin(), want.end(), less);
+    test::checkEvents(got, want, what);
+}
+
+void encodeRoundTrip() {
+    const std::vector<EventCD> ev = makeEvents(400000, false, 5);
+    const std::vector<EventCD> ev_sorted = makeEvents(400000, true, 6);
+
+    std::vector<uint8_t> scalar;
+    codec::Evt3Encoder enc;
+    enc.Encode(ev.data(), ev.size(), scalar);
+    test::checkEvents(decodeAll(scalar), ev, "Encode round trip");
+
+    // 分批编码：批边界可落在同一时间戳段内
+    std::mt19937 rng(7);
+    std::vector<uint8_t> vec, mixed;
+    codec::Evt3Encoder enc_vec, enc_mixed;
+    for (size_t i = 0, k = 0; i < ev.size(); ++k) {
+        const size_t n = std::min(ev.size() - i, size_t(rng() % 5000 + 1));
+        enc_vec.EncodeVector(ev.data() + i, n, vec);
+        if (k % 2) enc_mixed.EncodeVector(ev.data() + i, n, mixed);
+        else enc_mixed.Encode(ev.data() + i, n, mixed);
+        i += n;
+    }
+    checkSameMultiset(decodeAll(vec), ev, "EncodeVector round trip");
+    checkSameMultiset(decodeAll(mixed), ev, "Encode / EncodeVector alternating round trip");
+    CHECK(vec.size() * 10 < scalar.size() * 7);   // 稠密行合成向量字，至少省 30%
+
+    std::vector<uint8_t> vec_sorted;
+    codec::Evt3Encoder enc_sorted;
+    enc_sorted.EncodeVector(ev_sorted.data(), ev_sorted.size(), vec_sorted);
+    test::checkEvents(decodeAll(vec_sorted), ev_sorted, "EncodeVector round trip (sorted segments)");
+    std::printf("  encode %zu events: Encode %zu B, EncodeVector %zu B\n", ev.size(), scalar.size(), vec.size());
+}
+
+} // namespace
+
+int main() {
+    const std::vector<uint8_t> s = makeStream(300000, 1);
+    run(s, 7, 2);
+    run(s, 5000, 3);
+    run(s, 300000, 4);   // 整流一包
+
+    // 边界：奇数长度拒绝且不改变状态
+    Evt3Decoder d;
+    std::vector<EventCD> out;
+    CHECK_EQ(d.DecodeBatch(s.data(), 3, out), 0u);
+    EventCD buf[12];
+    const codec::DecodeResult r = d.Decode(s.data(), 3, buf, 12);
+    CHECK(r.status == Status::ErrInvalidParam);
+    CHECK_EQ(r.consumed, 0u);
+
+    encodeRoundTrip();
+    return test::result("evt3_codec");
+}
@@ -0,0 +1,148 @@
+// frame_fanout: FrameFanout 的多订阅方分发。各订阅方按自己的深度与策略计丢帧（DropOldest 只留最新的
+// depth 帧，Block 不丢），Frame::seq 连续；各队列共享同一 slab（引用计数随入队 / 取走增减，最后一个
+// 订阅方释放后归还池）；Block 订阅方满时阻塞 Publish，排在它前面的有损订阅方照常收帧，Unsubscribe
+// 唤醒被阻塞的 Publish 与 Pop；Close 后 Publish 不再分发、新订阅即为已关闭。
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <shimetapi/core/slab_pool.h>
+#include <shimetapi/hv/frame_fanout.h>
+
+#include "check.h"
+
+using namespace Shimeta;
+using Policy = hv::DeviceConfig::QueuePolicy;
+
+namespace {
+
+hv::SubscriberOptions options(const char* name, size_t depth, Policy policy) {
+    hv::SubscriberOptions o;
+    o.name = name;
+    o.depth = depth;
+    o.policy = policy;
+    return o;
+}
+
+Frame frameWithId(int id) {
+    Frame f;
+    f.frame_id = id;
+    return f;
+}
+
+void dropCounters() {
+    hv::FrameFanout fan;
+    auto shallow = fan.Subscribe(options("display", 2, Policy::DropOldest));
+    auto deep = fan.Subscribe(options("ml", 5, Policy::DropOldest));
+    auto lossless = fan.Subscribe(options("record", 3, Policy::Block));
+    CHECK_EQ(fan.SubscriberCount(), 3u);
+
+    constexpr int kFrames = 10;
+    std::vector<uint64_t> recorded;
+    std::thread recorder([&] {
+        Frame f;
+        while (recorded.size() < size_t(kFrames) && lossless->Pop(f, 5000)) recorded.push_back(f.seq);
+    });
+    for (int i = 0; i < kFrames; ++i) fan.Publish(frameWithId(i));
+    recorder.join();
+    CHECK_EQ(fan.Published(), uint64_t(kFrames));
+
+    CHECK_EQ(shallow->Delivered(), uint64_t(kFrames));
+    CHECK_EQ(shallow->Dropped(), uint64_t(kFrames - 2));
+    CHECK_EQ(shallow->Pending(), 2u);
+    CHECK_EQ(deep->Dropped(), uint64_t(kFrames - 5));
+    CHECK_EQ(deep->Pending(), 5u);
+    CHECK_EQ(lossless->Dropped(), 0u);
+    CHECK_EQ(lossless->Popped(), uint64_t(kFrames));
+
+    Frame f;
+    CHECK(shallow->Pop(f, 0) && f.seq == 9 && f.frame_id == 8);   // 只留最新的两帧
+    CHECK(shallow->Pop(f, 0) && f.seq == 10);
+    CHECK(!shallow->Pop(f, 0));
+    CHECK(deep->Pop(f, 0) && f.seq == 6);
+    CHECK_EQ(shallow->Popped(), 2u);
+
+    bool consecutive = recorded.size() == size_t(kFrames);
+    for (size_t i = 0; consecutive && i < recorded.size(); ++i) consecutive = recorded[i] == i + 1;
+    CHECK(consecutive);
+}
+
+void sharedSlab() {
+    SlabPool pool(4096, 2);
+    hv::FrameFanout fan;
+    auto a = fan.Subscribe(options("a", 4, Policy::DropOldest));
+    auto b = fan.Subscribe(options("b", 4, Policy::Block));
+    Frame f;
+    f.evs_owner = pool.acquire();
+    if (!CHECK(f.evs_owner)) return;
+    f.evs = BufferView{f.evs_owner.get(), 100};
+    const uint8_t* data = f.evs_owner.get();
+    fan.Publish(f);
+    CHECK_EQ(f.evs_owner.use_count(), 3);   // 本地 + 两个订阅方队列，未拷贝载荷
+    f = Frame{};
+    CHECK_EQ(pool.available(), 1u);
+
+    Frame fa, fb;
+    CHECK(a->Pop(fa, 0) && b->Pop(fb, 0));
+    CHECK(fa.evs.data == data && fb.evs.data == data);
+    CHECK(fa.evs_owner.get() == fb.evs_owner.get());
+    CHECK_EQ(fa.evs_owner.use_count(), 2);
+    fa = Frame{};
+    CHECK_EQ(pool.available(), 1u);   // 还有一个订阅方持有
+    fb = Frame{};
+    CHECK_EQ(pool.available(), 2u);   // 最后一个释放后归还
+}
+
+void unsubscribeWakesPublish() {
+    hv::FrameFanout fan;
+    auto blocking = fan.Subscribe(options("record", 1, Policy::Block));
+    auto lossy = fan.Subscribe(options("display", 1, Policy::DropOldest));   // 排在 Block 之前
+    fan.Publish(frameWithId(1));   // 占满 Block 队列
+    std::atomic<bool> done{false};
+    std::thread publisher([&] {
+        fan.Publish(frameWithId(2));
+        done = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CHECK(!done);   // 被 Block 订阅方阻塞
+    Frame f;
+    CHECK(lossy->Pop(f, 1000) && f.frame_id == 2);   // 有损订阅方先于 Block 入队，不受阻塞
+    const auto t0 = std::chrono::steady_clock::now();
+    fan.Unsubscribe(blocking);
+    publisher.join();
+    CHECK(std::chrono::steady_clock::now() - t0 < std::chrono::seconds(1));
+    CHECK(blocking->Closed());
+    CHECK(!blocking->Pop(f, 0));   // 退订即丢弃排队帧
+    CHECK_EQ(fan.SubscriberCount(), 1u);
+
+    // 阻塞在 Pop 上的消费方同样被唤醒
+    auto waiting = fan.Subscribe(options("idle", 1, Policy::Block));
+    std::atomic<bool> popped{true};
+    std::thread consumer([&] {
+        Frame g;
+        popped = waiting->Pop(g, -1);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    fan.Unsubscribe(waiting);
+    consumer.join();
+    CHECK(!popped);
+
+    fan.Close();
+    fan.Publish(frameWithId(3));
+    CHECK_EQ(fan.Published(), 2u);
+    CHECK(lossy->Closed());
+    CHECK(fan.Subscribe(options("late", 1, Policy::DropOldest))->Closed());
+}
+
+} // namespace
+
+int main() {
+    dropCounters();
+    sharedSlab();
+    unsubscribeWakesPublish();
+    return test::result("frame_fanout");
+}
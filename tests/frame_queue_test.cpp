@@ -0,0 +1,152 @@
+// frame_queue: VirtualCamera 内部 BoundedQueue 的批量出队。凑满 max 条即返回；不满时按窗口到期
+// 交付，窗口从队首条目的入队时刻算起；空窗口顺延到有数据为止，timeout 到期返回 0；close() 唤醒
+// 等待中的消费方；max 超过容量时按容量截断，Block 下的生产者不因凑批而卡住。FIFO 顺序不变。
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <shimetapi/hv/detail/frame_queue.h>
+
+#include "check.h"
+
+using namespace Shimeta;
+using Queue = hv::detail::BoundedQueue<int>;
+using Policy = hv::DeviceConfig::QueuePolicy;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+namespace {
+
+int64_t msSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration_cast<milliseconds>(std::chrono::steady_clock::now() - t0).count();
+}
+
+void fullBatch() {
+    Queue q;
+    q.configure(8, Policy::DropOldest);
+    for (int i = 0; i < 5; ++i) CHECK(q.push(int(i)));
+    std::vector<int> out;
+    const auto t0 = std::chrono::steady_clock::now();
+    CHECK_EQ(q.popBatch(out, 3, microseconds(milliseconds(2000)), 5000), 3u);   // 已满：不等窗口
+    CHECK(msSince(t0) < 1000);
+    CHECK(out == std::vector<int>({0, 1, 2}));
+    CHECK_EQ(q.size(), 2u);
+
+    // 凑批期间逐条入队，凑满即醒
+    std::thread producer([&] {
+        for (int i = 5; i < 8; ++i) {
+            std::this_thread::sleep_for(milliseconds(10));
+            q.push(int(i));
+        }
+    });
+    out.clear();
+    const auto t1 = std::chrono::steady_clock::now();
+    CHECK_EQ(q.popBatch(out, 5, microseconds(milliseconds(2000)), 5000), 5u);
+    producer.join();
+    CHECK(msSince(t1) < 1000);
+    CHECK(out == std::vector<int>({3, 4, 5, 6, 7}));
+}
+
+void partialBatchFromHead() {
+    Queue q;
+    q.configure(8, Policy::DropOldest);
+    const auto t0 = std::chrono::steady_clock::now();
+    q.push(1);
+    std::this_thread::sleep_for(milliseconds(200));
+    std::vector<int> out;
+    const auto t1 = std::chrono::steady_clock::now();
+    // 窗口 300 ms 从队首入队算起：约 100 ms 后交付，而不是从调用时刻再等 300 ms
+    CHECK_EQ(q.popBatch(out, 4, microseconds(milliseconds(300)), 5000), 1u);
+    const int64_t waited = msSince(t1);
+    CHECK(msSince(t0) >= 295);
+    CHECK(waited < 250);
+    CHECK(out == std::vector<int>({1}));
+
+    // 空队列：窗口从开始等待时刻算起，到期交付已到的部分批
+    std::thread producer([&] {
+        std::this_thread::sleep_for(milliseconds(20));
+        q.push(2);
+    });
+    out.clear();
+    const auto t2 = std::chrono::steady_clock::now();
+    CHECK_EQ(q.popBatch(out, 4, microseconds(milliseconds(150)), 5000), 1u);
+    producer.join();
+    CHECK(msSince(t2) >= 145);
+    CHECK(out == std::vector<int>({2}));
+}
+
+void emptyWindowRollsOver() {
+    Queue q;
+    q.configure(8, Policy::DropOldest);
+    std::vector<int> out;
+    auto t0 = std::chrono::steady_clock::now();
+    CHECK_EQ(q.popBatch(out, 4, microseconds(milliseconds(20)), 100), 0u);   // 无数据：timeout 到期返回 0
+    CHECK(msSince(t0) >= 95);
+
+    // 数据在第若干个窗口才到：空窗口顺延，不提前返回 0
+    std::thread producer([&] {
+        std::this_thread::sleep_for(milliseconds(150));
+        q.push(7);
+    });
+    t0 = std::chrono::steady_clock::now();
+    CHECK_EQ(q.popBatch(out, 4, microseconds(milliseconds(20)), 5000), 1u);
+    producer.join();
+    CHECK(msSince(t0) >= 145);
+    CHECK(out == std::vector<int>({7}));
+}
+
+void closeWakes() {
+    Queue q;
+    q.configure(8, Policy::DropOldest);
+    size_t got = 1;
+    std::thread consumer([&] {
+        std::vector<int> out;
+        got = q.popBatch(out, 4, microseconds(milliseconds(10000)), -1);
+    });
+    std::this_thread::sleep_for(milliseconds(50));
+    const auto t0 = std::chrono::steady_clock::now();
+    q.close();
+    consumer.join();
+    CHECK_EQ(got, 0u);
+    CHECK(msSince(t0) < 1000);
+    CHECK(!q.push(1));   // 关闭后拒绝入队
+}
+
+void blockProducerProgress() {
+    Queue q;
+    q.configure(2, Policy::Block);
+    constexpr int kItems = 20;
+    std::thread producer([&] {
+        for (int i = 0; i < kItems; ++i) q.push(int(i));
+    });
+    // max 8 > 容量 2：按容量截断，每批凑满 2 条即返回；否则生产者卡在队满、每批都要等满 1 s 窗口
+    std::vector<int> out;
+    const auto t0 = std::chrono::steady_clock::now();
+    while (out.size() < size_t(kItems) && msSince(t0) < 5000) {
+        const size_t before = out.size();
+        const size_t n = q.popBatch(out, 8, microseconds(milliseconds(1000)), 5000);
+        CHECK(n <= 2u && out.size() == before + n);
+    }
+    producer.join();
+    CHECK(msSince(t0) < 1000);
+    CHECK_EQ(out.size(), size_t(kItems));
+    bool ordered = true;
+    for (int i = 0; i < int(out.size()); ++i) ordered &= out[size_t(i)] == i;
+    CHECK(ordered);
+    CHECK_EQ(q.dropped(), 0u);
+    CHECK(q.peak() <= 2u);
+}
+
+} // namespace
+
+int main() {
+    fullBatch();
+    partialBatchFromHead();
+    emptyWindowRollsOver();
+    closeWakes();
+    blockProducerProgress();
+    return test::result("frame_queue");
+}
@@ -0,0 +1,116 @@
+// frame_sequencer: FrameSequencer 的边沿触发取帧。WaitForNext 只在出现比 last_seq 新的帧时返回，取到
+// 最新一帧并报告其间跳过的帧数；无新帧时按 timeout 返回 false，last_seq 超前时同样等待；Publish 唤醒
+// 等待方；只保留最新帧的 slab 引用；Close 唤醒等待方并释放所持帧，之后立即返回 false。
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+#include <shimetapi/core/slab_pool.h>
+#include <shimetapi/hv/frame_sequencer.h>
+
+#include "check.h"
+
+using namespace Shimeta;
+
+namespace {
+
+Frame frameWithId(int id) {
+    Frame f;
+    f.frame_id = id;
+    return f;
+}
+
+void skippedCount() {
+    hv::FrameSequencer seq;
+    CHECK_EQ(seq.LastSeq(), 0u);
+    Frame f;
+    uint64_t skipped = 99;
+    seq.Publish(frameWithId(10));
+    CHECK(seq.WaitForNext(f, 0, 0, &skipped));
+    CHECK_EQ(f.seq, 1u);
+    CHECK_EQ(f.frame_id, 10);
+    CHECK_EQ(skipped, 0u);
+
+    for (int i = 11; i <= 14; ++i) seq.Publish(frameWithId(i));   // 等待方慢于到达率
+    CHECK(seq.WaitForNext(f, 1, 0, &skipped));
+    CHECK_EQ(f.seq, 5u);
+    CHECK_EQ(f.frame_id, 14);                                     // 只交最新帧
+    CHECK_EQ(skipped, 3u);
+    CHECK_EQ(seq.LastSeq(), 5u);
+
+    // 从更早的序号续取：跳过数按 last_seq 算
+    CHECK(seq.WaitForNext(f, 2, 0, &skipped));
+    CHECK_EQ(skipped, 2u);
+    CHECK(seq.WaitForNext(f, 0, 0));   // skipped 可为空
+
+    // 无新帧 / last_seq 超前：等到超时
+    for (const uint64_t last : {uint64_t(5), uint64_t(8)}) {
+        const auto t0 = std::chrono::steady_clock::now();
+        CHECK(!seq.WaitForNext(f, last, 30, &skipped));
+        CHECK(std::chrono::steady_clock::now() - t0 >= std::chrono::milliseconds(29));
+    }
+}
+
+void publishWakes() {
+    hv::FrameSequencer seq;
+    seq.Publish(frameWithId(1));
+    std::atomic<bool> got{false};
+    uint64_t got_seq = 0, skipped = 99;
+    std::thread waiter([&] {
+        Frame f;
+        got = seq.WaitForNext(f, 1, -1, &skipped);
+        got_seq = f.seq;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    CHECK(!got);
+    seq.Publish(frameWithId(2));
+    waiter.join();
+    CHECK(got);
+    CHECK_EQ(got_seq, 2u);
+    CHECK_EQ(skipped, 0u);
+}
+
+void latestOnlyAndClose() {
+    SlabPool pool(4096, 2);
+    hv::FrameSequencer seq;
+    {
+        Frame f;
+        f.evs_owner = pool.acquire();
+        seq.Publish(f);
+    }
+    CHECK_EQ(pool.available(), 1u);   // 序列器持有最新帧
+    {
+        Frame f;
+        f.evs_owner = pool.acquire();
+        seq.Publish(f);
+    }
+    CHECK_EQ(pool.available(), 1u);   // 上一帧被替换即归还
+
+    std::atomic<bool> returned{false}, got{true};
+    std::thread waiter([&] {
+        Frame f;
+        got = seq.WaitForNext(f, seq.LastSeq(), -1);
+        returned = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    CHECK(!returned);
+    seq.Close();
+    waiter.join();
+    CHECK(!got);
+    CHECK_EQ(pool.available(), 2u);   // Close 释放所持帧
+    seq.Publish(frameWithId(3));
+    Frame f;
+    CHECK(!seq.WaitForNext(f, 0, 0));   // 关闭后立即返回
+}
+
+} // namespace
+
+int main() {
+    skippedCount();
+    publishWakes();
+    latestOnlyAndClose();
+    return test::result("frame_sequencer");
+}
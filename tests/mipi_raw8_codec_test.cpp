@@ -0,0 +1,138 @@
+// mipi_raw8_codec: MipiRaw8Decoder 的位图扫描路径（DecodeBatch、SoA Decode(EventBatch)、定长输出
+// Decode）与预编译逐像素解码器 Decode 逐事件一致。构造的子帧含空帧、稀疏像素、整行、全随机
+// （含像素值 3）与头无效帧；包长覆盖各帧率档子帧数、非 4 倍数、带不足一子帧的尾部，以及显式
+// subframe_count。子帧并行解码器（1 / 2 / 4 个 worker，实例跨包复用）与之同样逐事件一致。
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <shimetapi/codec/mipi_raw8_codec.h>
+#include <shimetapi/codec/mipi_raw8_parallel.h>
+
+#include "check.h"
+#include "event_compare.h"
+
+using namespace Shimeta;
+using codec::MipiRaw8Decoder;
+using codec::MipiRaw8Layout;
+
+namespace {
+
+constexpr size_t kSub = MipiRaw8Layout::kSubframeBytes;
+
+enum class Fill { Empty, Sparse, Rows, Random, BadHeader, BadId };
+
+/// 一个子帧：头（时间戳 t_us、交错 id）+ 按 fill 填充的 2-bit 像素区。
+void makeSubframe(uint8_t* sub, Fill fill, int64_t t_us, uint32_t id, std::mt19937& rng) {
+    std::memset(sub, 0, kSub);
+    uint64_t head = (uint64_t(t_us) * 100u << 25) | 0xFFFFu;
+    uint64_t meta = uint64_t(id) << 44;
+    if (fill == Fill::BadHeader) head ^= 0x10000u;   // 掩码位不符
+    if (fill == Fill::BadId) meta = uint64_t(4 + rng() % 12) << 44;
+    std::memcpy(sub, &head, 8);
+    std::memcpy(sub + 8, &meta, 8);
+    uint8_t* px = sub + codec::detail::kRaw8HeaderBytes;
+    const size_t px_bytes = size_t(codec::detail::kRaw8Rows) * codec::detail::kRaw8WordsPerRow * 8;
+    switch (fill) {
+    case Fill::Empty: break;
+    case Fill::Sparse:
+        for (unsigned k = rng() % 300; k-- > 0;) {
+            const size_t bit = 2 * (rng() % (px_bytes * 4));
+            px[bit / 8] |= uint8_t((rng() % 3 + 1) << (bit % 8));
+        }
+        break;
+    case Fill::Rows:
+        for (unsigned k = rng() % 6 + 1; k-- > 0;)
+            std::memset(px + size_t(rng() % codec::detail::kRaw8Rows) * codec::detail::kRaw8WordsPerRow * 8,
+                        int(rng() & 0xFF), codec::detail::kRaw8WordsPerRow * 8);
+        break;
+    default:   // Random 与两种头无效帧：像素区全随机
+        for (size_t i = 0; i < px_bytes; ++i) px[i] = uint8_t(rng());
+        break;
+    }
+}
+
+std::vector<uint8_t> makePacket(size_t subframes, size_t tail, int64_t t0, std::mt19937& rng) {
+    std::vector<uint8_t> p(subframes * kSub + tail);
+    for (size_t s = 0; s < subframes; ++s) {
+        const unsigned r = rng() % 16;
+        const Fill fill = r < 3 ? Fill::Empty : r < 9 ? Fill::Sparse : r < 12 ? Fill::Rows
+                        : r < 14 ? Fill::Random : r < 15 ? Fill::BadHeader : Fill::BadId;
+        makeSubframe(p.data() + s * kSub, fill, t0 + int64_t(s / 4) * 1000, uint32_t(s % 4), rng);
+    }
+    for (size_t i = 0; i < tail; ++i) p[subframes * kSub + i] = uint8_t(rng());
+    return p;
+}
+
+/// 定长输出续解：以子帧为单位推进，subframe_count 按已处理子帧数递减（自动档不变）。
+std::vector<EventCD> decodeSpan(MipiRaw8Decoder& d, const uint8_t* p, size_t len, size_t capacity, int count) {
+    std::vector<EventCD> out, buf(capacity);
+    for (;;) {
+        const codec::DecodeResult r = d.Decode(p, len, buf.data(), buf.size(), count);
+        out.insert(out.end(), buf.begin(), buf.begin() + r.events);
+        if (!r.needsMoreSpace()) break;
+        if (!CHECK(r.consumed > 0)) break;   // capacity >= MaxEventsForBytes(kSub) 时必有进展
+        p += r.consumed;
+        len -= r.consumed;
+        if (count > 0) count -= int(r.consumed / kSub);
+    }
+    return out;
+}
+
+struct Shape {
+    size_t subframes, tail;
+    int    count;   ///< 显式 subframe_count（0 = 自动）
+};
+
+} // namespace
+
+int main() {
+    const Shape shapes[] = {
+        {16, 0, 0}, {32, 0, 0}, {128, 0, 0},   // 120 / 240 / 1000 fps 档
+        {5, 0, 0},                             // 非 4 倍数
+        {3, 1000, 0},                          // 尾部不足一子帧：忽略
+        {8, 0, 2}, {8, 0, 20},                 // 显式 subframe_count（小于 / 大于实际）
+        {1, 0, 0},
+    };
+    std::mt19937 rng(1);
+    MipiRaw8Decoder ref, dec;
+    codec::MipiRaw8ParallelDecoder par1(1), par2(2), par4(4);
+    size_t total = 0;
+    for (int round = 0; round < 4; ++round) {
+        for (const Shape& sh : shapes) {
+            const std::vector<uint8_t> p = makePacket(sh.subframes, sh.tail, round * 100000, rng);
+            std::vector<EventCD> want;
+            ref.Decode(p.data(), p.size(), want, sh.count);
+            total += want.size();
+
+            std::vector<EventCD> batch{EventCD{1, 2, 3, true}};   // 非空：DecodeBatch 须先清空
+            dec.DecodeBatch(p.data(), p.size(), batch, sh.count);
+            test::checkEvents(batch, want, "DecodeBatch");
+            EventBatch soa;
+            soa.push_back(EventCD{1, 2, 3, true});
+            dec.Decode(p.data(), p.size(), soa, sh.count);
+            test::checkEvents(soa, want, "Decode(EventBatch)");
+            test::checkEvents(decodeSpan(dec, p.data(), p.size(), MipiRaw8Decoder::MaxEventsForBytes(kSub), sh.count),
+                              want, "Decode(span, one subframe)");
+            test::checkEvents(decodeSpan(dec, p.data(), p.size(), MipiRaw8Decoder::MaxEventsForBytes(p.size()), sh.count),
+                              want, "Decode(span, whole packet)");
+            std::vector<EventCD> par;
+            par1.Decode(p.data(), p.size(), par, sh.count);
+            test::checkEvents(par, want, "MipiRaw8ParallelDecoder(1)");
+            par2.Decode(p.data(), p.size(), par, sh.count);
+            test::checkEvents(par, want, "MipiRaw8ParallelDecoder(2)");
+            par4.Decode(p.data(), p.size(), par, sh.count);
+            test::checkEvents(par, want, "MipiRaw8ParallelDecoder(4)");
+        }
+    }
+    CHECK(total > 0);
+
+    // 边界：不足一个子帧不产出事件
+    std::vector<EventCD> out;
+    CHECK_EQ(dec.DecodeBatch(nullptr, 0, out), 0u);
+    const std::vector<uint8_t> short_pkt(kSub - 1, 0xFF);
+    CHECK_EQ(dec.DecodeBatch(short_pkt.data(), short_pkt.size(), out), 0u);
+    std::printf("  %zu packets, %zu events\n", sizeof(shapes) / sizeof(shapes[0]) * 4, total);
+    return test::result("mipi_raw8_codec");
+}
@@ -0,0 +1,238 @@
+// size_class_pool: SizeClassPool 的分档与增长。请求落在能容纳它的最小档（2 的幂边界、非 2 的幂的
+// max_slab 为最高档、超出 max_request 取不到）；各档按 grow_slabs 增长到 class_slabs 为止，块数不超过
+// kMaxChunks（grow_slabs 自动放大）；max_bytes 到顶时拒绝增长；本档到上限时向更大档借空闲 slab；
+// requests / borrowed / exhausted / failed / waits 按档计数，resetStats 清零；reserve 只预留最高档；
+// 全池耗尽时限时等待被任一档的归还唤醒；低水位按档边沿触发（可取数含增长余量与更大档空闲），
+// 回调在锁外、可重入本池。
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <shimetapi/core/size_class_pool.h>
+
+#include "check.h"
+
+using namespace Shimeta;
+
+namespace {
+
+SizeClassPoolOptions options(size_t min_slab, size_t max_slab, size_t class_slabs, size_t grow_slabs) {
+    SizeClassPoolOptions o;
+    o.min_slab = min_slab;
+    o.max_slab = max_slab;
+    o.class_slabs = class_slabs;
+    o.grow_slabs = grow_slabs;
+    return o;
+}
+
+/// 请求 bytes 得到的 slab 大小（取不到为 0）。
+size_t slabFor(SizeClassPool& pool, size_t bytes) { return pool.acquireRef(bytes).size(); }
+
+void classes() {
+    SizeClassPool pool(options(3000, 100000, 2, 1));   // 最小档取整到 4096，最高档为 100000
+    CHECK_EQ(pool.class_count(), 6u);                   // 4K 8K 16K 32K 64K 100000
+    CHECK_EQ(pool.max_request(), 100000u);
+    CHECK_EQ(slabFor(pool, 0), 4096u);
+    CHECK_EQ(slabFor(pool, 1), 4096u);
+    CHECK_EQ(slabFor(pool, 4096), 4096u);
+    CHECK_EQ(slabFor(pool, 4097), 8192u);
+    CHECK_EQ(slabFor(pool, 32768), 32768u);
+    CHECK_EQ(slabFor(pool, 32769), 65536u);
+    CHECK_EQ(slabFor(pool, 65536), 65536u);
+    CHECK_EQ(slabFor(pool, 65537), 100000u);
+    CHECK_EQ(slabFor(pool, 100000), 100000u);
+    CHECK_EQ(slabFor(pool, 100001), 0u);   // 超出 max_request：不计入任何档
+    uint64_t requests = 0;
+    for (const SizeClassStats& s : pool.stats()) requests += s.requests;
+    CHECK_EQ(requests, 9u);
+    CHECK_EQ(pool.stats().back().slab_size, 100000u);
+
+    SizeClassPool pow2(options(4096, 65536, 2, 1));   // 2 的幂的 max_slab：不多出一档
+    CHECK_EQ(pow2.class_count(), 5u);
+    CHECK_EQ(slabFor(pow2, 65536), 65536u);
+    SizeClassPool single(options(4096, 100, 2, 1));   // max_slab < min_slab：只有 min_slab 一档
+    CHECK_EQ(single.class_count(), 1u);
+    CHECK_EQ(single.max_request(), 4096u);
+    CHECK_EQ(slabFor(single, 4096), 4096u);
+}
+
+void growthAndBorrowing() {
+    SizeClassPool pool(options(4096, 16384, 5, 2));
+    CHECK_EQ(pool.reserved_bytes(), 0u);   // 不 reserve：构造时不映射
+    std::vector<SlabRef> held;
+    for (int i = 0; i < 5; ++i) held.push_back(pool.acquireRef(4096));
+    std::vector<SizeClassStats> s = pool.stats();
+    CHECK_EQ(s[0].capacity, 5u);   // 2 + 2 + 1：最后一块只补到上限
+    CHECK_EQ(s[0].chunks, 3u);
+    CHECK_EQ(s[0].in_use, 5u);
+    CHECK_EQ(pool.reserved_bytes(), 5u * 4096u);
+
+    // 本档到上限、更大档无空闲 slab：不代更大档增长，取不到
+    CHECK(!pool.acquireRef(4096));
+    s = pool.stats();
+    CHECK_EQ(s[0].exhausted, 1u);
+    CHECK_EQ(s[0].failed, 1u);
+    CHECK_EQ(s[0].borrowed, 0u);
+    CHECK_EQ(s[1].capacity, 0u);
+
+    // 8K 档有了空闲 slab 后即可借用（计入请求档的 borrowed）
+    pool.acquireRef(8192).reset();
+    SlabRef b = pool.acquireRef(100);
+    CHECK(b && b.size() == 8192);
+    s = pool.stats();
+    CHECK_EQ(s[0].requests, 7u);
+    CHECK_EQ(s[0].borrowed, 1u);
+    CHECK_EQ(s[1].requests, 1u);
+    CHECK_EQ(s[1].borrowed, 0u);
+    CHECK_EQ(s[1].in_use, 1u);
+    CHECK_EQ(pool.in_use(), 6u);
+
+    held.clear();
+    b.reset();
+    CHECK_EQ(pool.in_use(), 0u);
+    CHECK_EQ(pool.capacity(), 7u);   // 只增不减
+    pool.resetStats();
+    for (const SizeClassStats& c : pool.stats())
+        CHECK_EQ(c.requests + c.borrowed + c.exhausted + c.failed + c.waits + c.wait_ns, 0u);
+}
+
+void byteLimit() {
+    SizeClassPoolOptions o = options(4096, 65536, 8, 1);
+    o.max_bytes = 3 * 4096 + 8192;
+    SizeClassPool pool(o);
+    std::vector<SlabRef> held;
+    for (int i = 0; i < 3; ++i) held.push_back(pool.acquireRef(4096));
+    held.push_back(pool.acquireRef(8192));
+    CHECK(held.back() && held.back().size() == 8192);
+    CHECK_EQ(pool.reserved_bytes(), size_t(o.max_bytes));
+    CHECK(!pool.acquireRef(4096));     // 档未到上限，但字节到顶
+    CHECK(!pool.acquireRef(65536));    // 更大档一块也建不了
+    CHECK_EQ(pool.reserved_bytes(), size_t(o.max_bytes));
+    const std::vector<SizeClassStats> s = pool.stats();
+    CHECK_EQ(s[0].failed, 1u);
+    CHECK_EQ(s[4].failed, 1u);
+    CHECK_EQ(s[4].chunks, 0u);
+    held.pop_back();
+    SlabRef b = pool.acquireRef(4096);   // 归还的 8K slab 借给 4K 档
+    CHECK(b && b.size() == 8192);
+}
+
+void chunkLimit() {
+    SizeClassPool pool(options(4096, 4096, 200, 1));   // 200 / kMaxChunks 向上取整：每块至少 4 个
+    std::vector<SlabRef> held;
+    while (SlabRef r = pool.acquireRef(4096)) held.push_back(std::move(r));
+    const SizeClassStats s = pool.stats()[0];
+    CHECK_EQ(held.size(), 200u);
+    CHECK_EQ(s.capacity, 200u);
+    CHECK(s.chunks <= SizeClassPool::kMaxChunks);
+    CHECK_EQ(s.chunks, 50u);
+}
+
+void reserve() {
+    SizeClassPoolOptions o = options(4096, 100000, 6, 2);
+    o.reserve = true;
+    SizeClassPool pool(o);
+    std::vector<SizeClassStats> s = pool.stats();
+    CHECK_EQ(pool.reserved_bytes(), 6u * 100000u);   // 只预留最高档
+    CHECK_EQ(s.back().capacity, 6u);
+    CHECK_EQ(s.back().chunks, 1u);
+    for (size_t k = 0; k + 1 < s.size(); ++k) CHECK_EQ(s[k].capacity, 0u);
+
+    o.max_bytes = 250000;   // 最高档放不下满额：预留到上限，余量留给小档增长
+    SizeClassPool capped(o);
+    CHECK_EQ(capped.reserved_bytes(), 200000u);
+    CHECK(capped.acquireRef(10000).size() == 16384);
+    CHECK_EQ(capped.reserved_bytes(), 200000u + 2u * 16384u);
+}
+
+void waiting() {
+    using std::chrono::milliseconds;
+    SizeClassPool pool(options(4096, 8192, 1, 1));
+    SlabRef small = pool.acquireRef(4096);
+    SlabRef big = pool.acquireRef(8192);
+    const auto t0 = std::chrono::steady_clock::now();
+    CHECK(!pool.acquireRef(4096, milliseconds(20)));
+    CHECK(std::chrono::steady_clock::now() - t0 >= milliseconds(19));
+    std::vector<SizeClassStats> s = pool.stats();
+    CHECK_EQ(s[0].exhausted, 1u);
+    CHECK_EQ(s[0].failed, 1u);
+    CHECK_EQ(s[0].waits, 1u);
+    CHECK(s[0].wait_ns >= 19000000u && s[0].max_wait_ns == s[0].wait_ns);
+
+    // 更大档的归还也唤醒等待方（借用）
+    std::thread releaser([r = std::move(big)]() mutable {
+        std::this_thread::sleep_for(milliseconds(20));
+        r.reset();
+    });
+    SlabRef got = pool.acquireRef(4096, SlabPool::kWaitForever);
+    releaser.join();
+    CHECK(got && got.size() == 8192);
+    s = pool.stats();
+    CHECK_EQ(s[0].waits, 2u);
+    CHECK_EQ(s[0].failed, 1u);
+    CHECK_EQ(s[0].borrowed, 1u);
+}
+
+void lowWatermark() {
+    SizeClassPool pool(options(4096, 8192, 4, 2));
+    std::vector<std::pair<size_t, size_t>> calls;   // (slab 大小, 可取数)
+    pool.setLowWatermark(2, [&](size_t slab_size, size_t available) {
+        calls.emplace_back(slab_size, available);
+        CHECK_EQ(pool.available(0), available);   // 锁外调用：可重入本池
+        pool.stats();
+    });
+    CHECK_EQ(pool.available(0), 4u);   // 全是增长余量
+    std::vector<SlabRef> held;
+    held.push_back(pool.acquireRef(4096));   // 增长一块 2 个：空闲 1 + 余量 2 = 3
+    CHECK(calls.empty());
+    held.push_back(pool.acquireRef(4096));   // 0 + 2：降到水位
+    CHECK_EQ(calls.size(), 1u);
+    CHECK(calls.back() == std::make_pair(size_t(4096), size_t(2)));
+    held.push_back(pool.acquireRef(4096));   // 1 + 0：仍在水位下，不再触发
+    held.push_back(pool.acquireRef(4096));
+    CHECK(!pool.acquireRef(4096));           // 取不到（更大档无空闲）：可取数 0，仍不触发
+    CHECK_EQ(calls.size(), 1u);
+
+    held.resize(1);                          // 回到 3，下一次取用再次越过水位
+    held.push_back(pool.acquireRef(4096));
+    CHECK_EQ(calls.size(), 2u);
+    CHECK_EQ(calls.back().second, 2u);
+
+    // 各档分别触发；小档可借用更大档的空闲 slab，可取数计入
+    SlabRef big = pool.acquireRef(8192);     // 8K 档：空闲 1 + 余量 2 = 3
+    CHECK_EQ(calls.size(), 2u);
+    CHECK_EQ(pool.available(0), 2u + 1u);
+    held.push_back(pool.acquireRef(8192));   // 0 + 2
+    CHECK_EQ(calls.size(), 3u);
+    CHECK(calls.back() == std::make_pair(size_t(8192), size_t(2)));
+    std::vector<SizeClassStats> s = pool.stats();
+    CHECK_EQ(s[0].low_watermark, 2u);
+    CHECK_EQ(s[1].low_watermark, 1u);
+    pool.resetStats();
+    CHECK_EQ(pool.stats()[0].low_watermark, 0u);
+
+    // max_bytes 限制余量
+    SizeClassPoolOptions o = options(4096, 4096, 8, 2);
+    o.max_bytes = 3 * 4096;
+    SizeClassPool capped(o);
+    CHECK_EQ(capped.available(0), 3u);
+    SlabRef r = capped.acquireRef(4096);
+    CHECK_EQ(capped.available(0), 1u + 1u);   // 块内空闲 1 + 字节余量 1
+}
+
+} // namespace
+
+int main() {
+    classes();
+    growthAndBorrowing();
+    byteLimit();
+    chunkLimit();
+    reserve();
+    waiting();
+    lowWatermark();
+    return test::result("size_class_pool");
+}
@@ -0,0 +1,447 @@
+// slab_pool: SlabPool 的并发取还。多线程各自取还、以及取用线程与归还线程分离的跨线程流转下，
+// 同一 slab 不会同时交给两方（按 slab 地址登记占用，取出时必须空闲、归还前必须仍归自己），
+// 覆盖只走全局栈的小池（1 ~ 3 个 slab）与启用每线程缓存的池；线程退出后 available() 回到
+// 容量，主线程能取回全部 slab（含已退出线程缓存中的），再取才为空。
+// 耗尽与等待：acquire(timeout) 在池空时约等 timeout 后返回 nullptr，他线程归还（含经其线程缓存）
+// 唤醒等待方；exhausted / failed / waits / wait_ns / high_water 按次计数，resetStats 清零；
+// 低水位回调边沿触发，回到水位以上后重新启用，回调内可调用本池。
+// SlabRef 引用计数：拷贝 / 移动 / 赋值、shared()（同一 slab 多次转出时控制块改在堆上）、右值
+// shared() 转交、fromShared 取回，slab 只在最后一个引用（句柄或 shared_ptr）放掉时归还；多线程
+// 并发拷贝 / 放掉同一 slab 后计数回到 1；在途 slab 晚于 SlabPool 析构仍可读写，最后归还时释放池内存。
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <shimetapi/core/slab_pool.h>
+
+#include "check.h"
+
+using namespace Shimeta;
+
+namespace {
+
+/// 按 slab 地址登记占用：取出时由 0 置 1，归还前由 1 置 0，任一方向不符即为重复交付。
+class Ownership {
+public:
+    /// 单线程取空 pool 得到全部 slab 地址，再全部归还。
+    explicit Ownership(SlabPool& pool) : owned_(pool.capacity()) {
+        std::vector<SlabRef> all;
+        for (size_t i = 0; i < pool.capacity(); ++i) all.push_back(pool.acquireRef());
+        for (const SlabRef& r : all) {
+            CHECK(r);
+            CHECK_EQ(reinterpret_cast<uintptr_t>(r.get()) % SlabPool::kSlabAlign, 0u);
+            addrs_.push_back(r.get());
+        }
+        std::sort(addrs_.begin(), addrs_.end());
+        CHECK(std::adjacent_find(addrs_.begin(), addrs_.end()) == addrs_.end());
+        CHECK(!pool.acquireRef());
+    }
+
+    void take(const uint8_t* p) {
+        std::atomic<int>* o = find(p);
+        if (o && o->exchange(1, std::memory_order_acq_rel) != 0) dup_.fetch_add(1, std::memory_order_relaxed);
+    }
+    void give(const uint8_t* p) {
+        std::atomic<int>* o = find(p);
+        if (o && o->exchange(0, std::memory_order_acq_rel) != 1) dup_.fetch_add(1, std::memory_order_relaxed);
+    }
+    uint64_t duplicates() const { return dup_.load(); }
+    uint64_t strays() const { return stray_.load(); }
+
+private:
+    std::atomic<int>* find(const uint8_t* p) {
+        const auto it = std::lower_bound(addrs_.begin(), addrs_.end(), p);
+        if (it == addrs_.end() || *it != p) {
+            stray_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        return &owned_[size_t(it - addrs_.begin())];
+    }
+
+    std::vector<const uint8_t*>   addrs_;
+    std::vector<std::atomic<int>> owned_;
+    std::atomic<uint64_t>         dup_{0}, stray_{0};
+};
+
+/// 取空池：应恰好取到 capacity 个，再取为空。
+void drainAll(SlabPool& pool, const char* what) {
+    std::vector<SlabRef> all;
+    while (SlabRef r = pool.acquireRef()) all.push_back(std::move(r));
+    if (all.size() != pool.capacity()) std::printf("  %s: drained %zu of %zu\n", what, all.size(), pool.capacity());
+    CHECK_EQ(all.size(), pool.capacity());
+    CHECK_EQ(pool.available(), 0u);
+}
+
+/// threads 个线程各自取还：每线程至多持有 hold 个，随机次序归还；一半取用经 acquire()（shared_ptr）。
+void selfService(size_t slabs, int threads, size_t hold, int iters) {
+    SlabPool pool(256, slabs);
+    Ownership own(pool);
+    std::atomic<uint64_t> got{0};
+    std::vector<std::thread> ts;
+    for (int t = 0; t < threads; ++t) {
+        ts.emplace_back([&, t] {
+            std::mt19937 rng(unsigned(t) + 1);
+            std::vector<SlabRef> refs;
+            std::vector<std::shared_ptr<uint8_t[]>> sps;
+            const auto giveBack = [&] {
+                if (!sps.empty() && (refs.empty() || rng() & 1)) {
+                    std::swap(sps[rng() % sps.size()], sps.back());
+                    own.give(sps.back().get());
+                    sps.pop_back();
+                } else if (!refs.empty()) {
+                    std::swap(refs[rng() % refs.size()], refs.back());
+                    own.give(refs.back().get());
+                    refs.pop_back();
+                }
+            };
+            for (int i = 0; i < iters; ++i) {
+                if (refs.size() + sps.size() >= hold || rng() % 3 == 0) {
+                    giveBack();
+                    continue;
+                }
+                const uint8_t* p = nullptr;
+                if (rng() & 1) {
+                    if (SlabRef r = pool.acquireRef()) {
+                        p = r.get();
+                        own.take(p);
+                        refs.push_back(std::move(r));
+                    }
+                } else if (auto sp = pool.acquire()) {
+                    p = sp.get();
+                    own.take(p);
+                    sps.push_back(std::move(sp));
+                }
+                if (p) got.fetch_add(1, std::memory_order_relaxed);
+            }
+            while (!refs.empty() || !sps.empty()) giveBack();
+        });
+    }
+    for (std::thread& t : ts) t.join();
+    CHECK_EQ(own.duplicates(), 0u);
+    CHECK_EQ(own.strays(), 0u);
+    CHECK(got.load() > 0);
+    CHECK_EQ(pool.available(), slabs);
+    drainAll(pool, "selfService");
+    std::printf("  self-service %zu slabs (cache %zu) x %d threads: %llu acquires\n", slabs,
+                pool.thread_cache_size(), threads, (unsigned long long)got.load());
+}
+
+/// 跨线程流转：producers 个线程取 slab 交入队列，consumers 个线程从队列取出后归还。
+void handoff(size_t slabs, int producers, int consumers, int per_producer) {
+    SlabPool pool(256, slabs);
+    Ownership own(pool);
+    std::mutex m;
+    std::deque<SlabRef> q;
+    std::atomic<int> producing{producers};
+    std::atomic<uint64_t> passed{0};
+    std::vector<std::thread> ts;
+    for (int t = 0; t < producers; ++t) {
+        ts.emplace_back([&] {
+            for (int i = 0; i < per_producer;) {
+                SlabRef r = pool.acquireRef();
+                if (!r) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                own.take(r.get());
+                std::lock_guard<std::mutex> lk(m);
+                q.push_back(std::move(r));
+                ++i;
+            }
+            producing.fetch_sub(1);
+        });
+    }
+    for (int t = 0; t < consumers; ++t) {
+        ts.emplace_back([&] {
+            for (;;) {
+                SlabRef r;
+                {
+                    std::lock_guard<std::mutex> lk(m);
+                    if (!q.empty()) {
+                        r = std::move(q.front());
+                        q.pop_front();
+                    }
+                }
+                if (!r) {
+                    if (!producing.load()) {
+                        std::lock_guard<std::mutex> lk(m);
+                        if (q.empty()) break;
+                    }
+                    std::this_thread::yield();
+                    continue;
+                }
+                own.give(r.get());
+                r.reset();
+                passed.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (std::thread& t : ts) t.join();
+    CHECK_EQ(own.duplicates(), 0u);
+    CHECK_EQ(own.strays(), 0u);
+    CHECK_EQ(passed.load(), uint64_t(producers) * uint64_t(per_producer));
+    CHECK_EQ(pool.available(), slabs);
+    drainAll(pool, "handoff");
+    std::printf("  handoff %zu slabs (cache %zu), %d -> %d threads: %llu slabs passed\n", slabs,
+                pool.thread_cache_size(), producers, consumers, (unsigned long long)passed.load());
+}
+
+using Clock = std::chrono::steady_clock;
+
+long long msSince(Clock::time_point t0) {
+    return (long long)std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - t0).count();
+}
+
+/// 取空 slabs 个 slab 的池后：限时等待超时、不等待即失败、他线程归还唤醒无限等待，逐项核对计数。
+void exhaustion(size_t slabs) {
+    using std::chrono::milliseconds;
+    SlabPool pool(64, slabs);
+    std::vector<SlabRef> held;
+    while (SlabRef r = pool.acquireRef()) held.push_back(std::move(r));
+    CHECK_EQ(held.size(), slabs);
+    SlabPoolStats s = pool.stats();
+    CHECK_EQ(s.capacity, slabs);
+    CHECK_EQ(s.in_use, slabs);
+    CHECK_EQ(s.high_water, slabs);
+    CHECK_EQ(s.exhausted, 1u);   // 取空时的最后一次
+    CHECK_EQ(s.failed, 1u);
+    CHECK_EQ(s.waits, 0u);
+
+    Clock::time_point t0 = Clock::now();
+    CHECK(!pool.acquire(milliseconds(30)));
+    long long ms = msSince(t0);
+    CHECK(ms >= 29 && ms < 2000);
+    CHECK(!pool.acquireRef(milliseconds(0)));   // <= 0 同 acquire()：不等待
+    s = pool.stats();
+    CHECK_EQ(s.exhausted, 3u);
+    CHECK_EQ(s.failed, 3u);
+    CHECK_EQ(s.waits, 1u);
+    CHECK(s.wait_ns >= 29000000u && s.max_wait_ns == s.wait_ns);
+
+    // 他线程 40 ms 后归还一个：无限等待的取用应被唤醒并拿到它
+    SlabRef last = std::move(held.back());
+    held.pop_back();
+    const uint8_t* want = last.get();
+    t0 = Clock::now();
+    std::thread releaser([r = std::move(last)]() mutable {
+        std::this_thread::sleep_for(milliseconds(40));
+        r.reset();
+    });
+    SlabRef woken = pool.acquireRef(SlabPool::kWaitForever);
+    ms = msSince(t0);
+    releaser.join();
+    CHECK(woken && woken.get() == want);
+    CHECK(ms >= 30 && ms < 5000);
+    s = pool.stats();
+    CHECK_EQ(s.exhausted, 4u);
+    CHECK_EQ(s.failed, 3u);   // 等到了，不计失败
+    CHECK_EQ(s.waits, 2u);
+    CHECK(s.wait_ns >= 59000000u);
+
+    // 限时等待同样能被唤醒（不等到超时）
+    std::thread releaser2([r = std::move(woken)]() mutable {
+        std::this_thread::sleep_for(milliseconds(20));
+        r.reset();
+    });
+    t0 = Clock::now();
+    CHECK(pool.acquire(std::chrono::seconds(10)) != nullptr);
+    CHECK(msSince(t0) < 5000);
+    releaser2.join();
+
+    pool.resetStats();
+    s = pool.stats();
+    CHECK_EQ(s.exhausted + s.failed + s.waits + s.wait_ns + s.max_wait_ns, 0u);
+    CHECK(s.high_water >= s.in_use && s.high_water <= slabs);   // 回到当前占用（含线程缓存中的空闲 slab，为上界）
+    held.clear();
+    CHECK_EQ(pool.available(), slabs);
+    std::printf("  exhaustion %zu slabs (cache %zu): timed / immediate failure, wake-up by release\n", slabs,
+                pool.thread_cache_size());
+}
+
+/// 低水位：只走全局栈的池逐个取还，触发点与参数确定；启用缓存的池只核对边沿触发次数。
+void lowWatermark() {
+    SlabPool pool(64, 3);
+    std::vector<size_t> fired, avail_in_cb;
+    pool.setLowWatermark(1, [&](size_t free) {
+        fired.push_back(free);
+        avail_in_cb.push_back(pool.available());   // 回调在池锁之外：可调用本池
+    });
+    std::vector<SlabRef> held;
+    held.push_back(pool.acquireRef());   // 剩 2
+    CHECK(fired.empty());
+    held.push_back(pool.acquireRef());   // 剩 1：触发
+    CHECK(fired.size() == 1 && fired[0] == 1 && avail_in_cb[0] == 1);
+    held.push_back(pool.acquireRef());   // 剩 0：边沿触发，不再调用
+    CHECK_EQ(fired.size(), 1u);
+    held.pop_back();
+    held.pop_back();                     // 回到 2 > 1：重新启用
+    held.push_back(pool.acquireRef());
+    CHECK(fired.size() == 2 && fired[1] == 1);
+    CHECK_EQ(pool.stats().low_watermark, 2u);
+    held.clear();
+
+    SlabPool cached(64, 64);
+    std::atomic<int> events{0};
+    cached.setLowWatermark(16, [&](size_t free) {
+        CHECK(free <= 16);
+        events.fetch_add(1);
+    });
+    for (int round = 1; round <= 2; ++round) {
+        while (SlabRef r = cached.acquireRef()) held.push_back(std::move(r));
+        CHECK_EQ(events.load(), round);
+        held.clear();
+    }
+    CHECK_EQ(cached.stats().low_watermark, 2u);
+}
+
+/// 单线程引用计数：available() 在最后一个引用放掉前不变。
+void refcount() {
+    SlabPool pool(128, 2);   // 无线程缓存：available() 即全局栈空闲数
+    SlabRef a = pool.acquireRef();
+    CHECK(a && a.size() == 128 && a.use_count() == 1);
+    std::memset(a.get(), 0x5A, a.size());
+    SlabRef b = a;
+    CHECK(b.get() == a.get() && a.use_count() == 2);
+    SlabRef c = std::move(b);
+    CHECK(!b && b.use_count() == 0 && c.use_count() == 2);
+    SlabRef d;
+    d = c;
+    CHECK_EQ(a.use_count(), 3u);
+    d = std::move(c);   // 移动赋值：d 原有的引用放掉
+    CHECK(!c && a.use_count() == 2);
+    CHECK_EQ(pool.available(), 1u);
+    d.reset();
+    CHECK_EQ(a.use_count(), 1u);
+    CHECK_EQ(pool.available(), 1u);
+
+    // shared()：本句柄保留；第二次转出的控制块在堆上，各自计一个引用
+    std::shared_ptr<uint8_t[]> sp1 = a.shared();
+    std::shared_ptr<uint8_t[]> sp2 = a.shared();
+    CHECK(sp1.get() == a.get() && sp2.get() == a.get());
+    CHECK_EQ(a.use_count(), 3u);
+    std::shared_ptr<uint8_t[]> sp1b = sp1;   // shared_ptr 的拷贝不动 slab 计数
+    CHECK_EQ(a.use_count(), 3u);
+    SlabRef e = SlabRef::fromShared(sp2);
+    CHECK(e.get() == a.get() && a.use_count() == 4);
+    CHECK(!SlabRef::fromShared(std::shared_ptr<uint8_t[]>(new uint8_t[8])));   // 非池内 shared_ptr
+    CHECK(!SlabRef::fromShared(nullptr));
+    const uint8_t* p = a.get();
+    a.reset();
+    e.reset();
+    sp2.reset();
+    CHECK(sp1.use_count() == 2 && p[0] == 0x5A && p[127] == 0x5A);
+    CHECK_EQ(pool.available(), 1u);
+    sp1.reset();
+    CHECK_EQ(pool.available(), 1u);
+    sp1b.reset();   // 最后一个引用：归还
+    CHECK_EQ(pool.available(), 2u);
+
+    // 右值 shared()：引用转给 shared_ptr，句柄置空
+    SlabRef f = pool.acquireRef();
+    SlabRef g = f;
+    std::shared_ptr<uint8_t[]> sp3 = std::move(f).shared();
+    CHECK(!f && sp3 && g.use_count() == 2);
+    g.reset();
+    CHECK_EQ(pool.available(), 1u);
+    sp3.reset();
+    CHECK_EQ(pool.available(), 2u);
+
+    // acquire() 的 shared_ptr 同样可 fromShared
+    std::shared_ptr<uint8_t[]> sp4 = pool.acquire();
+    SlabRef h = SlabRef::fromShared(sp4);
+    sp4.reset();
+    CHECK(h && h.use_count() == 1);
+    CHECK_EQ(pool.available(), 1u);
+    h.reset();
+    CHECK_EQ(pool.available(), 2u);
+    CHECK(!SlabRef().shared() && SlabRef().size() == 0);
+}
+
+/// 多线程并发拷贝 / 转 shared_ptr / 放掉同一 slab 的引用。
+void refcountConcurrent() {
+    SlabPool pool(64, 4);
+    const SlabRef root = pool.acquireRef();
+    std::vector<std::thread> ts;
+    for (int t = 0; t < 4; ++t) {
+        ts.emplace_back([&root, t] {
+            std::mt19937 rng(unsigned(t) + 10);
+            std::vector<SlabRef> refs;
+            std::vector<std::shared_ptr<uint8_t[]>> sps;
+            for (int i = 0; i < 100000; ++i) {
+                switch (rng() % 4) {
+                case 0: refs.push_back(root); break;
+                case 1:
+                    if (!refs.empty()) {
+                        sps.push_back(std::move(refs.back()).shared());
+                        refs.pop_back();
+                    }
+                    break;
+                case 2: if (!sps.empty()) refs.push_back(SlabRef::fromShared(sps.back())); break;
+                default:
+                    if (!refs.empty()) refs.erase(refs.begin() + long(rng() % refs.size()));
+                    if (!sps.empty() && rng() & 1) sps.pop_back();
+                    break;
+                }
+                if (refs.size() > 64) refs.clear();
+                if (sps.size() > 8) sps.clear();
+            }
+        });
+    }
+    for (std::thread& t : ts) t.join();
+    CHECK_EQ(root.use_count(), 1u);
+    CHECK_EQ(pool.available(), 3u);
+}
+
+/// 在途 slab 晚于 SlabPool 析构：仍可读写，最后一个引用归还时释放池内存（ASan / LSan 下验证）。
+void orphan() {
+    for (size_t slabs : {2, 64}) {
+        auto pool = std::make_unique<SlabPool>(256, slabs);
+        SlabRef ref = pool->acquireRef();
+        std::shared_ptr<uint8_t[]> sp = pool->acquire();
+        SlabRef cached = pool->acquireRef();
+        cached.reset();   // 启用缓存的池：留在本线程缓存中
+        pool.reset();
+        std::memset(ref.get(), 1, 256);
+        std::memset(sp.get(), 2, 256);
+        SlabRef copy = ref;
+        CHECK(copy.use_count() == 2 && ref[255] == 1 && sp[0] == 2);
+        ref.reset();
+        copy.reset();
+        CHECK(sp[255] == 2);
+        sp.reset();   // 最后一个：释放池内存
+    }
+    // 他线程放掉最后一个引用
+    auto pool = std::make_unique<SlabPool>(256, 16);
+    SlabRef ref = pool->acquireRef();
+    pool.reset();
+    std::thread([r = std::move(ref)]() mutable { r.reset(); }).join();
+}
+
+} // namespace
+
+int main() {
+    for (size_t slabs : {1, 2, 3}) selfService(slabs, 4, 2, 100000);   // 不足 kMinCachedPool：只走全局栈
+    selfService(1, 8, 1, 200000);                                       // 单 slab 高争用：CAS 失败后栈已空
+    selfService(SlabPool::kMinCachedPool, 4, 2, 100000);
+    selfService(64, 6, 12, 100000);
+    selfService(512, 4, 40, 50000);   // 缓存达上限 kMaxThreadCache
+    handoff(3, 2, 2, 50000);
+    handoff(16, 1, 3, 100000);
+    handoff(64, 3, 1, 50000);
+    exhaustion(2);
+    exhaustion(16);   // 归还进归还线程的缓存，等待方须从中取回
+    lowWatermark();
+    refcount();
+    refcountConcurrent();
+    orphan();
+    return test::result("slab_pool");
+}
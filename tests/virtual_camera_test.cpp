@@ -0,0 +1,202 @@
+// virtual_camera: VirtualCamera 的池占用。EVS / APS 尺寸档池在 Init 后与取流全程不超过单一尺寸池的
+// 占用（pool_class_slabs × 单包 / 帧上限）：默认按需增长，pool_memory 要求预触时 Init 即映射最高档满额；
+// 显式 pool_max_bytes 同样是上界。合成源（RAW8 1000 fps 档、EVT3 + NV12 APS）尽快出包、Block 不丢帧。
+// SetPoolLowWatermark 在采集线程上按池报告低水位，次数与 GetStats 一致。设备报小单包上限时超长包
+// 整条丢弃（计入 drop_oversize 并占序号），不交付截断的载荷；报 0 又无自有缓冲时同样计入。
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <shimetapi/hv/virtual_camera.h>
+
+#include "check.h"
+
+using namespace Shimeta;
+
+namespace {
+
+hv::DeviceConfig synthetic(bool raw8) {
+    hv::DeviceConfig cfg;
+    cfg.backend = hv::Backend::Synthetic;
+    cfg.event_fmt = hv::EventFormat::Evt3;
+    cfg.synth_mipi_raw8 = raw8;
+    cfg.evs_fps = raw8 ? 1000 : 0;
+    cfg.synth_mev_per_s = 5;
+    cfg.synth_aps_fps = raw8 ? 0 : 200;
+    cfg.synth_speed = 0;
+    cfg.synth_duration_ms = raw8 ? 400 : 100;
+    cfg.buffer_count = 4;
+    cfg.queue_policy = hv::DeviceConfig::QueuePolicy::Block;
+    return cfg;
+}
+
+/// 取流到数据源结束（拉取方逐帧取走），途中与结束时核对两池的字节数不超过 bound_*。
+void streamWithin(hv::VirtualCamera& cam, size_t bound_evs, size_t bound_aps, const char* what) {
+    size_t peak_evs = 0, peak_aps = 0;
+    const auto note = [&] {
+        const hv::StreamStats s = cam.GetStats();
+        peak_evs = std::max(peak_evs, s.evs_pool_bytes);
+        peak_aps = std::max(peak_aps, s.aps_pool_bytes);
+    };
+    CHECK(cam.StartStream());
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+    Frame f;
+    size_t frames = 0;
+    while (!cam.Ended() && std::chrono::steady_clock::now() < deadline) {
+        if (cam.GetFrame(f, 10)) ++frames;
+        if (frames % 16 == 0) note();
+    }
+    note();
+    CHECK(cam.Ended());
+    const hv::StreamStats s = cam.GetStats();
+    cam.StopStream();
+    CHECK(frames > 0);
+    CHECK_EQ(s.drop_evs_pool + s.drop_aps_pool + s.drop_queue_full, 0u);
+    if (peak_evs > bound_evs || peak_aps > bound_aps)
+        std::printf("  %s: peak %zu / %zu B > bound %zu / %zu B\n", what, peak_evs, peak_aps, bound_evs, bound_aps);
+    CHECK(peak_evs <= bound_evs);
+    CHECK(peak_aps <= bound_aps);
+    std::printf("  %-22s %6zu frames, pool bytes evs %zu / %zu, aps %zu / %zu\n", what, frames, peak_evs, bound_evs,
+                peak_aps, bound_aps);
+}
+
+void poolFootprint(bool raw8, bool prefault, uint64_t max_bytes, const char* what) {
+    hv::DeviceConfig cfg = synthetic(raw8);
+    cfg.pool_memory.prefault = prefault;
+    cfg.pool_max_bytes = max_bytes;
+    hv::VirtualCamera cam;
+    if (!CHECK(cam.Init(cfg))) return;
+    const size_t slabs = size_t(cfg.buffer_count) + 2;   // pool_class_slabs 默认
+    const size_t max_evs = cam.device()->maxEventPacketBytes();
+    const size_t max_aps = cam.device()->hasImages() ? cam.device()->maxImageBytes() : 0;
+    const size_t bound_evs = max_bytes ? size_t(max_bytes) : slabs * max_evs;
+    const size_t bound_aps = max_bytes ? size_t(max_bytes) : slabs * max_aps;
+    const hv::StreamStats s = cam.GetStats();
+    if (prefault && !max_bytes) {   // Init 即映射最高档满额，其余档不预留
+        CHECK_EQ(s.evs_pool_bytes, bound_evs);
+        CHECK_EQ(s.aps_pool_bytes, bound_aps);
+        CHECK(s.evs_pool_memory.prefaulted);
+    } else if (!prefault) {         // 按需增长：Init 时不映射
+        CHECK_EQ(s.evs_pool_bytes + s.aps_pool_bytes, 0u);
+    }
+    streamWithin(cam, bound_evs, bound_aps, what);
+}
+
+/// 逐包交出 sizes 长度的 EVS 包（第 i 包各字节为 i + 1），单包上限报 max_bytes。
+class ScriptedDevice : public hv::VirtualDevice {
+public:
+    ScriptedDevice(std::vector<size_t> sizes, size_t max_bytes) : sizes_(std::move(sizes)), max_bytes_(max_bytes) {}
+
+    Status init(const hv::DeviceConfig&) override { return Status::Ok; }
+    Status start() override { return Status::Ok; }
+    void   stop() override {}
+    bool readEventPacket(hv::EventPacket& pkt, int) override {
+        if (next_ == sizes_.size()) return false;
+        buf_.assign(sizes_[next_], uint8_t(next_ + 1));
+        pkt.data = BufferView{buf_.data(), buf_.size()};
+        pkt.t_begin_ns = pkt.t_end_ns = int64_t(next_);
+        ++next_;
+        return true;
+    }
+    bool readImageFrame(hv::ImageData&, EvsTimestamp&, int) override { return false; }
+
+    bool           hasEvents() const override { return true; }
+    bool           hasImages() const override { return false; }
+    bool           eventsEnded() const override { return next_ == sizes_.size(); }
+    bool           imagesEnded() const override { return true; }
+    hv::EvsPayload evsPayload() const override { return hv::EvsPayload::Evt3; }
+    size_t         maxEventPacketBytes() const override { return max_bytes_; }
+    size_t         maxImageBytes() const override { return 0; }
+
+private:
+    std::vector<size_t>  sizes_;
+    size_t               max_bytes_;
+    std::atomic<size_t>  next_{0};
+    std::vector<uint8_t> buf_;
+};
+
+void oversizeDropped() {
+    const std::vector<size_t> sizes = {1000, 8192, 8193, 3000, 20000, 100};
+    hv::DeviceConfig cfg = synthetic(false);
+    cfg.buffer_count = 8;
+    hv::VirtualCamera cam;
+    if (!CHECK(cam.Init(cfg, std::make_unique<ScriptedDevice>(sizes, 8192)))) return;
+    CHECK(cam.StartStream());
+    std::vector<uint64_t> skipped;
+    Frame f;
+    uint64_t last = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!cam.Ended() && std::chrono::steady_clock::now() < deadline) {
+        uint64_t skip = 0;
+        if (!cam.WaitForNext(f, last, 10, &skip)) continue;
+        last = f.seq;
+        skipped.push_back(skip);
+        const size_t i = size_t(f.ts.evs_ts_ns);
+        CHECK(i < sizes.size() && f.evs.size == sizes[i]);   // 交付的包长度完整
+        bool intact = true;
+        for (size_t b = 0; b < f.evs.size; ++b) intact &= f.evs.data[b] == uint8_t(i + 1);
+        CHECK(intact);
+    }
+    const hv::StreamStats s = cam.GetStats();
+    cam.StopStream();
+    CHECK_EQ(skipped.size(), 4u);
+    CHECK(skipped == std::vector<uint64_t>({0, 0, 1, 1}));   // 超长包占号，WaitForNext 报告跳过
+    CHECK_EQ(s.drop_oversize, 2u);
+    CHECK_EQ(s.drop_evs_pool, 0u);
+    CHECK_EQ(cam.DroppedFrames(), 2u);
+
+    // 单包上限报 0 却不给自有缓冲：没有池可拷，全部计入超长
+    hv::VirtualCamera none;
+    if (!CHECK(none.Init(cfg, std::make_unique<ScriptedDevice>(sizes, 0)))) return;
+    CHECK(none.StartStream());
+    while (!none.Ended() && std::chrono::steady_clock::now() < deadline) none.GetFrame(f, 10);
+    CHECK_EQ(none.GetStats().drop_oversize, sizes.size());
+    CHECK_EQ(none.DroppedFrames(), sizes.size());
+    none.StopStream();
+}
+
+void poolLowWatermark() {
+    hv::DeviceConfig cfg = synthetic(false);
+    hv::VirtualCamera cam;
+    if (!CHECK(cam.Init(cfg))) return;
+    const size_t slabs = size_t(cfg.buffer_count) + 2;
+    std::atomic<uint64_t> evs_calls{0}, aps_calls{0};
+    std::atomic<bool> bad{false};
+    // 水位取每档上限减一：每档第一次取用即越过
+    cam.SetPoolLowWatermark(slabs - 1, [&](bool evs, size_t slab_size, size_t available) {
+        ++(evs ? evs_calls : aps_calls);
+        if (!slab_size || available >= slabs) bad = true;
+    });
+    CHECK(cam.StartStream());
+    Frame f;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+    while (!cam.Ended() && std::chrono::steady_clock::now() < deadline) cam.GetFrame(f, 10);
+    const hv::StreamStats s = cam.GetStats();
+    cam.StopStream();
+    CHECK(!bad);
+    CHECK(evs_calls > 0);
+    CHECK(aps_calls > 0);
+    CHECK_EQ(s.evs_pool_usage.low_watermark, evs_calls.load());
+    CHECK_EQ(s.aps_pool_usage.low_watermark, aps_calls.load());
+    uint64_t per_class = 0;
+    for (const SizeClassStats& c : s.evs_pool_classes) per_class += c.low_watermark;
+    CHECK_EQ(per_class, evs_calls.load());
+}
+
+} // namespace
+
+int main() {
+    poolFootprint(true, false, 0, "raw8 1000 fps");
+    poolFootprint(true, true, 0, "raw8 1000 fps prefault");
+    poolFootprint(false, false, 0, "evt3 + aps");
+    poolFootprint(false, true, 0, "evt3 + aps prefault");
+    poolFootprint(false, false, 8u << 20, "evt3 + aps 8 MiB cap");
+    poolLowWatermark();
+    oversizeDropped();
+    return test::result("virtual_camera");
+}